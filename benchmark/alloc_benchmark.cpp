@@ -0,0 +1,87 @@
+#define FASTAD_ALLOC_TRACKER_DEFINE_NEW
+#include <fastad_bits/util/alloc_tracker.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/stat/normal.hpp>
+#include <fastad_bits/reverse/stat/wishart.hpp>
+#include <benchmark/benchmark.h>
+
+// Reports the number of heap allocations per autodiff call as the counter "allocs".
+// Any non-zero count is a regression, since nodes should only use the bound cache.
+template <class ExprType>
+static void run_autodiff(benchmark::State& state, ExprType& expr)
+{
+    ad::autodiff(expr);
+    ad::util::AllocTracker tracker;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ad::autodiff(expr));
+        benchmark::ClobberMemory();
+    }
+    state.counters["allocs"] = benchmark::Counter(
+            tracker.stats().total(), benchmark::Counter::kAvgIterations);
+}
+
+static void BM_alloc_vec_unary_binary(benchmark::State& state)
+{
+    using namespace ad;
+    size_t n = state.range(0);
+    Var<double, vec> x(n), y(n);
+    x.get().setRandom();
+    y.get().setRandom();
+    auto expr = ad::bind(ad::sum(ad::exp(x * y) + ad::sin(x)));
+    run_autodiff(state, expr);
+}
+
+BENCHMARK(BM_alloc_vec_unary_binary)->Arg(16)->Arg(1024);
+
+static void BM_alloc_dot(benchmark::State& state)
+{
+    using namespace ad;
+    size_t n = state.range(0);
+    Var<double, mat> A(n, n);
+    Var<double, vec> x(n);
+    A.get().setRandom();
+    x.get().setRandom();
+    auto expr = ad::bind(ad::sum(ad::dot(A, ad::sin(x))));
+    run_autodiff(state, expr);
+}
+
+BENCHMARK(BM_alloc_dot)->Arg(16)->Arg(128);
+
+static void BM_alloc_log_det(benchmark::State& state)
+{
+    using namespace ad;
+    size_t n = state.range(0);
+    Var<double, mat> A(n, n);
+    A.get().setRandom();
+    A.get() = A.get() * A.get().transpose() +
+        Eigen::MatrixXd::Identity(n, n);
+    auto expr = ad::bind(ad::log_det(A) + ad::det<DetLLT>(A));
+    run_autodiff(state, expr);
+}
+
+BENCHMARK(BM_alloc_log_det)->Arg(4)->Arg(32);
+
+static void BM_alloc_normal_cov(benchmark::State& state)
+{
+    using namespace ad;
+    size_t n = state.range(0);
+    Var<double, vec> x(n), mu(n);
+    Var<double, mat> sigma(n, n);
+    x.get().setRandom();
+    mu.get().setRandom();
+    sigma.get().setRandom();
+    sigma.get() = sigma.get() * sigma.get().transpose() +
+        Eigen::MatrixXd::Identity(n, n);
+    auto expr = ad::bind(ad::normal_adj_log_pdf(x, mu, sigma) +
+                         ad::wishart_adj_log_pdf(sigma, sigma, n + 2.));
+    run_autodiff(state, expr);
+}
+
+BENCHMARK(BM_alloc_normal_cov)->Arg(4)->Arg(32);
@@ -0,0 +1,386 @@
+#include <fastad>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/*
+ * Per-node benchmarks of reverse-mode AD.
+ *
+ * Every case is registered twice: BM_feval/<case> times only the forward evaluation
+ * and BM_beval/<case> times only the backward evaluation (after one forward evaluation).
+ * The argument is the size n of the inputs: vectors have n elements and matrices are n x n.
+ * Each benchmark reports the bind cache of the expression in bytes
+ * (val_bytes, adj_bytes), the bytes of bind cache per second and the input sizes n per second.
+ *
+ * Run a single node with, e.g., --benchmark_filter=/dot_
+ */
+
+namespace {
+
+using value_t = double;
+using namespace ad;
+
+// Size sweeps
+constexpr int max_vec_size = 1000000;
+constexpr int max_mat_size = 1000;      // n x n matrices up to 10^6 elements
+constexpr int max_cubic_size = 256;     // O(n^3) nodes such as dot(mat, mat) and det
+
+void scl_sizes(benchmark::internal::Benchmark* b) { b->Arg(1); }
+void vec_sizes(benchmark::internal::Benchmark* b) { b->RangeMultiplier(10)->Range(1, max_vec_size); }
+void mat_sizes(benchmark::internal::Benchmark* b) { b->RangeMultiplier(10)->Range(1, max_mat_size); }
+void cubic_sizes(benchmark::internal::Benchmark* b) { b->RangeMultiplier(4)->Range(1, max_cubic_size); }
+
+template <class ExprType>
+void set_cache_counters(benchmark::State& state, ExprType& expr)
+{
+    auto size_pack = expr.get().bind_cache_size();
+    double val_bytes = size_pack(0) * sizeof(value_t);
+    double adj_bytes = size_pack(1) * sizeof(value_t);
+    state.counters["val_bytes"] = val_bytes;
+    state.counters["adj_bytes"] = adj_bytes;
+    state.SetBytesProcessed(state.iterations() * (val_bytes + adj_bytes));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Case>
+void BM_feval(benchmark::State& state, Case c)
+{
+    c(state.range(0), [&](auto&& e) {
+        auto expr = ad::bind(e);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ad::evaluate(expr));
+            benchmark::ClobberMemory();
+        }
+        set_cache_counters(state, expr);
+    });
+}
+
+template <class Case>
+void BM_beval(benchmark::State& state, Case c)
+{
+    c(state.range(0), [&](auto&& e) {
+        auto expr = ad::bind(e);
+        auto&& root = expr.get();
+        using root_t = std::decay_t<decltype(root)>;
+        ad::evaluate(expr);
+
+        // seed of ones of the same shape as the root
+        Eigen::Array<value_t, Eigen::Dynamic, Eigen::Dynamic> seed;
+        seed.setOnes(root.rows(), root.cols());
+
+        for (auto _ : state) {
+            if constexpr (util::is_scl_v<root_t>) {
+                ad::evaluate_adj(expr);
+            } else {
+                root.beval(seed);
+            }
+            benchmark::ClobberMemory();
+        }
+        set_cache_counters(state, expr);
+    });
+}
+
+#define FASTAD_NODE_BENCHMARK(name, sizes) \
+    BENCHMARK_CAPTURE(BM_feval, name, name)->Apply(sizes); \
+    BENCHMARK_CAPTURE(BM_beval, name, name)->Apply(sizes);
+
+// Input helpers
+
+Var<value_t, vec> make_vec(size_t n, value_t shift = 0)
+{
+    Var<value_t, vec> x(n);
+    x.get().setRandom();
+    x.get().array() += shift;
+    return x;
+}
+
+Var<value_t, mat> make_mat(size_t n)
+{
+    Var<value_t, mat> x(n, n);
+    x.get().setRandom();
+    return x;
+}
+
+// symmetric positive definite matrix
+Var<value_t, mat> make_cov(size_t n)
+{
+    Var<value_t, mat> x(n, n);
+    Eigen::MatrixXd lower = Eigen::MatrixXd::Random(n, n);
+    x.get() = lower * lower.transpose();
+    x.get().diagonal().array() += n;
+    return x;
+}
+
+std::vector<Var<value_t>> make_vars(size_t n)
+{
+    std::vector<Var<value_t>> xs(n);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i].get() = 1. + 1. / (i + 1.);
+    }
+    return xs;
+}
+
+// Cases: each calls run with the expression of inputs of size n.
+
+auto unary_scl = [](size_t, auto&& run) {
+    Var<value_t> x(0.5);
+    run(ad::sin(x));
+};
+auto unary_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    run(ad::sin(x));
+};
+auto unary_mat = [](size_t n, auto&& run) {
+    auto x = make_mat(n);
+    run(ad::exp(x));
+};
+
+auto binary_scl = [](size_t, auto&& run) {
+    Var<value_t> x(0.5), y(2.);
+    run(x * y);
+};
+auto binary_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto y = make_vec(n);
+    run(x * y);
+};
+auto binary_mat = [](size_t n, auto&& run) {
+    auto x = make_mat(n);
+    auto y = make_mat(n);
+    run(x + y);
+};
+auto binary_vec_scl = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    Var<value_t> y(2.);
+    run(x * y);
+};
+
+auto fuse_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto y = make_vec(n);
+    run(ad::fuse(ad::exp(x * y + x) * y));
+};
+
+// Depth steps of e -> sin(e) * y + x, i.e. an element-wise chain of 3 * Depth nodes.
+template <size_t Depth, class ExprType, class VarType>
+auto deep_chain(const ExprType& e, const VarType& x, const VarType& y)
+{
+    if constexpr (Depth == 0) return e;
+    else return deep_chain<Depth-1>(ad::sin(e) * y + x, x, y);
+}
+
+auto deep_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto y = make_vec(n);
+    run(deep_chain<8>(x, x, y));
+};
+auto fuse_deep_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto y = make_vec(n);
+    run(ad::fuse(deep_chain<8>(x, x, y)));
+};
+
+auto dot_mat_vec = [](size_t n, auto&& run) {
+    auto A = make_mat(n);
+    auto x = make_vec(n);
+    run(ad::dot(A, x));
+};
+auto dot_mat_mat = [](size_t n, auto&& run) {
+    auto A = make_mat(n);
+    auto B = make_mat(n);
+    run(ad::dot(A, B));
+};
+
+auto det_lu = [](size_t n, auto&& run) {
+    auto A = make_cov(n);
+    run(ad::det(A));
+};
+auto det_llt = [](size_t n, auto&& run) {
+    auto A = make_cov(n);
+    run(ad::det<DetLLT>(A));
+};
+auto log_det_lu = [](size_t n, auto&& run) {
+    auto A = make_cov(n);
+    run(ad::log_det(A));
+};
+auto log_det_llt = [](size_t n, auto&& run) {
+    auto A = make_cov(n);
+    run(ad::log_det<LogDetLLT>(A));
+};
+
+auto pow_scl = [](size_t, auto&& run) {
+    Var<value_t> x(1.5);
+    run(ad::pow<3>(x));
+};
+auto pow_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    run(ad::pow<3>(x));
+};
+
+auto norm_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    run(ad::norm(x));
+};
+
+auto transpose_mat = [](size_t n, auto&& run) {
+    auto x = make_mat(n);
+    run(ad::transpose(x));
+};
+
+auto if_else_scl = [](size_t, auto&& run) {
+    Var<value_t> x(0.5), y(2.);
+    run(ad::if_else(x < y, x * y, x + y));
+};
+
+auto eq_glue_scl = [](size_t, auto&& run) {
+    Var<value_t> x(0.5), w;
+    run((w = ad::sin(x), w * x));
+};
+auto eq_glue_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    Var<value_t, vec> w(n);
+    run((w = ad::sin(x), ad::sum(w * x)));
+};
+
+auto for_each_scl = [](size_t n, auto&& run) {
+    auto xs = make_vars(n);
+    std::vector<Var<value_t>> ws(n);
+    size_t i = 0;
+    run(ad::for_each(xs.begin(), xs.end(), [&](const auto& x) {
+        return ws[i++] = x * x;
+    }));
+};
+
+auto sum_iter = [](size_t n, auto&& run) {
+    auto xs = make_vars(n);
+    run(ad::sum(xs.begin(), xs.end(), [](const auto& x) { return x * x; }));
+};
+auto sum_elem = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    run(ad::sum(x));
+};
+auto prod_iter = [](size_t n, auto&& run) {
+    auto xs = make_vars(n);
+    run(ad::prod(xs.begin(), xs.end(), [](const auto& x) { return x; }));
+};
+auto prod_elem = [](size_t n, auto&& run) {
+    auto x = make_vec(n, 2.);
+    run(ad::prod(x));
+};
+
+auto normal_scl = [](size_t, auto&& run) {
+    Var<value_t> x(0.5), mu(0.1), sigma(2.);
+    run(ad::normal_adj_log_pdf(x, mu, sigma));
+};
+auto normal_vec_scl = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    Var<value_t> mu(0.1), sigma(2.);
+    run(ad::normal_adj_log_pdf(x, mu, sigma));
+};
+auto normal_vec_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto mu = make_vec(n);
+    auto sigma = make_vec(n, 2.);
+    run(ad::normal_adj_log_pdf(x, mu, sigma));
+};
+auto normal_vec_mat = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto mu = make_vec(n);
+    auto sigma = make_cov(n);
+    run(ad::normal_adj_log_pdf(x, mu, sigma));
+};
+
+auto cauchy_vec_scl = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    Var<value_t> loc(0.1), scale(2.);
+    run(ad::cauchy_adj_log_pdf(x, loc, scale));
+};
+auto cauchy_vec_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto loc = make_vec(n);
+    auto scale = make_vec(n, 2.);
+    run(ad::cauchy_adj_log_pdf(x, loc, scale));
+};
+
+auto uniform_vec_scl = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    Var<value_t> min(-2.), max(2.);
+    run(ad::uniform_adj_log_pdf(x, min, max));
+};
+auto uniform_vec_vec = [](size_t n, auto&& run) {
+    auto x = make_vec(n);
+    auto min = make_vec(n, -3.);
+    auto max = make_vec(n, 3.);
+    run(ad::uniform_adj_log_pdf(x, min, max));
+};
+
+Var<value_t, vec> make_zero_one(size_t n)
+{
+    Var<value_t, vec> x(n);
+    x.get() = (Eigen::ArrayXd::Random(n) > 0).cast<value_t>();
+    return x;
+}
+
+auto bernoulli_vec_scl = [](size_t n, auto&& run) {
+    auto x = make_zero_one(n);
+    Var<value_t> p(0.3);
+    run(ad::bernoulli_adj_log_pdf(x, p));
+};
+auto bernoulli_vec_vec = [](size_t n, auto&& run) {
+    auto x = make_zero_one(n);
+    auto p = make_vec(n, 1.);
+    p.get() /= 2.01;
+    run(ad::bernoulli_adj_log_pdf(x, p));
+};
+
+auto wishart_mat = [](size_t n, auto&& run) {
+    auto X = make_cov(n);
+    auto V = make_cov(n);
+    run(ad::wishart_adj_log_pdf(X, V, n + 1.));
+};
+
+} // namespace
+
+// reverse/core
+FASTAD_NODE_BENCHMARK(unary_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(unary_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(unary_mat, mat_sizes)
+FASTAD_NODE_BENCHMARK(binary_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(binary_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(binary_mat, mat_sizes)
+FASTAD_NODE_BENCHMARK(binary_vec_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(fuse_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(deep_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(fuse_deep_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(dot_mat_vec, mat_sizes)
+FASTAD_NODE_BENCHMARK(dot_mat_mat, cubic_sizes)
+FASTAD_NODE_BENCHMARK(det_lu, cubic_sizes)
+FASTAD_NODE_BENCHMARK(det_llt, cubic_sizes)
+FASTAD_NODE_BENCHMARK(log_det_lu, cubic_sizes)
+FASTAD_NODE_BENCHMARK(log_det_llt, cubic_sizes)
+FASTAD_NODE_BENCHMARK(pow_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(pow_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(norm_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(transpose_mat, mat_sizes)
+FASTAD_NODE_BENCHMARK(if_else_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(eq_glue_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(eq_glue_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(for_each_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(sum_iter, vec_sizes)
+FASTAD_NODE_BENCHMARK(sum_elem, vec_sizes)
+FASTAD_NODE_BENCHMARK(prod_iter, vec_sizes)
+FASTAD_NODE_BENCHMARK(prod_elem, vec_sizes)
+
+// reverse/stat
+FASTAD_NODE_BENCHMARK(normal_scl, scl_sizes)
+FASTAD_NODE_BENCHMARK(normal_vec_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(normal_vec_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(normal_vec_mat, cubic_sizes)
+FASTAD_NODE_BENCHMARK(cauchy_vec_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(cauchy_vec_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(uniform_vec_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(uniform_vec_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(bernoulli_vec_scl, vec_sizes)
+FASTAD_NODE_BENCHMARK(bernoulli_vec_vec, vec_sizes)
+FASTAD_NODE_BENCHMARK(wishart_mat, cubic_sizes)
@@ -56,15 +56,12 @@ int main()
     std::cout << call_price << std::endl;
     std::cout << S.get_adj() << std::endl;
 
-    // reset adjoints before differentiating again
-    S.reset_adj();
-    for (auto& c : cache) c.reset_adj();
-
     auto put_expr = ad::bind(
             black_scholes_option_price<option_type::put>(
                 S, K, sigma, tau, r, cache));
 
-    double put_price = ad::autodiff(put_expr);
+    // zero adjoints accumulated by call_expr before differentiating again
+    double put_price = ad::autodiff(put_expr, ad::zero_adjoints);
 
     std::cout << put_price << std::endl;
     std::cout << S.get_adj() << std::endl;
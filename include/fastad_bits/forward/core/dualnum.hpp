@@ -1,20 +1,42 @@
 #pragma once
+#include <type_traits>
+#include <Eigen/Core>
 
 namespace ad {
 namespace core {
 
 // Underlying data structure containing value and adjoint.
 // Represent value as "w" and adjoint as "df".
+// In vector mode (N > 1), the adjoint is a fixed-size packet of N tangents
+// (N directional derivatives) stored as an Eigen array,
+// so that every operation propagates all N directions at once with vectorized arithmetic.
 // @tparam T    underlying data type (ex. double)
-template <class T>
+// @tparam N    number of tangents (default 1, i.e. a scalar adjoint)
+template <class T, int N = 1>
 struct DualNum
 {
+    static_assert(N > 0);
+
     using value_type = T;
+    using adjoint_type = std::conditional_t<N == 1,
+                                            T,
+                                            Eigen::Array<T, N, 1>>;
+    static constexpr int n_tangents = N;
 
-    DualNum(T w, T df)
+    DualNum(T w, const adjoint_type& df)
         : w_(w), df_(df)
     {}
 
+    // Returns an adjoint with all tangents zero.
+    static adjoint_type zero_adjoint()
+    {
+        if constexpr (N == 1) {
+            return 0;
+        } else {
+            return adjoint_type::Zero();
+        }
+    }
+
     value_type& get_value() 
     {
         return w_;
@@ -30,24 +52,26 @@ struct DualNum
         return w_ = x;
     }
 
-    value_type& get_adjoint() 
+    adjoint_type& get_adjoint() 
     {
         return df_;
     }
 
-    const value_type& get_adjoint() const
+    const adjoint_type& get_adjoint() const
     {
         return df_;
     }
 
-    value_type& set_adjoint(value_type x) 
+    adjoint_type& set_adjoint(const adjoint_type& x) 
     {
         return df_ = x;
     }
 
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
 private:
     T w_;
-    T df_;   
+    adjoint_type df_;   
 };
 
 } // namepsace core
@@ -1,49 +1,53 @@
 #pragma once
 #include <cmath>
+#include <type_traits>
+#include <Eigen/Core>
 #include <fastad_bits/forward/core/dualnum.hpp>
 
 // Forward-mode Automatic Differentiation
 
-// Unary function definition with function name "f" that operates on ADForward<T> variable x.
+// Unary function definition with function name "f" that operates on ADForward<T, N> variable x.
 // "first" represents code that computes the unary function on x value.
 // "second" represents code that computes the directional derivative of unary function on x value.
 // The variadic arguments are optional and represent code to be placed before executing
 // "first" and "second" for optimization purposes.
 // @tparam  T   underlying data type for x.
 // @param   x   variable to apply unary function to
-// @return a new ADForward<T> with value and adjoint as the mathematical values for f(x), f'(x) * x'.
+// @return a new ADForward<T, N> with value and adjoint as the mathematical values for f(x), f'(x) * x'.
+//
+// "second" must be written so that it also holds when x.get_adjoint() is a packet of N tangents.
 //
 // Example generation with no variadic arguments:
 //
 // FORWARD_UNARY_FUNC(sin, std::sin(x.get_value()), std::cos(x.get_value()) * x.get_adjoint())
 // =>
-// template <class T> 
-// inline auto sin(const ad::core::ADForward<T>& x) 
+// template <class T, int N> 
+// inline auto sin(const ad::core::ADForward<T, N>& x) 
 // { 
-//      return ad::core::ADForward<T>(std::sin(x.get_value()), std::cos(x.get_value()) * x.get_adjoint()); 
+//      return ad::core::ADForward<T, N>(std::sin(x.get_value()), std::cos(x.get_value()) * x.get_adjoint()); 
 // } 
 //
 // Example generation with variadic arguments:
 //
 // FORWARD_UNARY_FUNC(exp, tmp, tmp * x.get_adjoint(), auto tmp = std::exp(x.get_value());)
 // =>
-// template <class T> 
-// inline auto exp(const ad::core::ADForward<T>& x) 
+// template <class T, int N> 
+// inline auto exp(const ad::core::ADForward<T, N>& x) 
 // { 
 //      auto tmp = std::exp(x.get_value());
-//      return ad::core::ADForward<T>(tmp, tmp * x.get_adjoint()); 
+//      return ad::core::ADForward<T, N>(tmp, tmp * x.get_adjoint()); 
 // } 
 //
 // Note that we only compute std::exp(x.get_value()) once and reuse to compute both "first" and "second".
 #define FORWARD_UNARY_FUNC(f, first, second, ...) \
-template <class T> \
-inline auto f(const ad::core::ADForward<T>& x) \
+template <class T, int N> \
+inline auto f(const ad::core::ADForward<T, N>& x) \
 { \
 	__VA_ARGS__ \
-	return ad::core::ADForward<T>(first, second); \
+	return ad::core::ADForward<T, N>(first, second); \
 } \
 
-// Binary function definition with function name "f" that operates on ADForward<T> variables x, y.
+// Binary function definition with function name "f" that operates on ADForward<T, N> variables x, y.
 // "first" represents code that computes the binary function on x, y values.
 // "second" represents code that computes the directional derivative of binary function on x, y values
 // in the direction of (x.get_adjoint(), y.get_adjoint()).
@@ -52,22 +56,61 @@ inline auto f(const ad::core::ADForward<T>& x) \
 // @tparam  T   underlying data type for x.
 // @param   x   one of the variables to apply binary function to
 // @param   y   other variable to apply binary function to
-// @return a new ADForward<T> with value and adjoint as the mathematical values for f(x, y), f'(x, y) * (x', y').
+// @return a new ADForward<T, N> with value and adjoint as the mathematical values for f(x, y), f'(x, y) * (x', y').
 //
 // Example generation with no variadic arguments:
 //
 // FORWARD_BINARY_FUNC(operator+, x.get_value() + y.get_value(), x.get_adjoint() + y.get_adjoint())
 // =>
-// template <class T>
-// inline auto operator+(const ad::core::ADForward<T>& x, ad::core::ADForward<T>& y)
+// template <class T, int N>
+// inline auto operator+(const ad::core::ADForward<T, N>& x, ad::core::ADForward<T, N>& y)
 // {
-//      return ad::core::ADForward<T>(x.get_value() + y.get_value(), x.get_adjoint() + y.get_adjoint());
+//      return ad::core::ADForward<T, N>(x.get_value() + y.get_value(), x.get_adjoint() + y.get_adjoint());
 // }
 #define FORWARD_BINARY_FUNC(f, first, second) \
-template <class T> \
-inline auto f(const ad::core::ADForward<T>& x, const ad::core::ADForward<T>& y) \
+template <class T, int N> \
+inline auto f(const ad::core::ADForward<T, N>& x, const ad::core::ADForward<T, N>& y) \
+{ \
+	return ad::core::ADForward<T, N>(first, second); \
+} \
+
+// Binary function definition with function name "f" where one of the operands 
+// is an arithmetic type, which is treated as a constant (zero adjoint).
+// It simply promotes the constant to ADForward<T, N> and invokes the ADForward<T, N> overload of "f".
+#define FORWARD_BINARY_SCALAR_FUNC(f) \
+template <class T, int N, class S \
+        , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+inline auto f(const ad::core::ADForward<T, N>& x, S y) \
+{ \
+	return f(x, ad::core::ADForward<T, N>(y)); \
+} \
+template <class T, int N, class S \
+        , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+inline auto f(S x, const ad::core::ADForward<T, N>& y) \
 { \
-	return ad::core::ADForward<T>(first, second); \
+	return f(ad::core::ADForward<T, N>(x), y); \
+} \
+
+// Comparison operator definition with operator "op" that compares the values of
+// ADForward<T, N> variables (or an ADForward<T, N> variable and an arithmetic type).
+// Tangents do not participate in comparisons.
+#define FORWARD_COMPARE_FUNC(op) \
+template <class T, int N> \
+inline bool operator op(const ad::core::ADForward<T, N>& x, const ad::core::ADForward<T, N>& y) \
+{ \
+	return x.get_value() op y.get_value(); \
+} \
+template <class T, int N, class S \
+        , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+inline bool operator op(const ad::core::ADForward<T, N>& x, S y) \
+{ \
+	return x.get_value() op y; \
+} \
+template <class T, int N, class S \
+        , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+inline bool operator op(S x, const ad::core::ADForward<T, N>& y) \
+{ \
+	return x op y.get_value(); \
 } \
 
 namespace ad {
@@ -77,34 +120,46 @@ namespace core {
 // If x is an ADForward variable that is a result of composing functions of ADForward variables x1,...,xn
 // x.get_value() is the value of the function on these variables and x.get_adjoint() is the adjoint, i.e.
 // directional (total) derivative of the composed functions in the direction of x1.get_adjoint(),...,xn.get_adjoint()
-template <class T>
-struct ADForward : public core::DualNum<T>
+// In vector mode (N > 1), x.get_adjoint() holds N such directional derivatives,
+// one for each of the N directions seeded in x1,...,xn.
+template <class T, int N = 1>
+struct ADForward : public core::DualNum<T, N>
 {
-    using data_t = core::DualNum<T>;
+    using data_t = core::DualNum<T, N>;
+    using typename data_t::adjoint_type;
 
     ADForward()
-        : data_t(0, 0)
+        : data_t(0, data_t::zero_adjoint())
+    {}
+
+    ADForward(T w)
+        : data_t(w, data_t::zero_adjoint())
     {}
 
-    ADForward(T w, T df = 0)
+    // Adjoint may be any expression convertible to adjoint_type,
+    // e.g. an Eigen expression of the tangents in vector mode.
+    template <class D>
+    ADForward(T w, const D& df)
         : data_t(w, df)
     {}
 
     ADForward& operator+=(const ADForward& x);
+    ADForward& operator-=(const ADForward& x);
+    ADForward& operator*=(const ADForward& x);
+    ADForward& operator/=(const ADForward& x);
 };
 
 } // namespace core
 
 // user-exposed forward variable alias 
-template <class T>
-using ForwardVar = core::ADForward<T>;
+// N is the number of tangents (directions) propagated per evaluation.
+template <class T, int N = 1>
+using ForwardVar = core::ADForward<T, N>;
 
 //================================================================================
 
 // Unary functions 
 
-// Negate forward variable
-FORWARD_UNARY_FUNC(operator-, -x.get_value(), -x.get_adjoint())
 // ad::sin(core::ADForward)
 FORWARD_UNARY_FUNC(sin, std::sin(x.get_value()), 
         std::cos(x.get_value())*x.get_adjoint())
@@ -134,10 +189,24 @@ FORWARD_UNARY_FUNC(sqrt, tmp, x.get_adjoint() / (2 * tmp),
         auto tmp = std::sqrt(x.get_value());)
 // ad::erf(core::ADForward)
 FORWARD_UNARY_FUNC(erf, std::erf(x.get_value()), 
-        two_over_sqrt_pi * std::exp(-t_sq), 
+        two_over_sqrt_pi * std::exp(-t_sq) * x.get_adjoint(), 
         static constexpr double two_over_sqrt_pi =
                 1.1283791670955126;
         auto t_sq = x.get_value() * x.get_value();)
+// ad::sinh(core::ADForward)
+FORWARD_UNARY_FUNC(sinh, std::sinh(x.get_value()), 
+        std::cosh(x.get_value())*x.get_adjoint())
+// ad::cosh(core::ADForward)
+FORWARD_UNARY_FUNC(cosh, std::cosh(x.get_value()), 
+        std::sinh(x.get_value())*x.get_adjoint())
+// ad::tanh(core::ADForward)
+FORWARD_UNARY_FUNC(tanh, tmp, (1 - tmp*tmp) * x.get_adjoint(), 
+        auto tmp = std::tanh(x.get_value());)
+// ad::abs(core::ADForward)
+// The derivative at 0 is taken to be 0.
+FORWARD_UNARY_FUNC(abs, std::abs(x.get_value()), 
+        sgn * x.get_adjoint(), 
+        T sgn = (x.get_value() > 0) - (x.get_value() < 0);)
 
 //================================================================================
 
@@ -145,6 +214,8 @@ FORWARD_UNARY_FUNC(erf, std::erf(x.get_value()),
 
 namespace core {
 
+// Negate forward variable
+FORWARD_UNARY_FUNC(operator-, -x.get_value(), -x.get_adjoint())
 // Add forward variables
 FORWARD_BINARY_FUNC(operator+, x.get_value() + y.get_value(), 
                     x.get_adjoint() + y.get_adjoint())
@@ -158,12 +229,129 @@ FORWARD_BINARY_FUNC(operator*, x.get_value() * y.get_value(),
 FORWARD_BINARY_FUNC(operator/, x.get_value() / y.get_value(), 
         (x.get_adjoint() * y.get_value() - x.get_value() * y.get_adjoint()) / (y.get_value() * y.get_value()))
 
+// Mixed operations with arithmetic types (treated as constants)
+FORWARD_BINARY_SCALAR_FUNC(operator+)
+FORWARD_BINARY_SCALAR_FUNC(operator-)
+FORWARD_BINARY_SCALAR_FUNC(operator*)
+FORWARD_BINARY_SCALAR_FUNC(operator/)
+
 // Add current forward variable with x and update current variable with the result.
-template <class T>
-inline ADForward<T>& ADForward<T>::operator+=(const ADForward<T>& x)
+template <class T, int N>
+inline ADForward<T, N>& ADForward<T, N>::operator+=(const ADForward<T, N>& x)
 {
     return *this = *this + x;
 }
 
+template <class T, int N>
+inline ADForward<T, N>& ADForward<T, N>::operator-=(const ADForward<T, N>& x)
+{
+    return *this = *this - x;
+}
+
+template <class T, int N>
+inline ADForward<T, N>& ADForward<T, N>::operator*=(const ADForward<T, N>& x)
+{
+    return *this = *this * x;
+}
+
+template <class T, int N>
+inline ADForward<T, N>& ADForward<T, N>::operator/=(const ADForward<T, N>& x)
+{
+    return *this = *this / x;
+}
+
+// Comparison operators (compare values only)
+FORWARD_COMPARE_FUNC(==)
+FORWARD_COMPARE_FUNC(!=)
+FORWARD_COMPARE_FUNC(<)
+FORWARD_COMPARE_FUNC(<=)
+FORWARD_COMPARE_FUNC(>)
+FORWARD_COMPARE_FUNC(>=)
+
+// Classification functions (on values only) used by some Eigen algorithms
+template <class T, int N>
+inline bool isfinite(const ADForward<T, N>& x) { return std::isfinite(x.get_value()); }
+template <class T, int N>
+inline bool isnan(const ADForward<T, N>& x) { return std::isnan(x.get_value()); }
+template <class T, int N>
+inline bool isinf(const ADForward<T, N>& x) { return std::isinf(x.get_value()); }
+
+// Forward variables are real, so these are the identity (or zero).
+// Eigen looks for them when generic code also supports complex scalars.
+template <class T, int N>
+inline const ADForward<T, N>& conj(const ADForward<T, N>& x) { return x; }
+template <class T, int N>
+inline const ADForward<T, N>& real(const ADForward<T, N>& x) { return x; }
+template <class T, int N>
+inline ADForward<T, N> imag(const ADForward<T, N>&) { return ADForward<T, N>(0); }
+template <class T, int N>
+inline ADForward<T, N> abs2(const ADForward<T, N>& x) { return x * x; }
+
+// The mathematical functions above are defined in namespace ad,
+// but argument-dependent lookup only searches ad::core for ADForward.
+// Make them visible here so that generic code calling e.g. sqrt(x) unqualified
+// (like Eigen's numext functions) finds the forward-mode overloads.
+using ad::sin;
+using ad::cos;
+using ad::tan;
+using ad::asin;
+using ad::acos;
+using ad::atan;
+using ad::exp;
+using ad::log;
+using ad::sqrt;
+using ad::erf;
+using ad::sinh;
+using ad::cosh;
+using ad::tanh;
+using ad::abs;
+
 } // namespace core
 } // namespace ad
+
+namespace Eigen {
+
+// NumTraits specialization so that forward variables are Eigen scalars.
+// This allows Eigen containers of forward variables,
+// e.g. as the value type of reverse-mode expressions (forward-over-reverse),
+// and running Eigen's dense kernels (products, decompositions, solves) on them
+// to differentiate Eigen-based code in one forward pass.
+// Forward variables have no packet math; Eigen uses its scalar code paths
+// (the tangents of vector-mode variables are vectorized within each operation).
+template <class T, int N>
+struct NumTraits<ad::core::ADForward<T, N>>
+    : NumTraits<T>
+{
+    using Real = ad::core::ADForward<T, N>;
+    using NonInteger = ad::core::ADForward<T, N>;
+    using Literal = ad::core::ADForward<T, N>;
+    using Nested = ad::core::ADForward<T, N>;
+
+    enum {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = (N + 1) * NumTraits<T>::ReadCost,
+        AddCost = (N + 1) * NumTraits<T>::AddCost,
+        MulCost = (2 * N + 1) * NumTraits<T>::MulCost + N * NumTraits<T>::AddCost
+    };
+};
+
+// Mixing forward variables with their underlying type in coefficient-wise Eigen expressions
+// (e.g. scaling a matrix of forward variables by a double) yields forward variables.
+// Matrix products require both operands to have the same scalar type,
+// so cast constant matrices first, e.g. A.cast<ForwardVar<double>>() * X.
+template <class T, int N, class BinaryOp>
+struct ScalarBinaryOpTraits<ad::core::ADForward<T, N>, T, BinaryOp>
+{
+    using ReturnType = ad::core::ADForward<T, N>;
+};
+
+template <class T, int N, class BinaryOp>
+struct ScalarBinaryOpTraits<T, ad::core::ADForward<T, N>, BinaryOp>
+{
+    using ReturnType = ad::core::ADForward<T, N>;
+};
+
+} // namespace Eigen
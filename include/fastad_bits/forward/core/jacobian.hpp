@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <Eigen/Core>
+#include <fastad_bits/forward/core/forward.hpp>
+
+namespace ad {
+namespace core {
+
+// Check if T is a forward variable.
+template <class T>
+struct is_ad_forward : std::false_type
+{};
+
+template <class T, int N>
+struct is_ad_forward<ADForward<T, N>> : std::true_type
+{};
+
+template <class T>
+inline constexpr bool is_ad_forward_v = is_ad_forward<T>::value;
+
+// Returns the kth tangent of x.
+template <class T, int N>
+inline T get_tangent(const ADForward<T, N>& x, size_t k)
+{
+    if constexpr (N == 1) {
+        static_cast<void>(k);
+        assert(k == 0);
+        return x.get_adjoint();
+    } else {
+        return x.get_adjoint()(k);
+    }
+}
+
+// Sets the kth tangent of x to v.
+template <class T, int N>
+inline void set_tangent(ADForward<T, N>& x, size_t k, T v)
+{
+    if constexpr (N == 1) {
+        static_cast<void>(k);
+        assert(k == 0);
+        x.set_adjoint(v);
+    } else {
+        x.get_adjoint()(k) = v;
+    }
+}
+
+// Number of outputs of a forward-mode function.
+// The output is either a single forward variable or
+// a container of them that supports size() and operator[] (e.g. Eigen vector, std::vector).
+template <class OutType>
+inline size_t output_size(const OutType& y)
+{
+    if constexpr (is_ad_forward_v<OutType>) {
+        static_cast<void>(y);
+        return 1;
+    } else {
+        return y.size();
+    }
+}
+
+template <class OutType>
+inline const auto& output_at(const OutType& y, size_t i)
+{
+    if constexpr (is_ad_forward_v<OutType>) {
+        static_cast<void>(i);
+        return y;
+    } else {
+        return y[i];
+    }
+}
+
+} // namespace core
+
+// Computes the Jacobian of f at x using vector forward-mode.
+// Each evaluation of f seeds N input directions at once (one per tangent),
+// so only ceil(n / N) evaluations are needed for n inputs.
+// This is preferable to reverse-mode when the number of inputs is small
+// relative to the number of outputs.
+//
+// f is invoked with a const Eigen::Matrix<ForwardVar<T, N>, Eigen::Dynamic, 1>&
+// and must return a ForwardVar<T, N> or a container of them
+// that supports size() and operator[] (e.g. an Eigen vector or std::vector).
+// Row i of the output is the gradient of output i.
+//
+// @tparam  N       number of tangents propagated per evaluation of f
+// @param   f       function to differentiate
+// @param   x       point at which to differentiate
+// @param   jac     Jacobian output (resized to m x n)
+// @return  values of f at x as an Eigen column vector
+template <int N = 4
+        , class F
+        , class XType
+        , class JacType>
+inline auto forward_jacobian(F&& f,
+                             const Eigen::MatrixBase<XType>& x,
+                             Eigen::PlainObjectBase<JacType>& jac)
+{
+    using value_t = typename XType::Scalar;
+    using fvar_t = ForwardVar<value_t, N>;
+
+    size_t n = x.size();
+    Eigen::Matrix<fvar_t, Eigen::Dynamic, 1> xf(n);
+    for (size_t j = 0; j < n; ++j) {
+        xf(j) = fvar_t(x(j));
+    }
+
+    Eigen::Matrix<value_t, Eigen::Dynamic, 1> out;
+    size_t n_chunks = std::max<size_t>(1, (n + N - 1) / N);
+
+    for (size_t c = 0; c < n_chunks; ++c) {
+        size_t begin = c * N;
+        size_t chunk = std::min<size_t>(N, n - std::min(n, begin));
+
+        for (size_t l = 0; l < chunk; ++l) {
+            core::set_tangent(xf(begin + l), l, value_t(1));
+        }
+
+        const auto& xf_c = xf;
+        auto y = f(xf_c);
+        size_t m = core::output_size(y);
+
+        if (c == 0) {
+            jac.resize(m, n);
+            out.resize(m);
+            for (size_t i = 0; i < m; ++i) {
+                out(i) = core::output_at(y, i).get_value();
+            }
+        }
+
+        for (size_t i = 0; i < m; ++i) {
+            const auto& yi = core::output_at(y, i);
+            for (size_t l = 0; l < chunk; ++l) {
+                jac(i, begin + l) = core::get_tangent(yi, l);
+            }
+        }
+
+        for (size_t l = 0; l < chunk; ++l) {
+            core::set_tangent(xf(begin + l), l, value_t(0));
+        }
+    }
+
+    return out;
+}
+
+} // namespace ad
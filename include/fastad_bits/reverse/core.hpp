@@ -7,15 +7,24 @@
 #include "fastad_bits/reverse/core/eval.hpp"
 #include "fastad_bits/reverse/core/expr_base.hpp"
 #include "fastad_bits/reverse/core/for_each.hpp"
+#include "fastad_bits/reverse/core/fuse.hpp"
 #include "fastad_bits/reverse/core/glue.hpp"
+#include "fastad_bits/reverse/core/graph.hpp"
+#include "fastad_bits/reverse/core/hessian.hpp"
 #include "fastad_bits/reverse/core/if_else.hpp"
+#include "fastad_bits/reverse/core/jacobian.hpp"
+#include "fastad_bits/reverse/core/map_reduce.hpp"
 #include "fastad_bits/reverse/core/norm.hpp"
 #include "fastad_bits/reverse/core/pow.hpp"
 #include "fastad_bits/reverse/core/prod.hpp"
+#include "fastad_bits/reverse/core/profile.hpp"
+#include "fastad_bits/reverse/core/scan.hpp"
+#include "fastad_bits/reverse/core/schedule.hpp"
+#include "fastad_bits/reverse/core/share.hpp"
 #include "fastad_bits/reverse/core/sum.hpp"
+#include "fastad_bits/reverse/core/traverse.hpp"
 #include "fastad_bits/reverse/core/unary.hpp"
 #include "fastad_bits/reverse/core/value_view.hpp"
 #include "fastad_bits/reverse/core/var.hpp"
 #include "fastad_bits/reverse/core/var_view.hpp"
-//#include "fastad_bits/reverse/core/hessian.hpp"
 #include "fastad_bits/reverse/core/transpose.hpp"
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <fastad_bits/reverse/core/traverse.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * AdjScratch is a thread-private adjoint buffer used during parallel backward evaluation.
+ *
+ * Leaves (VarView) are shared by every term of a parallel expression,
+ * so accumulating into their adjoints from multiple threads would race.
+ * While an AdjScratch is active on the current thread,
+ * leaves accumulate into a private slot of the scratch instead.
+ * The slots are keyed by the (adjoint pointer, size) of the leaf.
+ * After the parallel region, reduce() adds every slot back into the real adjoints.
+ *
+ * The node owning a scratch resolves the leaves of its subtree when it is bound (see resolve),
+ * so that the slots are allocated up front and every leaf records the index of its slot.
+ * A leaf then finds its slot with a single comparison instead of a hash lookup.
+ * Leaves that were not resolved (or were rebound since) fall back to the lookup.
+ *
+ * The slots and the keys are kept after a reduction so that
+ * repeated backward evaluations of the same expression do not allocate.
+ *
+ * @tparam  ValueType   underlying value type of the adjoints
+ */
+
+template <class ValueType>
+struct AdjScratch
+{
+    using value_t = ValueType;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * Returns the index of the private slot viewing the adjoint range [adj, adj + size).
+     * The slot is created (zero-initialized) if it does not exist.
+     */
+    size_t slot(value_t* adj, size_t size)
+    {
+        key_t key{adj, size};
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            it = index_.emplace(key, entries_.size()).first;
+            entries_.push_back({key, buf_.size()});
+            buf_.resize(buf_.size() + size, value_t(0));
+        }
+        return it->second;
+    }
+
+    /**
+     * Returns the start of the private slot viewing the adjoint range [adj, adj + size).
+     * The slot is created (zero-initialized) if it does not exist.
+     * The returned pointer is only valid until the next slot is created.
+     */
+    value_t* get(value_t* adj, size_t size)
+    {
+        size_t i = slot(adj, size);
+        return buf_.data() + entries_[i].offset;
+    }
+
+    /**
+     * Same as get(adj, size), but first tries the slot at index hint,
+     * e.g. the slot a leaf recorded when it was resolved.
+     */
+    value_t* get(value_t* adj, size_t size, size_t hint)
+    {
+        if (hint < entries_.size() &&
+            entries_[hint].key.first == adj &&
+            entries_[hint].key.second == size) {
+            return buf_.data() + entries_[hint].offset;
+        }
+        return get(adj, size);
+    }
+
+    /**
+     * Creates the slots of every leaf of expr (of the same value type)
+     * and records the slot index in each leaf (see VarView::visit_beval_adj).
+     * Leaves of another value type never accumulate into this scratch and are skipped.
+     */
+    template <class ExprType>
+    void resolve(ExprType& expr)
+    {
+        for_each_leaf(expr, [&](auto& leaf) {
+            using leaf_value_t = typename std::decay_t<decltype(leaf)>::value_t;
+            if constexpr (std::is_same_v<leaf_value_t, value_t>) {
+                if (leaf.data_adj()) {
+                    leaf.set_scratch_slot(slot(leaf.data_adj(), leaf.size()));
+                }
+            }
+        });
+    }
+
+    /**
+     * Removes every slot. The slots must have been reduced.
+     */
+    void clear()
+    {
+        index_.clear();
+        entries_.clear();
+        buf_.clear();
+    }
+
+    /**
+     * Adds every slot into the adjoint it views in the order the slots were created,
+     * then resets every slot to zero.
+     */
+    void reduce()
+    {
+        for (const auto& entry : entries_) {
+            value_t* adj = entry.key.first;
+            value_t* slot = buf_.data() + entry.offset;
+            for (size_t i = 0; i < entry.key.second; ++i) {
+                adj[i] += slot[i];
+                slot[i] = 0;
+            }
+        }
+    }
+
+    /**
+     * Returns the scratch currently active on the calling thread
+     * or nullptr if there is none.
+     */
+    static AdjScratch*& active()
+    {
+        static thread_local AdjScratch* scratch = nullptr;
+        return scratch;
+    }
+
+    /**
+     * RAII guard that activates a scratch on the calling thread
+     * and restores the previously active one on destruction.
+     * Activating nullptr deactivates the scratch, i.e. leaves accumulate into the real adjoints.
+     */
+    struct Guard
+    {
+        Guard(AdjScratch& scratch)
+            : Guard(&scratch)
+        {}
+        Guard(AdjScratch* scratch)
+            : prev_(active())
+        { active() = scratch; }
+        ~Guard() { active() = prev_; }
+        Guard(const Guard&) =delete;
+        Guard& operator=(const Guard&) =delete;
+    private:
+        AdjScratch* prev_;
+    };
+
+private:
+    using key_t = std::pair<value_t*, size_t>;
+
+    struct KeyHash
+    {
+        size_t operator()(const key_t& key) const
+        {
+            return std::hash<value_t*>()(key.first) ^
+                (std::hash<size_t>()(key.second) << 1);
+        }
+    };
+
+    struct Entry
+    {
+        key_t key;
+        size_t offset;
+    };
+
+    std::unordered_map<key_t, size_t, KeyHash> index_;
+    std::vector<Entry> entries_;
+    std::vector<value_t> buf_;
+};
+
+} // namespace core
+} // namespace ad
@@ -2,6 +2,8 @@
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/fork.hpp>
+#include <fastad_bits/reverse/core/fuse.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/size_pack.hpp>
 #include <fastad_bits/util/value.hpp>
@@ -37,7 +39,9 @@ template <class Binary
         , class LeftExprType
         , class RightExprType>
 struct BinaryNode:
-    ValueAdjView<typename util::expr_traits<LeftExprType>::value_t,
+    ValueAdjView<std::common_type_t<
+                    typename util::expr_traits<LeftExprType>::value_t,
+                    typename util::expr_traits<RightExprType>::value_t>,
                  util::max_shape_t<typename util::shape_traits<LeftExprType>::shape_t,
                                    typename util::shape_traits<RightExprType>::shape_t>
                 >,
@@ -94,15 +98,22 @@ public:
      * Forward evaluation first evaluates both expressions,
      * computes Binary value on the two values,
      * caches the result, and returns a const& of the cache.
+     * If the node is scheduled (see ad::schedule), the two expressions may be
+     * evaluated in parallel.
      *
      * @return  const reference of forward evaluation value
      */
     const var_t& feval()
     {
-        auto&& lval = util::to_array(expr_lhs_.feval());
-        auto&& rval = util::to_array(expr_rhs_.feval());
-        util::to_array(this->get()) = util::cast_to<value_t>(Binary::fmap(lval, rval));
-        return this->get();
+        FASTAD_PROFILE_FEVAL();
+        if (fork_.plan()) {
+            fork_.feval([&]() { expr_lhs_.feval(); },
+                        [&]() { expr_rhs_.feval(); });
+            return fmap(expr_lhs_.get(), expr_rhs_.get());
+        }
+        auto&& lval = expr_lhs_.feval();
+        auto&& rval = expr_rhs_.feval();
+        return fmap(lval, rval);
     }
 
     /**
@@ -120,18 +131,21 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         static_cast<void>(seed);
         if constexpr (!Binary::is_comparison) {
-            auto&& a_val = util::to_array(this->get());
-            auto&& a_adj = util::to_array(this->get_adj());
-            auto&& a_l = util::to_array(expr_lhs_.get());
-            auto&& a_r = util::to_array(expr_rhs_.get());
-
-            a_adj = seed;
-            auto&& rhs_seed = Binary::brmap(a_adj, a_l, a_r, a_val);
-            auto&& lhs_seed = Binary::blmap(a_adj, a_l, a_r, a_val);
-            expr_rhs_.beval(rhs_seed);
-            expr_lhs_.beval(lhs_seed);
+            this->visit_aligned_adj([&](auto&& val, auto&& adj) {
+                auto&& a_val = util::to_array(val);
+                auto&& a_adj = util::to_array(adj);
+                auto&& a_l = util::to_array(expr_lhs_.get());
+                auto&& a_r = util::to_array(expr_rhs_.get());
+
+                a_adj = seed;
+                auto&& rhs_seed = Binary::brmap(a_adj, a_l, a_r, a_val);
+                auto&& lhs_seed = Binary::blmap(a_adj, a_l, a_r, a_val);
+                fork_.beval([&]() { expr_rhs_.beval(rhs_seed); },
+                            [&]() { expr_lhs_.beval(lhs_seed); });
+            });
         }
     }
 
@@ -148,11 +162,11 @@ public:
         if constexpr (Binary::is_comparison) {
             auto adj = begin.adj;
             begin.adj = nullptr;
-            begin = value_adj_view_t::bind(begin);
+            begin = value_adj_view_t::bind_cache_slot(begin);
             begin.adj = adj;
             return begin;
         } else {
-            return value_adj_view_t::bind(begin);
+            return value_adj_view_t::bind_cache_slot(begin);
         }
     }
 
@@ -173,15 +187,90 @@ public:
     util::SizePack single_bind_cache_size() const
     {
         if constexpr (Binary::is_comparison) {
-            return {this->size(), 0};
+            return {this->cache_size(), 0};
         } else {
-            return {this->size(), this->size()};
+            return {this->cache_size(), this->cache_size()};
         }
     }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_lhs_);
+        f(expr_rhs_);
+    }
+
+    ForkSlot<value_t>& fork_slot() { return fork_; }
+
+    /**
+     * Fused evaluation inside of a FuseNode (see fuse.hpp).
+     * The node never caches its own values or adjoints in this mode.
+     */
+    static constexpr size_t fused_depth = 1 + std::max(
+            details::fused_depth<left_t>(), details::fused_depth<right_t>());
+
+    void fused_feval()
+    {
+        details::fused_feval(expr_lhs_);
+        details::fused_feval(expr_rhs_);
+    }
+
+    auto fused_get()
+    {
+        return util::cast_to<value_t>(Binary::fmap(
+                    details::fused_get(expr_lhs_),
+                    details::fused_get(expr_rhs_)));
+    }
+
+    template <class T, class F>
+    void fused_beval(const T& seed, const F& f)
+    {
+        static_cast<void>(seed);
+        static_cast<void>(f);
+        if constexpr (!Binary::is_comparison) {
+            auto&& a_l = details::fused_get(expr_lhs_);
+            auto&& a_r = details::fused_get(expr_rhs_);
+            details::fused_beval(expr_rhs_, Binary::brmap(seed, a_l, a_r, f), a_r);
+            details::fused_beval(expr_lhs_, Binary::blmap(seed, a_l, a_r, f), a_l);
+        }
+    }
+
+    ptr_pack_t fused_bind_cache(ptr_pack_t begin)
+    {
+        begin = details::fused_bind_cache(expr_lhs_, begin);
+        return details::fused_bind_cache(expr_rhs_, begin);
+    }
+
+    util::SizePack fused_bind_cache_size() const
+    {
+        return details::fused_bind_cache_size(expr_lhs_) +
+                details::fused_bind_cache_size(expr_rhs_);
+    }
+
+    template <class G>
+    auto fused_transform(G&& g) const
+    {
+        using new_left_t = std::decay_t<decltype(g(expr_lhs_))>;
+        using new_right_t = std::decay_t<decltype(g(expr_rhs_))>;
+        return BinaryNode<Binary, new_left_t, new_right_t>(
+                g(expr_lhs_), g(expr_rhs_));
+    }
+
 private:
+    template <class L, class R>
+    const var_t& fmap(const L& lval, const R& rval)
+    {
+        auto&& a_l = util::to_array(lval);
+        auto&& a_r = util::to_array(rval);
+        this->visit_aligned([&](auto&& val) {
+            util::to_array(val) = util::cast_to<value_t>(Binary::fmap(a_l, a_r));
+        });
+        return this->get();
+    }
+
     left_t expr_lhs_;
     right_t expr_rhs_;
+    ForkSlot<value_t> fork_;
 };
 
 /* 
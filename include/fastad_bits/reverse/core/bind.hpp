@@ -1,6 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/util/arena.hpp>
+#include <fastad_bits/util/ptr_pack.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 
 namespace ad {
@@ -12,6 +20,21 @@ namespace core {
  * This is for convenience purposes so that users do not have
  * to worry about creating the cache line themselves.
  *
+ * Alternatively, ExprBind can bind the expression to caller-owned storage
+ * (e.g. from an util::Arena), in which case it does not allocate at all.
+ * The storage must then hold at least expr.bind_cache_size() values and adjoints
+ * and outlive the ExprBind.
+ *
+ * ExprBind also records the adjoints of the variables and placeholders
+ * reachable from the expression so that zero_adjoints() can reset all of them
+ * before differentiating again.
+ *
+ * Moving an ExprBind is cheap and keeps the expression bound,
+ * since the internal caches are moved along with it (caller-owned storage stays where it is).
+ * Copying rebinds the copy to a new internal cache, even if the original was bound
+ * to caller-owned storage. The copy still views the same variables and placeholders;
+ * use clone() to rebind them, e.g. to give every thread its own copy of a model.
+ *
  * @tparam  ExprType    expression type
  */
 
@@ -30,22 +53,228 @@ struct ExprBind
         val_cache_.resize(size_pack(0));
         adj_cache_.resize(size_pack(1));
         expr_.bind_cache({val_cache_.data(), adj_cache_.data()});
+        val_ = val_cache_.data();
+        init_adj(adj_cache_.data(), size_pack(1));
+    }
+
+    ExprBind(const expr_t& expr,
+             value_t* val,
+             value_t* adj)
+        : expr_{expr}
+        , val_cache_()
+        , adj_cache_()
+    {
+        expr_.bind_cache({val, adj});
+        val_ = val;
+        init_adj(adj, expr_.bind_cache_size()(1));
     }
     
+    ExprBind(const ExprBind& other)
+        : ExprBind(other.expr_)
+    {}
+
+    ExprBind(ExprBind&&) =default;
+
+    ExprBind& operator=(const ExprBind& other)
+    {
+        if (this != &other) *this = ExprBind(other);
+        return *this;
+    }
+
+    ExprBind& operator=(ExprBind&&) =default;
+
+    /**
+     * Returns a copy bound to a new internal cache
+     * whose variables and placeholders (VarView leaves) are first rebound by rebind_leaf.
+     * rebind_leaf is called on every leaf of the copy as rebind_leaf(leaf),
+     * where leaf can be rebound with leaf.bind(util::PtrPack<value_t>(val, adj)).
+     * Placeholders of EqNode must be rebound as well for the copy to be independent.
+     *
+     * @param   rebind_leaf     functor called on every VarView of the copy
+     */
+    template <class F>
+    ExprBind clone(F&& rebind_leaf) const
+    {
+        expr_t expr = expr_;
+        for_each_leaf(expr, rebind_leaf);
+        return ExprBind(expr);
+    }
+
+    /**
+     * Returns a copy bound to a new internal cache where every leaf viewing
+     * the values [from.val, from.val + size) is rebound to the same offset from to.val.
+     * Its adjoint is likewise rebound from [from.adj, from.adj + size) to to.adj.
+     * This is the common case of a model whose parameters (and placeholders)
+     * are all viewed from one contiguous buffer, e.g.
+     *
+     *      auto local = expr.clone({theta.data(), theta_adj.data()}, theta.size(),
+     *                              {local_theta.data(), local_theta_adj.data()});
+     *
+     * Leaves outside of the range (e.g. data) are shared with the original.
+     */
+    ExprBind clone(util::PtrPack<value_t> from,
+                   size_t size,
+                   util::PtrPack<value_t> to) const
+    {
+        return clone([&](auto& leaf) {
+            using leaf_t = std::decay_t<decltype(leaf)>;
+            if constexpr (std::is_same_v<typename leaf_t::value_t, value_t>) {
+                std::less<const value_t*> less;
+                auto in_range = [&](const value_t* p, const value_t* begin) {
+                    return p && begin && !less(p, begin) && less(p, begin + size);
+                };
+                value_t* val = leaf.data();
+                value_t* adj = leaf.data_adj();
+                bool rebind = false;
+                if (in_range(val, from.val)) {
+                    val = to.val + (val - from.val);
+                    rebind = true;
+                }
+                if (in_range(adj, from.adj)) {
+                    adj = to.adj + (adj - from.adj);
+                    rebind = true;
+                }
+                if (rebind) leaf.bind(util::PtrPack<value_t>(val, adj));
+            }
+        });
+    }
+
     expr_t& get() { return expr_; }
 
+    /**
+     * Returns the beginning of the value and adjoint caches the expression is bound to.
+     * The caches hold expr.bind_cache_size() values and adjoints, respectively.
+     */
+    util::PtrPack<value_t> cache() const { return {val_, adj_}; }
+
+    /**
+     * Zeroes the adjoint cache and the adjoints of every variable and placeholder
+     * of the expression.
+     * Adjoints of the variables are zeroed in as few contiguous runs as possible,
+     * e.g. a whole vector of Var objects allocated together is zeroed at once.
+     */
+    void zero_adjoints()
+    {
+        zero(adj_, adj_size_);
+        for (const auto& range : leaf_adj_) {
+            zero(range.first, range.second);
+        }
+        // leaves of other value types could not be recorded
+        if (!has_other_leaves_) return;
+        for_each_leaf(expr_, [](auto& leaf) {
+            using leaf_value_t = typename std::decay_t<decltype(leaf)>::value_t;
+            if constexpr (!std::is_same_v<leaf_value_t, value_t>) {
+                leaf.zero_adj();
+            }
+        });
+    }
+
 private:
+    using range_t = std::pair<value_t*, size_t>;
+
+    /**
+     * Records the adjoint cache and collects the adjoint ranges of all leaves.
+     * Duplicate (e.g. a variable used many times) and adjacent ranges are merged.
+     */
+    void init_adj(value_t* adj, size_t adj_size)
+    {
+        adj_ = adj;
+        adj_size_ = adj_size;
+
+        for_each_leaf(expr_, [&](auto& leaf) {
+            using leaf_value_t = typename std::decay_t<decltype(leaf)>::value_t;
+            if constexpr (std::is_same_v<leaf_value_t, value_t>) {
+                if (leaf.data_adj()) {
+                    leaf_adj_.emplace_back(leaf.data_adj(), leaf.size());
+                }
+            } else {
+                has_other_leaves_ = true;
+            }
+        });
+
+        std::less<value_t*> less;
+        std::sort(leaf_adj_.begin(), leaf_adj_.end(),
+                  [&](const range_t& x, const range_t& y) {
+                      return less(x.first, y.first);
+                  });
+        std::vector<range_t> merged;
+        for (const auto& range : leaf_adj_) {
+            if (!merged.empty()) {
+                auto& last = merged.back();
+                value_t* last_end = last.first + last.second;
+                if (!less(last_end, range.first)) {
+                    value_t* end = std::max(last_end, range.first + range.second, less);
+                    last.second = end - last.first;
+                    continue;
+                }
+            }
+            merged.push_back(range);
+        }
+        leaf_adj_ = std::move(merged);
+    }
+
+    static void zero(value_t* begin, size_t n)
+    {
+        if (!begin || !n) return;
+        if constexpr (std::is_arithmetic_v<value_t>) {
+            std::memset(begin, 0, n * sizeof(value_t));
+        } else {
+            std::fill_n(begin, n, value_t(0));
+        }
+    }
+
     expr_t expr_; 
     Eigen::Matrix<value_t, Eigen::Dynamic, 1> val_cache_;
     Eigen::Matrix<value_t, Eigen::Dynamic, 1> adj_cache_;
+    value_t* val_ = nullptr;
+    value_t* adj_ = nullptr;
+    size_t adj_size_ = 0;
+    std::vector<range_t> leaf_adj_;
+    bool has_other_leaves_ = false;     // some leaf has another value type
 };
 
 } // namespace core
 
+/**
+ * Tag to request ad::autodiff to zero all adjoints of a bound expression
+ * before differentiating (see ExprBind::zero_adjoints).
+ */
+struct zero_adjoints_t {};
+inline constexpr zero_adjoints_t zero_adjoints{};
+
 template <class Derived>
 inline auto bind(const core::ExprBase<Derived>& expr)
 {
     return core::ExprBind<Derived>(expr.self());
 }
 
+/**
+ * Binds the expression to caller-owned storage.
+ * val and adj must point to at least expr.bind_cache_size()(0) and (1) values,
+ * respectively, and must outlive the returned object.
+ */
+template <class Derived>
+inline auto bind(const core::ExprBase<Derived>& expr,
+                 typename util::expr_traits<Derived>::value_t* val,
+                 typename util::expr_traits<Derived>::value_t* adj)
+{
+    return core::ExprBind<Derived>(expr.self(), val, adj);
+}
+
+/**
+ * Binds the expression to storage allocated from the arena.
+ * No heap allocation occurs if the arena has enough capacity.
+ * The arena must not be reset while the returned object is in use.
+ */
+template <class Derived>
+inline auto bind(const core::ExprBase<Derived>& expr,
+                 util::Arena& arena)
+{
+    using value_t = typename util::expr_traits<Derived>::value_t;
+    auto size_pack = expr.self().bind_cache_size();
+    value_t* val = arena.allocate<value_t>(size_pack(0));
+    value_t* adj = arena.allocate<value_t>(size_pack(1));
+    return core::ExprBind<Derived>(expr.self(), val, adj);
+}
+
 } // namespace ad
@@ -1,4 +1,5 @@
 #pragma once
+#include <new>
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_view.hpp>
 #include <fastad_bits/util/shape_traits.hpp>
@@ -11,7 +12,11 @@ namespace core {
 
 template <class Derived>
 struct ConstantBase: ExprBase<Derived>
-{};
+{
+    // constants are leaves
+    template <class F>
+    void for_each_child(F&&) {}
+};
 
 /**
  * ConstantView represents constants in a mathematical formula.
@@ -75,6 +80,14 @@ struct ConstantView:
     constexpr size_t cols() const { return val_.cols(); }
     const value_t* data() const { return val_.data(); }
 
+    /**
+     * Views the constants starting at begin instead, with the same shape.
+     */
+    void rebind(const value_t* begin)
+    {
+        new (&val_) var_t(begin, rows(), cols());
+    }
+
 private:
     var_t val_;
 };
@@ -171,7 +184,8 @@ inline auto constant_view(const ValueType* x,
 }
 
 template <class ValueType
-        , class = std::enable_if_t<std::is_arithmetic_v<ValueType>> >
+        , class = std::enable_if_t<std::is_arithmetic_v<ValueType> ||
+                                   util::is_batch_v<ValueType>> >
 inline auto constant(ValueType x)
 {
     return core::Constant<ValueType, ad::scl>(x);
@@ -2,6 +2,8 @@
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/llt_cache.hpp>
+#include <fastad_bits/util/intra_op.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/size_pack.hpp>
 #include <fastad_bits/util/value.hpp>
@@ -14,6 +16,8 @@ namespace core {
  * No other shapes are permitted for this node.
  * Decomposition functor of type DecompType is provided to
  * define the policy in how to compute forward and backward-evaluation.
+ * The inverse needed for backward-evaluation is computed in blocks of columns
+ * on the intra-node pool if the matrix is large (see util::set_intra_op).
  *
  * The node assumes the same value type as that of the vector expression.
  * It is always a scalar shape.
@@ -52,11 +56,13 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         return this->get() = decomp_.fmap(expr_.feval());
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !decomp_.valid()) return;
         auto a_inv_t = decomp_.bmap().array();
         expr_.beval((seed * this->get()) * a_inv_t);
@@ -67,7 +73,7 @@ public:
         begin = expr_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -80,7 +86,25 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
+    }
+
+    /**
+     * Applies f to the factorization slot of the decomposition and the matrix expression
+     * if the decomposition is a Cholesky factorization (see ad::share_factorizations).
+     */
+    template <class F>
+    void for_each_llt(F&& f)
+    {
+        if constexpr (details::has_llt_slot<decomp_t>::value) {
+            f(decomp_.llt_slot(), expr_);
+        }
     }
 
 private:
@@ -94,13 +118,15 @@ private:
 /*
  * Default method for decomposing a matrix for determinant.
  */
-template <class ValueType>
+template <class ValueType, int Size = Eigen::Dynamic>
 struct DetFullPivLU
 {
     using value_t = ValueType;
 
     DetFullPivLU(size_t rows)
         : lu_(rows, rows)
+        , inv_(rows, rows)
+        , tmp_(rows, rows)
     {}
     
     template <class T>
@@ -110,22 +136,36 @@ struct DetFullPivLU
         return lu_.determinant();
     }
 
-    auto bmap() const 
+    // The inverse is computed with the LU factors in-place into preallocated matrices,
+    // since lu_.inverse() allocates a temporary every time.
+    // A^{-1} = Q U^{-1} L^{-1} P
+    // The triangular solves are split into blocks of columns (see util::parallel_blocks).
+    auto bmap() 
     {
-        return lu_.inverse().transpose();
+        size_t n = lu_.rows();
+        tmp_ = lu_.permutationP() * mat_t::Identity(n, n);
+        util::parallel_blocks(n, 2 * n * n * n, [&](size_t begin, size_t size) {
+            auto block = tmp_.middleCols(begin, size);
+            lu_.matrixLU().template triangularView<Eigen::UnitLower>().solveInPlace(block);
+            lu_.matrixLU().template triangularView<Eigen::Upper>().solveInPlace(block);
+        });
+        inv_ = lu_.permutationQ() * tmp_;
+        return inv_.transpose();
     }
 
     bool valid() const { return lu_.isInvertible(); }
 
 private:
-    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using mat_t = Eigen::Matrix<value_t, Size, Size>;
     Eigen::FullPivLU<mat_t> lu_;
+    mat_t inv_;
+    mat_t tmp_;
 };
 
 /*
  * Decomposing a positive or negative semi-definite matrix for determinant.
  */
-template <class ValueType>
+template <class ValueType, int Size = Eigen::Dynamic>
 struct DetLDLT
 {
     using value_t = ValueType;
@@ -149,13 +189,15 @@ struct DetLDLT
     const auto& bmap() 
     {
         size_t n = ldlt_.rows();
-        return inv_ = ldlt_.solve(mat_t::Identity(n, n));
+        inv_.resize(n, n);
+        util::solve_identity(ldlt_, inv_);
+        return inv_;
     }
 
     bool valid() const { return valid_; }
 
 private:
-    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using mat_t = Eigen::Matrix<value_t, Size, Size>;
     bool valid_ = false;
     Eigen::LDLT<mat_t> ldlt_;
     mat_t inv_;
@@ -164,51 +206,52 @@ private:
 /*
  * Decomposing a positive definite matrix for determinant.
  */
-template <class ValueType>
+template <class ValueType, int Size = Eigen::Dynamic>
 struct DetLLT
 {
     using value_t = ValueType;
 
     DetLLT(size_t rows)
         : llt_(rows)
-        , inv_()
     {}
     
     template <class T>
     value_t fmap(const Eigen::MatrixBase<T>& X)
     {
-        llt_.compute(X);
-        value_t det = llt_.matrixL().determinant();
+        llt_->compute(X);
+        value_t det = llt_->llt().matrixL().determinant();
         return det * det;
     }
 
-    // Important to save the inverse, since otherwise Eigen
-    // will dynamically allocate every time and result in bad-alloc.
+    // The inverse is computed once per factorization
+    // and may be shared with other nodes (see ad::share_factorizations).
     const auto& bmap() 
     {
-        size_t n = llt_.rows();
-        return inv_ = llt_.solve(mat_t::Identity(n, n));
+        return llt_->inverse();
     }
 
     bool valid() const 
     {
-        return (llt_.info() == Eigen::Success); 
+        return llt_->valid(); 
     }
 
+    core::LLTSlot<value_t, Size>& llt_slot() { return llt_; }
+
 private:
-    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
-    Eigen::LLT<mat_t> llt_;
-    mat_t inv_;
+    core::LLTSlot<value_t, Size> llt_;
 };
 
 /*
  * Creates a determinant expression node with a policy that defines the decomposition.
  * The default decomposition is Eigen::FullPivLU.
  * Currently, we support DetLDLT and DetLLT for some specialized matrices.
+ * A decomposition is a template of the value type and, optionally, the matrix size.
+ * If x is a fixed-size matrix, the decomposition is instantiated with its size,
+ * so that it works on fixed-size Eigen matrices.
  * If x is a constant, the decomposition is ignored and 
  * will always just invoke member function determinant of the underlying Eigen object.
  */
-template <template <class> class DecompType = DetFullPivLU
+template <template <class, int...> class DecompType = DetFullPivLU
         , class T
         , class = std::enable_if_t<
             util::is_convertible_to_ad_v<T> &&
@@ -226,7 +269,13 @@ inline auto det(const T& x)
         var_t out = expr.feval().determinant();
         return ad::constant(out);
     } else {
-        return core::DetNode<DecompType<value_t>, expr_t>(expr);
+        if constexpr (util::is_fixed_v<expr_t>) {
+            using shape_t = typename util::shape_traits<expr_t>::shape_t;
+            static_assert(shape_t::rows == shape_t::cols);
+            return core::DetNode<DecompType<value_t, shape_t::rows>, expr_t>(expr);
+        } else {
+            return core::DetNode<DecompType<value_t>, expr_t>(expr);
+        }
     }
 }
 
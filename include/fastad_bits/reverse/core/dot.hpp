@@ -1,7 +1,10 @@
 #pragma once
+#include <functional>
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/fork.hpp>
+#include <fastad_bits/util/intra_op.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/value.hpp>
 #include <fastad_bits/util/size_pack.hpp>
@@ -11,7 +14,8 @@ namespace core {
 namespace details {
 
 /*
- * Returns the the dot-product shape given left and right shapes
+ * Returns the the dot-product shape given left and right shapes.
+ * If both shapes are fixed-size, the result is fixed-size as well.
  */
 template <class T, class U, class=void>
 struct dot_shape;
@@ -19,7 +23,8 @@ struct dot_shape;
 template <class T, class U>
 struct dot_shape<T, U, std::enable_if_t<
                         util::is_mat_v<T> &&
-                        util::is_vec_v<U>> >
+                        util::is_vec_v<U> &&
+                        !(util::is_fixed_v<T> && util::is_fixed_v<U>)> >
 {
     using type = ad::vec;
 };
@@ -27,11 +32,31 @@ struct dot_shape<T, U, std::enable_if_t<
 template <class T, class U>
 struct dot_shape<T, U, std::enable_if_t<
                         util::is_mat_v<T> &&
-                        util::is_mat_v<U>> >
+                        util::is_mat_v<U> &&
+                        !(util::is_fixed_v<T> && util::is_fixed_v<U>)> >
 {
     using type = ad::mat;
 };
 
+template <class T, class U>
+struct dot_shape<T, U, std::enable_if_t<
+                        util::is_mat_v<T> &&
+                        util::is_vec_v<U> &&
+                        util::is_fixed_v<T> && util::is_fixed_v<U>> >
+{
+    using type = ad::fixed_vec<util::shape_traits<T>::shape_t::rows>;
+};
+
+template <class T, class U>
+struct dot_shape<T, U, std::enable_if_t<
+                        util::is_mat_v<T> &&
+                        util::is_mat_v<U> &&
+                        util::is_fixed_v<T> && util::is_fixed_v<U>> >
+{
+    using type = ad::fixed_mat<util::shape_traits<T>::shape_t::rows,
+                               util::shape_traits<U>::shape_t::cols>;
+};
+
 template <class T, class U>
 using dot_shape_t = typename dot_shape<T,U>::type;
 
@@ -47,6 +72,14 @@ using dot_shape_t = typename dot_shape<T,U>::type;
  * We assert that the value type be the same for the two expressions.
  * The output shape is always a (column) vector.
  *
+ * Backward evaluation never allocates.
+ * The product for the gradient of a VarView is accumulated directly into its adjoints,
+ * and the product for any other expression is evaluated into a gradient buffer
+ * reserved in the cache before it is passed down as the seed.
+ * No product is computed for a constant expression.
+ * Eigen dispatches to a matrix-vector (GEMV) kernel when the right expression is a vector.
+ * Large products are split into blocks evaluated on the intra-node pool (see util::set_intra_op).
+ *
  * @tparam  LHSExprType     type of left expression
  * @tparam  RHSExprType     type of right expression
  */
@@ -63,12 +96,20 @@ private:
     using rhs_t = RHSExprType;
     using lhs_value_t = typename 
         util::expr_traits<lhs_t>::value_t;
+    using lhs_shape_t = typename util::shape_traits<lhs_t>::shape_t;
+    using rhs_shape_t = typename util::shape_traits<rhs_t>::shape_t;
 
     // assert that both expressions have same value type
     static_assert(std::is_same_v<
             typename util::expr_traits<lhs_t>::value_t,
             typename util::expr_traits<rhs_t>::value_t>);
 
+    // gradient buffers are only needed for expressions that are neither constants nor VarViews
+    static constexpr bool lhs_needs_buf = 
+        !util::is_constant_v<lhs_t> && !util::is_var_view_v<lhs_t>;
+    static constexpr bool rhs_needs_buf = 
+        !util::is_constant_v<rhs_t> && !util::is_var_view_v<rhs_t>;
+
 public:
     using value_adj_view_t = ValueAdjView<lhs_value_t,
           details::dot_shape_t<lhs_t, rhs_t> >;
@@ -82,50 +123,159 @@ public:
         : value_adj_view_t(nullptr, nullptr, lhs.rows(), rhs.cols())
         , lhs_{lhs}
         , rhs_{rhs}
+        , lhs_buf_(nullptr, lhs.rows(), lhs.cols())
+        , rhs_buf_(nullptr, rhs.rows(), rhs.cols())
     {
+        if constexpr (util::is_fixed_v<lhs_t> && util::is_fixed_v<rhs_t>) {
+            static_assert(util::shape_traits<lhs_t>::shape_t::cols ==
+                          util::shape_traits<rhs_t>::shape_t::rows);
+        }
         assert(lhs.cols() == rhs.rows());
     }
 
+    /**
+     * Forward evaluation evaluates the product directly into the cache.
+     * If the cache was rebound to overlap with one of the operands (see EqNode),
+     * the product is first evaluated into a temporary.
+     * If the node is scheduled (see ad::schedule), the two expressions may be
+     * evaluated in parallel.
+     */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
+        if (fork_.plan()) {
+            fork_.feval([&]() { lhs_.feval(); },
+                        [&]() { rhs_.feval(); });
+            return product(lhs_.get(), rhs_.get());
+        }
         auto&& lhs_val = lhs_.feval();
         auto&& rhs_val = rhs_.feval();
-        return this->get() = lhs_val * rhs_val;
+        return product(lhs_val, rhs_val);
     }
 
+    /**
+     * Backward evaluation computes the product for the right expression, then the left.
+     * If the node is scheduled (see ad::schedule), the two may be computed in parallel.
+     */
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         util::to_array(this->get_adj()) = seed;
-        auto a_ladj = util::to_array(this->get_adj() * rhs_.get().transpose());
-        auto a_radj = util::to_array(lhs_.get().transpose() * this->get_adj());
-        rhs_.beval(a_radj);
-        lhs_.beval(a_ladj);
+        const auto& adj = this->get_adj();
+        fork_.beval([&]() { rhs_beval(adj); },
+                    [&]() { lhs_beval(adj); });
     }
 
+    /**
+     * Binds left expression, right expression, the gradient buffers, then itself.
+     * The gradient buffers are bound in the adjoint cache before the node's own slot,
+     * so that they are not released when the node is rebound to a placeholder (see EqNode).
+     */
     ptr_pack_t bind_cache(ptr_pack_t begin)
     {
         begin = lhs_.bind_cache(begin);
         begin = rhs_.bind_cache(begin);
-        return value_adj_view_t::bind(begin);
+        if constexpr (lhs_needs_buf) {
+            begin.adj = lhs_buf_.bind(begin.adj);
+        }
+        if constexpr (rhs_needs_buf) {
+            begin.adj = rhs_buf_.bind(begin.adj);
+        }
+        return value_adj_view_t::bind_cache_slot(begin);
     }
 
     util::SizePack bind_cache_size() const 
     { 
         return single_bind_cache_size() + 
+                buf_bind_cache_size() +
                 lhs_.bind_cache_size() + 
                 rhs_.bind_cache_size();
     }
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), this->size()};
+        return {this->cache_size(), this->cache_size()};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(lhs_);
+        f(rhs_);
     }
 
+    ForkSlot<value_t>& fork_slot() { return fork_; }
 
 private:
+    template <class L, class R>
+    const var_t& product(const L& lhs_val, const R& rhs_val)
+    {
+        if (overlaps(lhs_val) || overlaps(rhs_val)) {
+            return this->get() = lhs_val * rhs_val;
+        }
+        util::product(this->get(), lhs_val, rhs_val);
+        return this->get();
+    }
+
+    template <class A>
+    void rhs_beval(const A& adj)
+    {
+        static_cast<void>(adj);
+        if constexpr (!util::is_constant_v<rhs_t>) {
+            auto&& lhs_val = lhs_.get();
+            if constexpr (util::is_var_view_v<rhs_t>) {
+                rhs_.visit_beval_adj([&](auto&& radj) {
+                    util::product_add(radj, lhs_val.transpose(), adj);
+                });
+            } else {
+                util::product(rhs_buf_.get(), lhs_val.transpose(), adj);
+                rhs_.beval(util::to_array(rhs_buf_.get()));
+            }
+        }
+    }
+
+    template <class A>
+    void lhs_beval(const A& adj)
+    {
+        static_cast<void>(adj);
+        if constexpr (!util::is_constant_v<lhs_t>) {
+            auto&& rhs_val = rhs_.get();
+            if constexpr (util::is_var_view_v<lhs_t>) {
+                lhs_.visit_beval_adj([&](auto&& ladj) {
+                    util::product_add(ladj, adj, rhs_val.transpose());
+                });
+            } else {
+                util::product(lhs_buf_.get(), adj, rhs_val.transpose());
+                lhs_.beval(util::to_array(lhs_buf_.get()));
+            }
+        }
+    }
+
+    util::SizePack buf_bind_cache_size() const
+    {
+        size_t size = 0;
+        if constexpr (lhs_needs_buf) size += lhs_buf_.size();
+        if constexpr (rhs_needs_buf) size += rhs_buf_.size();
+        return {0, size};
+    }
+
+    template <class T>
+    bool overlaps(const T& x) const
+    {
+        const value_t* begin = this->data();
+        const value_t* end = begin + this->size();
+        const value_t* x_begin = x.data();
+        const value_t* x_end = x_begin + x.size();
+        return std::less<const value_t*>()(x_begin, end) && 
+               std::less<const value_t*>()(begin, x_end);
+    }
+
     lhs_t lhs_;
     rhs_t rhs_;
+    ValueView<value_t, lhs_shape_t> lhs_buf_;
+    ValueView<value_t, rhs_shape_t> rhs_buf_;
+    ForkSlot<value_t> fork_;
 };
 
 } // namespace core
@@ -88,6 +88,7 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         return this->get() = var_view_.get() = expr_.feval();
     }
 
@@ -101,6 +102,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         var_view_.beval(seed);
         auto&& a_adj = util::to_array(var_view_.get_adj());
         expr_.beval(a_adj);
@@ -153,6 +155,13 @@ public:
     util::SizePack single_bind_cache_size() const
     { return {0,0}; }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(var_view_);
+        f(expr_);
+    }
+
 private:
     var_view_t var_view_;
     expr_t expr_;
@@ -239,6 +248,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         cache_.get() = var_view_.get();  // save previous lhs
         auto&& a_v = util::to_array(var_view_.get());
         auto&& a_expr = util::to_array(expr_.feval());
@@ -249,6 +259,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         var_view_.beval(seed);
 
         // copy old value first before back-evaluating 
@@ -281,7 +292,7 @@ public:
     {
         value_adj_view_t::bind({var_view_.data(), var_view_.data_adj()});
         begin = expr_.bind_cache(begin);
-        begin = cache_.bind(begin);
+        begin = cache_.bind_cache_slot(begin);
         return begin;
     }
 
@@ -293,7 +304,14 @@ public:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {cache_.size(), cache_.size()}; 
+        return {cache_.cache_size(), cache_.cache_size()}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(var_view_);
+        f(expr_);
     }
 
 private:
@@ -152,4 +152,62 @@ inline auto autodiff(core::ExprBind<ExprType>&& expr,
     return autodiff(expr.get(), seed);
 }
 
+/** 
+ * Zeroes all adjoints of the bound expression (see ExprBind::zero_adjoints),
+ * then evaluates it both in the forward and backward direction of reverse-mode AD.
+ * This is the safe way to differentiate the same expression repeatedly.
+ *
+ * @tparam ExprType expression type
+ * @param expr  expression to forward and backward evaluate
+ * Returns the forward expression value
+ */
+
+template <class ExprType
+        , class = std::enable_if_t<util::is_scl_v<std::decay_t<ExprType>>> 
+        >
+inline auto autodiff(core::ExprBind<ExprType>& expr,
+                     zero_adjoints_t,
+                     typename util::expr_traits<
+                        std::decay_t<ExprType>>::value_t seed = 1.)
+{
+    expr.zero_adjoints();
+    return autodiff(expr.get(), seed);
+}
+
+template <class ExprType
+        , class T
+        , class = std::enable_if_t<!util::is_scl_v<std::decay_t<ExprType>>> 
+        >
+inline auto autodiff(core::ExprBind<ExprType>& expr,
+                     zero_adjoints_t,
+                     const Eigen::ArrayBase<T>& seed)
+{
+    expr.zero_adjoints();
+    return autodiff(expr.get(), seed);
+}
+
+template <class ExprType
+        , class = std::enable_if_t<util::is_scl_v<std::decay_t<ExprType>>> 
+        >
+inline auto autodiff(core::ExprBind<ExprType>&& expr,
+                     zero_adjoints_t,
+                     typename util::expr_traits<
+                        std::decay_t<ExprType>>::value_t seed = 1.)
+{
+    expr.zero_adjoints();
+    return autodiff(expr.get(), seed);
+}
+
+template <class ExprType
+        , class T
+        , class = std::enable_if_t<!util::is_scl_v<std::decay_t<ExprType>>> 
+        >
+inline auto autodiff(core::ExprBind<ExprType>&& expr,
+                     zero_adjoints_t,
+                     const Eigen::ArrayBase<T>& seed)
+{
+    expr.zero_adjoints();
+    return autodiff(expr.get(), seed);
+}
+
 } // namespace ad
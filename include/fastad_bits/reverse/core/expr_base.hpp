@@ -1,5 +1,6 @@
 #pragma once
 #include <type_traits>
+#include <fastad_bits/util/profile.hpp>
 
 namespace ad {
 namespace core {
@@ -20,6 +21,25 @@ struct ExprBase
     { return *static_cast<const Derived*>(this); }
     Derived& self()
     { return *static_cast<Derived*>(this); }
+
+    /*
+     * Every node defines for_each_child(f), applying f to every direct child
+     * expression from left to right (see traverse.hpp).
+     * There is no default, so that a node with sub-expressions cannot
+     * silently hide them from a traversal. Leaves (VarView, Constant) define it as a no-op.
+     */
+
+#ifdef FASTAD_PROFILE
+    /**
+     * Profiling counters of this node (see util/profile.hpp).
+     * Only present if FASTAD_PROFILE is defined.
+     */
+    util::NodeProfile& profile() { return profile_; }
+    const util::NodeProfile& profile() const { return profile_; }
+
+private:
+    util::NodeProfile profile_;
+#endif
 };
 
 } // namespace core
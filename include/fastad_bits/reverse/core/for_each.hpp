@@ -54,6 +54,7 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         if (vec_.size() == 0) { return this->get(); }
         std::for_each(vec_.begin(), vec_.end(), 
                 [](auto& expr) { expr.feval(); }
@@ -69,6 +70,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (vec_.size() == 0) return;
         auto it = vec_.rbegin();
         it->beval(seed);
@@ -106,6 +108,12 @@ public:
 
     util::SizePack single_bind_cache_size() const { return {0,0}; }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        for (auto& expr : vec_) f(expr);
+    }
+
 private:
     std::vector<vec_elem_t> vec_;
 };
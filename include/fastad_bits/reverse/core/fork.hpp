@@ -0,0 +1,103 @@
+#pragma once
+#include <memory>
+#include <fastad_bits/reverse/core/adj_scratch.hpp>
+#include <fastad_bits/util/task_pool.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * ForkPlan describes how a node with two children (BinaryNode, DotNode)
+ * evaluates them on a TaskPool. It is created by ad::schedule.
+ *
+ * Forward evaluation of the children is forked if feval is true.
+ * Backward evaluation is forked according to beval:
+ *  - serial: the children are backward evaluated one after the other.
+ *  - direct: the children share no leaves, so both accumulate into the real adjoints.
+ *  - scratch: the children share leaves, so the second child accumulates
+ *    into a private AdjScratch that is reduced into the real adjoints after the join.
+ *
+ * @tparam  ValueType   value type of the node
+ */
+template <class ValueType>
+struct ForkPlan
+{
+    enum class Mode { serial, direct, scratch };
+
+    util::TaskPool* pool = nullptr;
+    bool feval = false;
+    Mode beval = Mode::serial;
+    AdjScratch<ValueType> scratch;
+};
+
+/**
+ * ForkSlot is the member of BinaryNode and DotNode holding their ForkPlan, if any.
+ * Without a plan, the children are evaluated serially as usual.
+ *
+ * Plans are not copied with the node, since the scratch of a plan must not be shared
+ * by copies evaluated concurrently (e.g. thread-local copies of an ExprBind).
+ * A copied expression must be scheduled again.
+ *
+ * @tparam  ValueType   value type of the node
+ */
+template <class ValueType>
+struct ForkSlot
+{
+    using value_t = ValueType;
+    using plan_t = ForkPlan<value_t>;
+    using scratch_t = AdjScratch<value_t>;
+
+    ForkSlot() =default;
+    ForkSlot(const ForkSlot&) {}
+    ForkSlot(ForkSlot&&) =default;
+    ForkSlot& operator=(const ForkSlot&) { plan_.reset(); return *this; }
+    ForkSlot& operator=(ForkSlot&&) =default;
+
+    void set(std::unique_ptr<plan_t> plan) { plan_ = std::move(plan); }
+    void reset() { plan_.reset(); }
+    const plan_t* plan() const { return plan_.get(); }
+
+    /**
+     * Invokes f() then g(), or both on the pool if the forward evaluation is forked.
+     */
+    template <class F, class G>
+    void feval(F&& f, G&& g)
+    {
+        if (plan_ && plan_->feval) {
+            plan_->pool->fork_join(f, g);
+            return;
+        }
+        f();
+        g();
+    }
+
+    /**
+     * Invokes f() then g(), or both on the pool if the backward evaluation is forked.
+     * Inside a parallel region (an adjoint scratch is active on the calling thread),
+     * the children are always backward evaluated serially.
+     */
+    template <class F, class G>
+    void beval(F&& f, G&& g)
+    {
+        using mode_t = typename plan_t::Mode;
+        if (!plan_ || plan_->beval == mode_t::serial || scratch_t::active()) {
+            f();
+            g();
+            return;
+        }
+        // g may be run by a thread with another scratch active
+        scratch_t* g_scratch = (plan_->beval == mode_t::scratch) ?
+            &plan_->scratch : nullptr;
+        plan_->pool->fork_join(f, [&]() {
+            typename scratch_t::Guard guard(g_scratch);
+            g();
+        });
+        if (g_scratch) g_scratch->reduce();
+    }
+
+private:
+    std::unique_ptr<plan_t> plan_;
+};
+
+} // namespace core
+} // namespace ad
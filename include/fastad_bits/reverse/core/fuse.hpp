@@ -0,0 +1,268 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/reverse/core/value_adj_view.hpp>
+#include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+#include <fastad_bits/util/size_pack.hpp>
+#include <fastad_bits/util/value.hpp>
+
+namespace ad {
+namespace core {
+namespace details {
+
+/*
+ * An expression is fusable if it is an element-wise node (UnaryNode, BinaryNode)
+ * that can be evaluated lazily inside of a fused region (see FuseNode).
+ * Such nodes define the following members:
+ *
+ * - fused_feval(): forward-evaluates every non-fusable descendant.
+ * - fused_get(): returns the (lazy) value of the node computed from its descendants.
+ * - fused_beval(seed, f): backward-evaluates with seed given f, the (lazy) value of the node.
+ * - fused_bind_cache(begin): binds every non-fusable descendant.
+ * - fused_bind_cache_size(): total bind size of every non-fusable descendant.
+ * - fused_depth: number of fusable nodes on the longest path from the node down the region.
+ * - fused_transform(g): copy of the node with every child c replaced by g(c).
+ */
+template <class T, class = std::void_t<>>
+struct is_fusable : std::false_type {};
+
+template <class T>
+struct is_fusable<T, std::void_t<
+    decltype(std::declval<T&>().fused_get())> > : std::true_type {};
+
+template <class T>
+inline constexpr bool is_fusable_v = is_fusable<T>::value;
+
+template <class T>
+inline constexpr size_t fused_depth()
+{
+    if constexpr (is_fusable_v<T>) return T::fused_depth;
+    else return 0;
+}
+
+/*
+ * The following helpers dispatch to the fused member functions if expr is fusable.
+ * Otherwise, expr is a boundary of the fused region and is evaluated as usual.
+ */
+template <class ExprType>
+inline void fused_feval(ExprType& expr)
+{
+    if constexpr (is_fusable_v<ExprType>) {
+        expr.fused_feval();
+    } else {
+        expr.feval();
+    }
+}
+
+template <class ExprType>
+inline decltype(auto) fused_get(ExprType& expr)
+{
+    if constexpr (is_fusable_v<ExprType>) {
+        return expr.fused_get();
+    } else {
+        return util::to_array(expr.get());
+    }
+}
+
+template <class ExprType, class T, class F>
+inline void fused_beval(ExprType& expr, const T& seed, const F& f)
+{
+    if constexpr (is_fusable_v<ExprType>) {
+        expr.fused_beval(seed, f);
+    } else {
+        static_cast<void>(f);
+        expr.beval(seed);
+    }
+}
+
+template <class ExprType, class PtrPackType>
+inline PtrPackType fused_bind_cache(ExprType& expr, PtrPackType begin)
+{
+    if constexpr (is_fusable_v<ExprType>) {
+        return expr.fused_bind_cache(begin);
+    } else {
+        return expr.bind_cache(begin);
+    }
+}
+
+template <class ExprType>
+inline util::SizePack fused_bind_cache_size(const ExprType& expr)
+{
+    if constexpr (is_fusable_v<ExprType>) {
+        return expr.fused_bind_cache_size();
+    } else {
+        return expr.bind_cache_size();
+    }
+}
+
+} // namespace details
+
+/**
+ * FuseNode evaluates a chain of element-wise nodes (UnaryNode, BinaryNode) in a single pass.
+ *
+ * Normally, every element-wise node caches its values and adjoints in its own slot of the cache,
+ * so that an expression like exp(a * x + b) * y makes a full pass over memory per node.
+ * FuseNode instead builds a single Eigen expression for the whole element-wise region,
+ * which is evaluated in one loop, keeping the intermediate values in registers.
+ * Only the fused expression itself and the boundaries of the region
+ * (the first non element-wise descendants, e.g. VarView, DotNode) are cached.
+ *
+ * Backward evaluation recomputes the intermediate values in the same way,
+ * so every boundary receives its seed as one lazy expression and is updated in one pass.
+ * This trades a few recomputed arithmetic operations for the memory traffic
+ * of the intermediate caches, which is a good trade for memory-bound vector expressions.
+ * Since the seed of a node at depth d recomputes the values of all d nodes below it,
+ * the recomputation grows quadratically with the depth of the region.
+ * ad::fuse therefore caps the depth of a region (see details::fuse_capped):
+ * a deeper chain is split into nested FuseNodes, each one a cached boundary of the region above.
+ *
+ * The value type, shape type, and variable type
+ * are the same as those of the underlying expression.
+ *
+ * @tparam  ExprType    type of element-wise expression to fuse
+ */
+
+template <class ExprType>
+struct FuseNode:
+    ValueAdjView<typename util::expr_traits<ExprType>::value_t,
+                 typename util::shape_traits<ExprType>::shape_t>,
+    ExprBase<FuseNode<ExprType>>
+{
+private:
+    using expr_t = ExprType;
+    static_assert(details::is_fusable_v<expr_t>);
+
+public:
+    using value_adj_view_t = ValueAdjView<
+        typename util::expr_traits<expr_t>::value_t,
+        typename util::shape_traits<expr_t>::shape_t >;
+    using typename value_adj_view_t::value_t;
+    using typename value_adj_view_t::shape_t;
+    using typename value_adj_view_t::var_t;
+    using typename value_adj_view_t::ptr_pack_t;
+
+    FuseNode(const expr_t& expr)
+        : value_adj_view_t(nullptr, nullptr, expr.rows(), expr.cols())
+        , expr_(expr)
+    {}
+
+    /**
+     * Forward evaluation first evaluates the boundaries of the fused region,
+     * then evaluates the fused expression in one pass and caches the result.
+     *
+     * @return  const reference of the cached result.
+     */
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        expr_.fused_feval();
+        this->visit_aligned([&](auto&& val) {
+            util::to_array(val) = expr_.fused_get();
+        });
+        return this->get();
+    }
+
+    /**
+     * Backward evaluation sets current adjoint to seed
+     * and backward evaluates the fused expression with the cached values.
+     */
+    template <class T>
+    void beval(const T& seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        this->visit_aligned_adj([&](auto&& val, auto&& adj) {
+            auto&& a_val = util::to_array(val);
+            auto&& a_adj = util::to_array(adj);
+            a_adj = seed;
+            expr_.fused_beval(a_adj, a_val);
+        });
+    }
+
+    /**
+     * Binds the boundaries of the fused region, then binds itself.
+     * The element-wise nodes inside of the region are never bound.
+     * @return  next pointer pack not bound by the boundaries or itself.
+     */
+    ptr_pack_t bind_cache(ptr_pack_t begin)
+    {
+        begin = expr_.fused_bind_cache(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
+    }
+
+    util::SizePack bind_cache_size() const
+    {
+        return single_bind_cache_size() +
+                expr_.fused_bind_cache_size();
+    }
+
+    util::SizePack single_bind_cache_size() const
+    {
+        return {this->cache_size(), this->cache_size()};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
+    }
+
+private:
+    expr_t expr_;
+};
+
+namespace details {
+
+/*
+ * Returns expr with every fusable node more than Level levels below it
+ * fused into its own region (FuseNode) of depth at most MaxDepth,
+ * so that expr is left with a fused depth of at most Level.
+ * Expressions that are already shallow enough are returned as-is.
+ */
+template <size_t MaxDepth, size_t Level = MaxDepth, class ExprType>
+inline auto fuse_capped(const ExprType& expr)
+{
+    static_assert(MaxDepth > 0);
+    if constexpr (fused_depth<ExprType>() <= Level) {
+        return expr;
+    } else if constexpr (Level == 0) {
+        using capped_t = decltype(fuse_capped<MaxDepth>(expr));
+        return FuseNode<capped_t>(fuse_capped<MaxDepth>(expr));
+    } else {
+        return expr.fused_transform([](const auto& child) {
+            return fuse_capped<MaxDepth, Level-1>(child);
+        });
+    }
+}
+
+} // namespace details
+} // namespace core
+
+// Default maximum depth of a fused region (see FuseNode).
+inline constexpr size_t default_fuse_max_depth = 4;
+
+/**
+ * Fuses an element-wise expression (see FuseNode).
+ * Regions deeper than MaxDepth element-wise nodes are split into nested FuseNodes.
+ * If the expression is not element-wise, it is returned as-is.
+ */
+template <size_t MaxDepth = default_fuse_max_depth
+        , class T
+        , class = std::enable_if_t<
+            util::is_convertible_to_ad_v<T> &&
+            util::any_ad_v<T> > >
+inline auto fuse(const T& x)
+{
+    using expr_t = util::convert_to_ad_t<T>;
+    expr_t expr = x;
+    if constexpr (core::details::is_fusable_v<expr_t>) {
+        auto capped = core::details::fuse_capped<MaxDepth>(expr);
+        return core::FuseNode<decltype(capped)>(capped);
+    } else {
+        return expr;
+    }
+}
+
+} // namespace ad
@@ -66,6 +66,7 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         expr_lhs_.feval(); 
         return this->get() = expr_rhs_.feval();
     }
@@ -81,6 +82,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         expr_rhs_.beval(seed); 
         expr_lhs_.beval(0);
     }
@@ -115,6 +117,13 @@ public:
     util::SizePack single_bind_cache_size() const
     { return {0,0}; }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_lhs_);
+        f(expr_rhs_);
+    }
+
 private:
     left_t expr_lhs_;
     right_t expr_rhs_;
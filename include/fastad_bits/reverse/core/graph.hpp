@@ -0,0 +1,221 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/util/ptr_pack.hpp>
+#include <fastad_bits/util/shape_traits.hpp>
+#include <fastad_bits/util/size_pack.hpp>
+#include <fastad_bits/util/type_name.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * Description of one node of an expression (see for_each_node_info).
+ */
+struct NodeInfo
+{
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    size_t id = 0;                      // position of the node in pre-order
+    size_t parent = npos;               // id of the parent, npos for the root
+    size_t depth = 0;
+    std::string kind;                   // node template name, e.g. BinaryNode
+    std::string name;                   // short type name, e.g. BinaryNode<Add, VarView<...>, VarView<...>>
+    std::string shape;                  // scl, vec, mat, fixed_vec<3>, ...
+    size_t rows = 0;
+    size_t cols = 0;
+
+    util::SizePack single_cache_size = util::SizePack::Zero();  // single_bind_cache_size()
+    util::SizePack cache_size = util::SizePack::Zero();         // bind_cache_size() of the subtree
+
+    // Offsets of the value/adjoint of the node into the caches of the bound expression.
+    // npos if the expression is not bound (see graph) or the node does not live in the cache,
+    // e.g. VarView, Constant, or the root of an EqNode rebound to its placeholder.
+    size_t val_offset = npos;
+    size_t adj_offset = npos;
+};
+
+namespace details {
+
+template <class T, class = std::void_t<>>
+struct has_data : std::false_type {};
+template <class T>
+struct has_data<T, std::void_t<decltype(std::declval<T&>().data())> >
+    : std::true_type {};
+
+template <class T, class = std::void_t<>>
+struct has_data_adj : std::false_type {};
+template <class T>
+struct has_data_adj<T, std::void_t<decltype(std::declval<T&>().data_adj())> >
+    : std::true_type {};
+
+template <class T>
+inline size_t cache_offset(const T* ptr, const T* begin, size_t size)
+{
+    std::less<const T*> less;
+    if (!ptr || !begin || less(ptr, begin) || !less(ptr, begin + size)) {
+        return NodeInfo::npos;
+    }
+    return ptr - begin;
+}
+
+// Removes the template arguments, e.g. "BinaryNode<Add, ...>" -> "BinaryNode".
+inline std::string template_name(const std::string& name)
+{
+    return name.substr(0, name.find('<'));
+}
+
+template <class ExprType, class ValueType, class F>
+inline void for_each_node_info(ExprType& expr,
+                               size_t parent,
+                               size_t depth,
+                               size_t& next_id,
+                               util::PtrPack<ValueType> cache,
+                               util::SizePack cache_size,
+                               F& f)
+{
+    using expr_t = std::decay_t<ExprType>;
+    using shape_t = typename util::shape_traits<expr_t>::shape_t;
+
+    NodeInfo info;
+    info.id = next_id++;
+    info.parent = parent;
+    info.depth = depth;
+    info.name = util::short_type_name<expr_t>();
+    info.kind = template_name(info.name);
+    info.shape = util::short_type_name<shape_t>();
+    info.rows = expr.rows();
+    info.cols = expr.cols();
+    info.single_cache_size = expr.single_bind_cache_size();
+    info.cache_size = expr.bind_cache_size();
+
+    using value_t = typename util::expr_traits<expr_t>::value_t;
+    if constexpr (std::is_same_v<value_t, ValueType>) {
+        if constexpr (has_data<expr_t>::value) {
+            info.val_offset = cache_offset<value_t>(expr.data(), cache.val, cache_size(0));
+        }
+        if constexpr (has_data_adj<expr_t>::value) {
+            info.adj_offset = cache_offset<value_t>(expr.data_adj(), cache.adj, cache_size(1));
+        }
+    }
+
+    f(static_cast<const NodeInfo&>(info), expr);
+
+    expr.for_each_child([&](auto& child) {
+        for_each_node_info(child, info.id, depth + 1, next_id, cache, cache_size, f);
+    });
+}
+
+} // namespace details
+
+/**
+ * Calls f(info, node) for every node of the expression in pre-order,
+ * where info is the NodeInfo of node.
+ * If cache is the beginning of the caches the expression is bound to
+ * (of cache_size values and adjoints), the offsets of the nodes into the caches are computed.
+ *
+ * @param   expr        root of the expression
+ * @param   f           functor called on every node as f(const NodeInfo&, node)
+ * @param   cache       beginning of the value and adjoint caches
+ * @param   cache_size  sizes of the value and adjoint caches
+ */
+template <class ExprType, class F, class ValueType>
+inline void for_each_node_info(ExprType& expr,
+                               F&& f,
+                               util::PtrPack<ValueType> cache,
+                               util::SizePack cache_size)
+{
+    size_t next_id = 0;
+    details::for_each_node_info(expr, NodeInfo::npos, 0, next_id,
+                                cache, cache_size, f);
+}
+
+template <class ExprType, class F>
+inline void for_each_node_info(ExprType& expr, F&& f)
+{
+    using value_t = typename util::expr_traits<ExprType>::value_t;
+    for_each_node_info(expr, f, util::PtrPack<value_t>(nullptr, nullptr),
+                       util::SizePack::Zero());
+}
+
+template <class ExprType, class F>
+inline void for_each_node_info(ExprBind<ExprType>& expr, F&& f)
+{
+    for_each_node_info(expr.get(), f, expr.cache(),
+                       expr.get().bind_cache_size());
+}
+
+} // namespace core
+
+/**
+ * Returns the NodeInfo of every node of the expression in pre-order.
+ * If expr is bound (ExprBind), the offsets into the caches are filled as well.
+ */
+template <class ExprType>
+inline std::vector<core::NodeInfo> graph(ExprType& expr)
+{
+    std::vector<core::NodeInfo> out;
+    core::for_each_node_info(expr, [&](const core::NodeInfo& info, auto&) {
+        out.push_back(info);
+    });
+    return out;
+}
+
+/**
+ * Writes the expression as a Graphviz DOT graph.
+ * Every node is labeled with its type, shape, cache sizes (single node / subtree)
+ * and, if expr is bound, its offsets into the caches.
+ */
+template <class ExprType>
+inline void to_dot(ExprType& expr, std::ostream& os)
+{
+    auto escape = [](const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    };
+    auto offset = [](size_t o) {
+        return (o == core::NodeInfo::npos) ? std::string("-") : std::to_string(o);
+    };
+
+    os << "digraph fastad {\n"
+       << "    node [shape=box, fontname=\"monospace\"];\n";
+    for (const auto& info : graph(expr)) {
+        os << "    n" << info.id << " [label=\""
+           << escape(info.name) << "\\n"
+           << info.shape << " " << info.rows << "x" << info.cols << "\\n"
+           << "cache: val " << info.single_cache_size(0)
+           << " (" << info.cache_size(0) << ")"
+           << ", adj " << info.single_cache_size(1)
+           << " (" << info.cache_size(1) << ")\\n"
+           << "offset: val " << offset(info.val_offset)
+           << ", adj " << offset(info.adj_offset)
+           << "\"];\n";
+        if (info.parent != core::NodeInfo::npos) {
+            os << "    n" << info.parent << " -> n" << info.id << ";\n";
+        }
+    }
+    os << "}\n";
+}
+
+template <class ExprType>
+inline std::string to_dot(ExprType& expr)
+{
+    std::stringstream ss;
+    to_dot(expr, ss);
+    return ss.str();
+}
+
+} // namespace ad
@@ -1,133 +1,198 @@
 #pragma once
+#include <cassert>
+#include <cstddef>
 #include <type_traits>
-#include <algorithm>
-#include "eval.hpp"
-#include "forward.hpp"
-#include "type_traits.hpp"
+#include <Eigen/Core>
+#include <fastad_bits/forward/core/forward.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/util/type_traits.hpp>
 
 namespace ad {
 namespace core {
 
-template <class Iter, class T>
-Iter compute_hess(Iter it, const Vec<ForwardVar<T>>& x)
+/**
+ * Applies f(k, x) to every element x of the variables
+ * where k is the index of x in the concatenation of the (flattened, column-major) variables.
+ */
+template <class F, class... VarTypes>
+inline void for_each_var_elem(F&& f, VarTypes&... vars)
 {
-    std::for_each(x.cbegin(), x.cend(),
-        [&it](const typename Vec<ForwardVar<T>>::value_type& xi) mutable {
-            *it = xi.get_adjoint().get_adjoint();
-            ++it;
-        });
-    return it;
+    size_t offset = 0;
+    auto apply = [&](auto& var) {
+        auto* val = var.data();
+        auto* adj = var.data_adj();
+        for (size_t i = 0; i < var.size(); ++i) {
+            f(offset + i, val[i], adj[i]);
+        }
+        offset += var.size();
+    };
+    (apply(vars), ...);
 }
 
-template <size_t... opt_sizes, class HessIter, class T, class Exgen>
-inline void hessian_gen(HessIter hess_begin, Vec<ForwardVar<T>>& x, Exgen&& gen)
+/**
+ * Computes one Hessian-vector product sweep.
+ * Sets the tangents of the variable values to v,
+ * resets all adjoints, then forward and backward evaluates the expression.
+ * The result is in the tangents of the variable adjoints.
+ */
+template <class ExprType, class VType, class... VarTypes>
+inline auto hvp_sweep(ExprType& expr,
+                      const VType& v,
+                      VarTypes&... vars)
 {
-    auto it = hess_begin;
-    auto expr = std::get<0>(gen.template generate<opt_sizes...>(x));
-
-    for (size_t i = 0; i < x.size(); ++i)
-    {
-        x.reset_adjoint();
-        if (i > 0) {
-            x[i-1].get_value().set_adjoint(0);  // set the (i-1)th forward variable's adjoint back to 0
-        }
-        x[i].get_value().set_adjoint(1); // set the ith forward variable's adjoint to 1
-        autodiff(expr);
-        // Record Hessian first column
-        // Advance iterator to next column of matrix
-        it = compute_hess(it, x);
-    }
+    using value_t = typename util::expr_traits<ExprType>::value_t;
+    for_each_var_elem([&](size_t k, auto& val, auto&) {
+            val.set_adjoint(v(k));
+        }, vars...);
+    zero_leaf_adj(expr);
+    (vars.zero_adj(), ...);
+    value_t out = expr.feval();
+    expr.beval(value_t(1));
+    return out.get_value();
 }
 
-template <size_t... opt_sizes, class HessIter, class GradIter, class T, class Exgen>
-inline void hessian_gen(HessIter hess_begin, GradIter grad_begin, Vec<ForwardVar<T>>& x, Exgen&& gen)
+} // namespace core
+
+/**
+ * Computes the Hessian-vector product of a scalar expression
+ * with respect to the given variables using forward-over-reverse AD.
+ *
+ * The expression must be built with forward variables as the value type,
+ * i.e. from Var<ForwardVar<T>, ...> (or views of them), and be bound (see ad::bind).
+ * The tangents of the variable values are set to v,
+ * then one forward and one backward evaluation propagate the tangents
+ * through the reverse sweep so that the tangents of the variable adjoints are H * v.
+ * This costs only a constant multiple of one gradient evaluation.
+ *
+ * The elements of v correspond to the (flattened, column-major) elements
+ * of the variables concatenated in the given order.
+ * On return, the values of the variable adjoints hold the gradient,
+ * and the tangents of the variable values are reset to zero.
+ *
+ * @param   expr    scalar expression to differentiate
+ * @param   v       direction vector
+ * @param   hv      output H * v (resized to n)
+ * @param   vars    variables (Var or VarView) to differentiate against
+ * @return  forward evaluation of the expression
+ */
+template <class ExprType
+        , class VType
+        , class HVType
+        , class... VarTypes>
+inline auto hvp(ExprType&& expr,
+                const Eigen::MatrixBase<VType>& v,
+                Eigen::PlainObjectBase<HVType>& hv,
+                VarTypes&... vars)
 {
-    auto it = hess_begin;
-    auto expr = std::get<0>(gen.template generate<opt_sizes...>(x));
-
-    for (size_t i = 0; i < x.size(); ++i)
-    {
-        x.reset_adjoint();
-        if (i > 0) {
-            x[i-1].get_value().set_adjoint(0);  // set the (i-1)th forward variable's adjoint back to 0
-        }
-        x[i].get_value().set_adjoint(1); // set the ith forward variable's adjoint to 1
-        autodiff(expr);
-
-        // Record gradient
-        *grad_begin = expr.get_value().get_adjoint(); // get expression forward value's adjoint
-        ++grad_begin;
-        // Record Hessian first column
-        // Advance iterator to next column of matrix
-        it = compute_hess(it, x);
-    }
+    static_assert(sizeof...(VarTypes) > 0,
+                  "At least one variable must be given.");
+    static_assert(util::is_scl_v<std::decay_t<ExprType>>,
+                  "Expression must be scalar.");
+
+    size_t n = (static_cast<size_t>(vars.size()) + ...);
+    assert(static_cast<size_t>(v.size()) == n);
+    hv.resize(n);
+
+    auto out = core::hvp_sweep(expr, v, vars...);
+    core::for_each_var_elem([&](size_t k, auto& val, auto& adj) {
+            hv(k) = adj.get_adjoint();
+            val.set_adjoint(0);
+        }, vars...);
+
+    return out;
 }
 
-} // namespace core
+template <class ExprType
+        , class VType
+        , class HVType
+        , class... VarTypes>
+inline auto hvp(core::ExprBind<ExprType>& expr,
+                const Eigen::MatrixBase<VType>& v,
+                Eigen::PlainObjectBase<HVType>& hv,
+                VarTypes&... vars)
+{
+    return hvp(expr.get(), v, hv, vars...);
+}
 
-// The function will store only the hessian into object pointed by hess_begin.
-// This overload will only be enabled if all of the iterators
-// are dereferenceable like a pointer, i.e., valid iterators.
-// @param   hess_begin  column-wise iterator of a 2d-array or matrix to store hessian
-// @param   begin       iterator to first underlying data
-// @param   end         iterator to one past last underlying data
-// @param   f           lambda function to compute hessian and gradient of
-//                      it is expected that the arguments follow the specs of exgen
-//                      and in addition are declared with auto or Vec<ForwardVar<T>> for some T.
-template <size_t... opt_sizes, class HessIter, class Iter, class F
-    , class = std::enable_if_t<
-    utils::is_pointer_like_dereferenceable<HessIter>::value &&
-    utils::is_pointer_like_dereferenceable<Iter>::value
-    >
->
-inline void hessian(HessIter hess_begin, Iter begin, Iter end, F&& f)
+template <class ExprType
+        , class VType
+        , class HVType
+        , class... VarTypes>
+inline auto hvp(core::ExprBind<ExprType>&& expr,
+                const Eigen::MatrixBase<VType>& v,
+                Eigen::PlainObjectBase<HVType>& hv,
+                VarTypes&... vars)
 {
-    using T = typename std::iterator_traits<Iter>::value_type;
-    auto gen = make_exgen<ForwardVar<T>>(std::forward<F>(f));
-    Vec<ForwardVar<T>> x(begin, end);
-    core::hessian_gen<opt_sizes...>(hess_begin, x, gen);
+    return hvp(expr.get(), v, hv, vars...);
 }
 
-// The function will store the hessian into object pointed by hess_begin,
-// and store gradient as well into object pointed by grad_begin.
-// This overload will only be enabled if all of the iterators
-// are dereferenceable like a pointer, i.e., valid iterators.
-// @param   hess_begin  column-wise iterator of a 2d-array or matrix to store hessian
-// @param   grad_begin  iterator of a array or 1-d matrix to store gradient
-// @param   begin       iterator to first underlying data
-// @param   end         iterator to one past last underlying data
-// @param   f           lambda function to compute hessian and gradient of
-//                      it is expected that the arguments follow the specs of exgen
-//                      and in addition are declared with auto or Vec<ForwardVar<T>> for some T.
-template <size_t... opt_sizes, class HessIter, class GradIter, class Iter, class F
-    , class = std::enable_if_t<
-    utils::is_pointer_like_dereferenceable<HessIter>::value &&
-    utils::is_pointer_like_dereferenceable<GradIter>::value &&
-    utils::is_pointer_like_dereferenceable<Iter>::value
-    > >
-inline void hessian(HessIter hess_begin, GradIter grad_begin, Iter begin, Iter end, F&& f)
+/**
+ * Computes the Hessian of a scalar expression with respect to the given variables
+ * using n Hessian-vector products with the unit vectors (see ad::hvp).
+ * Column j of the output is H * e_j.
+ * On return, the values of the variable adjoints hold the gradient.
+ *
+ * @param   expr    scalar expression to differentiate
+ * @param   hess    Hessian output (resized to n x n)
+ * @param   vars    variables (Var or VarView) to differentiate against
+ * @return  forward evaluation of the expression
+ */
+template <class ExprType
+        , class HessType
+        , class... VarTypes>
+inline auto hessian(ExprType&& expr,
+                    Eigen::PlainObjectBase<HessType>& hess,
+                    VarTypes&... vars)
 {
-    using T = typename std::iterator_traits<Iter>::value_type;
-    auto gen = make_exgen<ForwardVar<T>>(std::forward<F>(f));
-    Vec<ForwardVar<T>> x(begin, end);
-    core::hessian_gen<opt_sizes...>(hess_begin, grad_begin, x, gen);
+    static_assert(sizeof...(VarTypes) > 0,
+                  "At least one variable must be given.");
+    static_assert(util::is_scl_v<std::decay_t<ExprType>>,
+                  "Expression must be scalar.");
+
+    using value_t = typename util::expr_traits<std::decay_t<ExprType>>::value_t;
+    using scalar_t = typename value_t::value_type;
+
+    size_t n = (static_cast<size_t>(vars.size()) + ...);
+    hess.resize(n, n);
+
+    Eigen::Matrix<scalar_t, Eigen::Dynamic, 1> e =
+        Eigen::Matrix<scalar_t, Eigen::Dynamic, 1>::Zero(n);
+    scalar_t out = 0;
+    for (size_t j = 0; j < n; ++j) {
+        if (j > 0) e(j-1) = 0;
+        e(j) = 1;
+        out = core::hvp_sweep(expr, e, vars...);
+        core::for_each_var_elem([&](size_t k, auto&, auto& adj) {
+                hess(k, j) = adj.get_adjoint();
+            }, vars...);
+    }
+
+    core::for_each_var_elem([](size_t, auto& val, auto&) {
+            val.set_adjoint(0);
+        }, vars...);
+
+    return out;
 }
 
-template <size_t... opt_sizes, class Matrix_T, class Iter, class F>
-inline void hessian(Mat<Matrix_T>& hess_mat, Iter begin, Iter end, F&& f)
+template <class ExprType
+        , class HessType
+        , class... VarTypes>
+inline auto hessian(core::ExprBind<ExprType>& expr,
+                    Eigen::PlainObjectBase<HessType>& hess,
+                    VarTypes&... vars)
 {
-    const size_t n = static_cast<size_t>(std::distance(begin, end));
-    hess_mat.zeros(n, n);
-    hessian<opt_sizes...>(hess_mat.begin(), begin, end, std::forward<F>(f));
+    return hessian(expr.get(), hess, vars...);
 }
 
-template <size_t... opt_sizes, class Matrix_T, class F, class Iter>
-inline void hessian(Mat<Matrix_T>& hess_mat, Mat<Matrix_T>& grad_mat, Iter begin, Iter end, F&& f)
+template <class ExprType
+        , class HessType
+        , class... VarTypes>
+inline auto hessian(core::ExprBind<ExprType>&& expr,
+                    Eigen::PlainObjectBase<HessType>& hess,
+                    VarTypes&... vars)
 {
-    const size_t n = static_cast<size_t>(std::distance(begin, end));
-    hess_mat.zeros(n, n);
-    grad_mat.zeros(1, n);
-    hessian<opt_sizes...>(hess_mat.begin(), grad_mat.begin(), begin, end, std::forward<F>(f));
+    return hessian(expr.get(), hess, vars...);
 }
 
 } // namespace ad
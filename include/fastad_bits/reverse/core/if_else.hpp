@@ -77,6 +77,7 @@ public:
 
     const auto& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         return cond_expr_.feval() ? 
                 if_expr_.feval() : else_expr_.feval();
     }
@@ -84,6 +85,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (cond_expr_.get()) {
             if_expr_.beval(seed);
         } else {
@@ -108,6 +110,14 @@ public:
     util::SizePack single_bind_cache_size() const
     { return {0,0}; }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(cond_expr_);
+        f(if_expr_);
+        f(else_expr_);
+    }
+
 private:
     cond_t cond_expr_;
     if_t if_expr_;
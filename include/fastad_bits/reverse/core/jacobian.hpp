@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <Eigen/Core>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/util/shape_traits.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * Copies the (flattened, column-major) adjoints of each variable
+ * into consecutive segments of the given row.
+ */
+template <class RowType, class... VarTypes>
+inline void copy_adj_to_row(RowType&& row, VarTypes&... vars)
+{
+    size_t offset = 0;
+    auto copy = [&](auto& var) {
+        using value_t = typename util::expr_traits<
+            std::decay_t<decltype(var)>>::value_t;
+        size_t size = var.size();
+        row.segment(offset, size) =
+            Eigen::Map<const Eigen::Matrix<value_t, 1, Eigen::Dynamic>>(
+                    var.data_adj(), size);
+        offset += size;
+    };
+    (copy(vars), ...);
+}
+
+} // namespace core
+
+/**
+ * Computes the Jacobian of an expression with respect to the given variables.
+ *
+ * The expression is forward evaluated once.
+ * Then, for every output element i (flattened in column-major order for matrices),
+ * the expression is backward evaluated with the ith unit seed,
+ * reusing the bound cache of the forward pass.
+ * Only the adjoints that accumulate are reset between the sweeps,
+ * i.e. those of the variables and placeholders of the expression.
+ * The cache adjoints are always overwritten by the nodes so they need no reset.
+ *
+ * Row i of the output is the gradient of output element i.
+ * The columns are the (flattened, column-major) elements of the variables
+ * concatenated in the given order.
+ * A variable that does not appear in the expression gets zero columns.
+ * The adjoints of all variables and placeholders are zero on return.
+ *
+ * The expression must be bound (see ad::bind) before calling this function.
+ *
+ * @param   expr    expression to differentiate
+ * @param   jac     Jacobian output (resized to m x n)
+ * @param   vars    variables (Var or VarView) to differentiate against
+ * @return  forward evaluation of the expression
+ */
+template <class ExprType
+        , class JacType
+        , class... VarTypes>
+inline auto jacobian(ExprType&& expr,
+                     Eigen::PlainObjectBase<JacType>& jac,
+                     VarTypes&... vars)
+{
+    static_assert(sizeof...(VarTypes) > 0,
+                  "At least one variable must be given.");
+
+    using expr_t = std::decay_t<ExprType>;
+    using value_t = typename util::expr_traits<expr_t>::value_t;
+    using shape_t = typename util::shape_traits<expr_t>::shape_t;
+
+    auto zero_adj = [&]() {
+        core::zero_leaf_adj(expr);
+        (vars.zero_adj(), ...);
+    };
+
+    // reset adjoints left over from previous evaluations
+    zero_adj();
+    util::constant_var_t<value_t, shape_t> out = expr.feval();
+
+    size_t m = expr.size();
+    size_t n = (static_cast<size_t>(vars.size()) + ...);
+    jac.resize(m, n);
+
+    if constexpr (util::is_scl_v<expr_t>) {
+        expr.beval(value_t(1));
+        core::copy_adj_to_row(jac.row(0), vars...);
+    } else {
+        Eigen::Array<value_t, Eigen::Dynamic, Eigen::Dynamic> seed =
+            Eigen::Array<value_t, Eigen::Dynamic, Eigen::Dynamic>::Zero(
+                    expr.rows(), expr.cols());
+        for (size_t i = 0; i < m; ++i) {
+            if (i > 0) {
+                seed(i-1) = 0;
+                zero_adj();
+            }
+            seed(i) = 1;
+            if constexpr (util::is_vec_v<expr_t>) {
+                expr.beval(seed.col(0));
+            } else {
+                expr.beval(seed);
+            }
+            core::copy_adj_to_row(jac.row(i), vars...);
+        }
+    }
+    zero_adj();
+
+    return out;
+}
+
+template <class ExprType
+        , class JacType
+        , class... VarTypes>
+inline auto jacobian(core::ExprBind<ExprType>& expr,
+                     Eigen::PlainObjectBase<JacType>& jac,
+                     VarTypes&... vars)
+{
+    return jacobian(expr.get(), jac, vars...);
+}
+
+template <class ExprType
+        , class JacType
+        , class... VarTypes>
+inline auto jacobian(core::ExprBind<ExprType>&& expr,
+                     Eigen::PlainObjectBase<JacType>& jac,
+                     VarTypes&... vars)
+{
+    return jacobian(expr.get(), jac, vars...);
+}
+
+} // namespace ad
@@ -0,0 +1,172 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <Eigen/Dense>
+#include <fastad_bits/util/intra_op.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * LLTCache holds the Cholesky factorization of a symmetric positive definite matrix
+ * and, once requested, its inverse.
+ * It is the factorization of the nodes reading such a matrix
+ * (DetLLT, LogDetLLT, NormalAdjLogPDFNode, WishartAdjLogPDFNode).
+ *
+ * A cache is private to its node unless ad::share_factorizations
+ * gives the same cache to every node reading the same matrix.
+ * A shared cache keeps a copy of the last factorized matrix
+ * and is only factorized again if the matrix changed,
+ * so that one factorization (and at most one inverse) per evaluation serves every node.
+ * Shared caches are locked, since scheduled subtrees (see ad::schedule) may read them concurrently.
+ *
+ * @tparam  ValueType   value type of the matrix
+ * @tparam  Size        number of rows of the matrix if fixed-size
+ */
+template <class ValueType, int Size = Eigen::Dynamic>
+struct LLTCache
+{
+    using value_t = ValueType;
+    using mat_t = Eigen::Matrix<value_t, Size, Size>;
+    using llt_t = Eigen::LLT<mat_t, Eigen::Lower>;
+
+    explicit LLTCache(size_t rows)
+        : llt_(rows)
+        , inv_(rows, rows)
+    {}
+
+    // copies are private
+    LLTCache(const LLTCache& other)
+        : llt_(other.llt_)
+        , valid_(other.valid_)
+        , has_inv_(other.has_inv_)
+        , inv_(other.inv_)
+    {}
+
+    /**
+     * Factorizes x, unless the cache is shared and x equals the last factorized matrix.
+     */
+    template <class T>
+    void compute(const Eigen::MatrixBase<T>& x)
+    {
+        std::unique_lock<std::mutex> lock(mtx_, std::defer_lock);
+        if (shared_) {
+            lock.lock();
+            if (has_src_ && src_ == x) return;
+            src_ = x;
+            has_src_ = true;
+        }
+        llt_.compute(x);
+        valid_ = (llt_.info() == Eigen::Success);
+        has_inv_ = false;
+    }
+
+    /**
+     * Returns the inverse of the factorized matrix.
+     * It is computed with the factorization on the first call after compute
+     * (see util::solve_identity) and reused until the next factorization.
+     */
+    const mat_t& inverse()
+    {
+        std::unique_lock<std::mutex> lock(mtx_, std::defer_lock);
+        if (shared_) lock.lock();
+        if (!has_inv_) {
+            util::solve_identity(llt_, inv_);
+            has_inv_ = true;
+        }
+        return inv_;
+    }
+
+    const llt_t& llt() const { return llt_; }
+    bool valid() const { return valid_; }
+    size_t rows() const { return inv_.rows(); }
+    bool shared() const { return shared_; }
+
+    // marks the cache as shared by multiple nodes (see ad::share_factorizations)
+    void mark_shared()
+    {
+        if (shared_) return;
+        shared_ = true;
+        has_src_ = false;
+        src_.resize(rows(), rows());
+    }
+
+private:
+    std::mutex mtx_;
+    llt_t llt_;
+    bool valid_ = false;
+    bool has_inv_ = false;
+    bool shared_ = false;
+    bool has_src_ = false;
+    mat_t inv_;
+    mat_t src_;     // last factorized matrix if shared
+};
+
+/**
+ * LLTSlot is the member of a node holding its LLTCache.
+ * Copying a slot copies the factorization into a new private cache,
+ * so that copies evaluated concurrently (e.g. thread-local copies of an ExprBind)
+ * never share a cache. A copied expression must be shared again.
+ *
+ * @tparam  ValueType   value type of the matrix
+ * @tparam  Size        number of rows of the matrix if fixed-size
+ */
+template <class ValueType, int Size = Eigen::Dynamic>
+struct LLTSlot
+{
+    using cache_t = LLTCache<ValueType, Size>;
+
+    explicit LLTSlot(size_t rows)
+        : cache_(std::make_shared<cache_t>(rows))
+    {}
+
+    LLTSlot(const LLTSlot& other)
+        : cache_(std::make_shared<cache_t>(*other.cache_))
+    {}
+
+    LLTSlot(LLTSlot&&) =default;
+
+    LLTSlot& operator=(const LLTSlot& other)
+    {
+        cache_ = std::make_shared<cache_t>(*other.cache_);
+        return *this;
+    }
+
+    LLTSlot& operator=(LLTSlot&&) =default;
+
+    cache_t& operator*() { return *cache_; }
+    const cache_t& operator*() const { return *cache_; }
+    cache_t* operator->() { return cache_.get(); }
+    const cache_t* operator->() const { return cache_.get(); }
+
+    const std::shared_ptr<cache_t>& cache() const { return cache_; }
+
+    // shares the cache of another slot
+    void share(const std::shared_ptr<cache_t>& cache)
+    {
+        cache->mark_shared();
+        cache_ = cache;
+    }
+
+    // replaces the cache with a new private one
+    void reset() { cache_ = std::make_shared<cache_t>(cache_->rows()); }
+
+private:
+    std::shared_ptr<cache_t> cache_;
+};
+
+namespace details {
+
+template <class T, class = std::void_t<>>
+struct has_llt_slot : std::false_type {};
+template <class T>
+struct has_llt_slot<T, std::void_t<decltype(std::declval<T&>().llt_slot())> >
+    : std::true_type {};
+
+} // namespace details
+
+} // namespace core
+} // namespace ad
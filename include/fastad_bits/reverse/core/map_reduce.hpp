@@ -0,0 +1,352 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <Eigen/Core>
+#include <fastad_bits/reverse/core/adj_scratch.hpp>
+#include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/reverse/core/value_adj_view.hpp>
+#include <fastad_bits/util/shape_traits.hpp>
+#include <fastad_bits/util/size_pack.hpp>
+#include <fastad_bits/util/thread_pool.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+#include <fastad_bits/util/value.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * MapReduceStorage holds the row buffers that the row expressions of a MapReduceNode view.
+ * There is one buffer per chunk and every row of a chunk is copied into it before evaluation.
+ * Like ScanStorage, the buffers must have a stable address
+ * even when the MapReduceNode is moved.
+ * A copy of a MapReduceNode gets a copy of the storage (see MapReduceNode).
+ */
+template <class DataValueType>
+struct MapReduceStorage
+{
+    using data_value_t = DataValueType;
+    using row_t = Eigen::Matrix<data_value_t, Eigen::Dynamic, 1>;
+
+    MapReduceStorage(size_t n_chunks, size_t n_cols)
+        : rows(n_chunks, row_t::Zero(n_cols))
+    {}
+
+    std::vector<row_t> rows;
+};
+
+/**
+ * MapReduceNode represents the sum of a scalar row expression over the rows of a data matrix:
+ *
+ *      f(x_1) + f(x_2) + ... + f(x_n)
+ *
+ * where x_i is the ith row of the data.
+ * This is the usual form of a loss over a data set.
+ *
+ * Unlike ad::sum(begin, end, f), which creates one expression per row,
+ * the rows are split into contiguous chunks (one per thread of the pool)
+ * and each chunk has a single row expression (with its own cache) that is reused for every row.
+ * Hence, the memory does not grow with the number of rows.
+ * The row expression of a chunk views the row buffer of the chunk,
+ * into which each row is copied before the expression is evaluated.
+ *
+ * Forward evaluation accumulates each chunk into its own partial sum,
+ * then the partial sums are added in chunk order.
+ *
+ * Since a row expression only holds the cache of the last row it evaluated,
+ * backward evaluation forward evaluates each row again before backward evaluating it.
+ * Like ParSumIterNode, every chunk accumulates the adjoints of the leaves
+ * into a thread-private AdjScratch, and the scratches are reduced in chunk order.
+ * Hence, for a fixed pool size, the results are deterministic.
+ *
+ * The row expressions must not contain placeholders (EqNode, OpEqNode)
+ * since their adjoints would accumulate across the rows.
+ * Copying the node copies the row buffers (see MapReduceStorage)
+ * and rebinds the row views of the copy to them,
+ * so that copies (e.g. clones of an ExprBind) can be evaluated concurrently.
+ *
+ * If the node is evaluated without a pool or inside a parallel region,
+ * the chunks are evaluated serially by the calling thread.
+ *
+ * @tparam  DataValueType   underlying data type of the data matrix
+ * @tparam  RowExprType     type of the row expression
+ */
+
+template <class DataValueType, class RowExprType>
+struct MapReduceNode:
+    ValueAdjView<typename util::expr_traits<RowExprType>::value_t, ad::scl>,
+    ExprBase<MapReduceNode<DataValueType, RowExprType>>
+{
+private:
+    using row_expr_t = RowExprType;
+    using row_value_t = typename util::expr_traits<row_expr_t>::value_t;
+
+    static_assert(util::is_scl_v<row_expr_t>,
+                  "Row expression of map_reduce must be a scalar.");
+
+public:
+    using value_adj_view_t = ValueAdjView<row_value_t, ad::scl>;
+    using typename value_adj_view_t::value_t;
+    using typename value_adj_view_t::shape_t;
+    using typename value_adj_view_t::var_t;
+    using typename value_adj_view_t::ptr_pack_t;
+    using data_value_t = DataValueType;
+    using data_t = Eigen::Matrix<data_value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using storage_t = MapReduceStorage<data_value_t>;
+    using partial_t = util::accum_t<value_t>;
+    using scratch_t = AdjScratch<value_t>;
+
+    MapReduceNode(const std::vector<row_expr_t>& exprs,
+                  const std::shared_ptr<storage_t>& storage,
+                  const data_t& data,
+                  util::ThreadPool* pool)
+        : value_adj_view_t(nullptr, nullptr, 1, 1)
+        , exprs_(exprs)
+        , storage_(storage)
+        , data_(&data)
+        , pool_(pool)
+        , partials_(exprs.size(), partial_t(0))
+        , scratch_(exprs.size())
+    {
+        assert(exprs_.size() == storage_->rows.size());
+    }
+
+    MapReduceNode(const MapReduceNode& other)
+        : value_adj_view_t(other)
+        , exprs_(other.exprs_)
+        , storage_(std::make_shared<storage_t>(*other.storage_))
+        , data_(other.data_)
+        , pool_(other.pool_)
+        , partials_(other.partials_)
+        , scratch_(other.scratch_)
+    {
+        rebind_rows(*other.storage_);
+    }
+
+    MapReduceNode(MapReduceNode&&) =default;
+
+    MapReduceNode& operator=(const MapReduceNode& other)
+    {
+        if (this != &other) *this = MapReduceNode(other);
+        return *this;
+    }
+
+    MapReduceNode& operator=(MapReduceNode&&) =default;
+
+    /**
+     * Forward evaluates every chunk in parallel into its own partial sum,
+     * then accumulates the partial sums in chunk order.
+     *
+     * @return  sum of the row expression over every row
+     */
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        for_each_chunk([&](size_t c) {
+            auto range = chunk_range(c);
+            partial_t partial(0);
+            for (size_t i = range.first; i < range.second; ++i) {
+                partial += row_feval(c, i);
+            }
+            partials_[c] = partial;
+        });
+        partial_t sum(0);
+        for (const auto& partial : partials_) {
+            sum += partial;
+        }
+        return this->get() = sum;
+    }
+
+    /**
+     * Backward evaluates every row with the same seed, chunks in parallel.
+     * Each row is first forward evaluated again to restore the cache of its row expression.
+     */
+    void beval(value_t seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        this->get_adj() = seed;
+
+        // nested parallel region: leaves already accumulate into the outer scratch
+        if (scratch_t::active()) {
+            for (size_t c = 0; c < exprs_.size(); ++c) {
+                chunk_beval(c, seed);
+            }
+            return;
+        }
+
+        for_each_chunk([&](size_t c) {
+            typename scratch_t::Guard guard(scratch_[c]);
+            chunk_beval(c, seed);
+        });
+
+        for (auto& scratch : scratch_) {
+            scratch.reduce();
+        }
+    }
+
+    /**
+     * Binds the row expression of every chunk from left to right then binds itself.
+     * Every chunk thus gets its own region of the cache.
+     * The leaves of every chunk are resolved in the scratch of the chunk.
+     *
+     * @return  the next pointer not bound by any of the expressions and itself.
+     */
+    ptr_pack_t bind_cache(ptr_pack_t begin)
+    {
+        for (size_t c = 0; c < exprs_.size(); ++c) {
+            begin = exprs_[c].bind_cache(begin);
+            scratch_[c].clear();
+            scratch_[c].resolve(exprs_[c]);
+        }
+        return value_adj_view_t::bind_cache_slot(begin);
+    }
+
+    util::SizePack bind_cache_size() const
+    {
+        util::SizePack out = util::SizePack::Zero();
+        for (const auto& expr : exprs_) {
+            out += expr.bind_cache_size();
+        }
+        return out + single_bind_cache_size();
+    }
+
+    util::SizePack single_bind_cache_size() const
+    {
+        return {this->cache_size(), this->cache_size()};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        for (auto& expr : exprs_) f(expr);
+    }
+
+private:
+    template <class F>
+    void for_each_chunk(F&& f)
+    {
+        if (pool_) {
+            pool_->parallel_for(exprs_.size(), f);
+        } else {
+            for (size_t c = 0; c < exprs_.size(); ++c) f(c);
+        }
+    }
+
+    std::pair<size_t, size_t> chunk_range(size_t c) const
+    {
+        return util::chunk_range(data_->rows(), exprs_.size(), c);
+    }
+
+    // rebinds the row views of every row expression from the buffer of its chunk in from
+    // to the buffer of the same chunk in this node's storage
+    void rebind_rows(const storage_t& from)
+    {
+        using row_view_t = ConstantView<data_value_t, ad::vec>;
+        for (size_t c = 0; c < exprs_.size(); ++c) {
+            const data_value_t* from_row = from.rows[c].data();
+            const data_value_t* to_row = storage_->rows[c].data();
+            for_each_node(exprs_[c], [&](auto& node) {
+                using node_t = std::decay_t<decltype(node)>;
+                if constexpr (std::is_same_v<node_t, row_view_t>) {
+                    if (node.data() == from_row) node.rebind(to_row);
+                }
+            });
+        }
+    }
+
+    // loads row i into the buffer of chunk c and forward evaluates the row expression of c
+    value_t row_feval(size_t c, size_t i)
+    {
+        storage_->rows[c] = data_->row(i).transpose();
+        return exprs_[c].feval();
+    }
+
+    void chunk_beval(size_t c, value_t seed)
+    {
+        auto range = chunk_range(c);
+        for (size_t i = range.second; i > range.first; --i) {
+            row_feval(c, i-1);
+            exprs_[c].beval(seed);
+        }
+    }
+
+    std::vector<row_expr_t> exprs_;
+    std::shared_ptr<storage_t> storage_;
+    const data_t* data_;
+    util::ThreadPool* pool_;
+    std::vector<partial_t> partials_;
+    std::vector<scratch_t> scratch_;
+};
+
+template <class RowFn, class DataValueType>
+inline auto make_map_reduce(RowFn&& row_fn,
+                            const Eigen::Matrix<DataValueType,
+                                                Eigen::Dynamic, Eigen::Dynamic>& data,
+                            util::ThreadPool* pool)
+{
+    using data_value_t = DataValueType;
+    using storage_t = MapReduceStorage<data_value_t>;
+    using row_view_t = ConstantView<data_value_t, ad::vec>;
+    using row_expr_t = util::convert_to_ad_t<
+        decltype(row_fn(std::declval<const row_view_t&>()))>;
+
+    size_t n_rows = data.rows();
+    size_t n_chunks = std::max<size_t>(1,
+            std::min(n_rows, pool ? pool->size() : 1));
+    auto storage = std::make_shared<storage_t>(n_chunks, data.cols());
+
+    std::vector<row_expr_t> exprs;
+    exprs.reserve(n_chunks);
+    for (size_t c = 0; c < n_chunks; ++c) {
+        row_view_t row(storage->rows[c].data(), data.cols(), 1);
+        exprs.emplace_back(row_fn(row));
+    }
+
+    return MapReduceNode<data_value_t, row_expr_t>(exprs, storage, data, pool);
+}
+
+} // namespace core
+
+/**
+ * Creates a MapReduceNode representing the sum of row_fn over the rows of data:
+ *
+ *      row_fn(x_1) + ... + row_fn(x_n)
+ *
+ * where x_i is the ith row of data.
+ * The rows are evaluated in parallel on the threads of pool,
+ * which must outlive the returned expression.
+ * row_fn is invoked once per thread with a vector ConstantView of a row buffer
+ * and must return a scalar expression; parameters are usually captured by row_fn.
+ * The data is not copied and must outlive the returned expression.
+ *
+ * @param   pool    thread pool evaluating the rows
+ * @param   data    data matrix with one data point per row
+ * @param   row_fn  functor creating the row expression from a view of a row
+ */
+template <class RowFn, class DataValueType>
+inline auto map_reduce(util::ThreadPool& pool,
+                       const Eigen::Matrix<DataValueType,
+                                           Eigen::Dynamic, Eigen::Dynamic>& data,
+                       RowFn&& row_fn)
+{
+    return core::make_map_reduce(row_fn, data, &pool);
+}
+
+/**
+ * Same as map_reduce(pool, data, row_fn), but evaluates every row on the calling thread
+ * with a single row expression.
+ */
+template <class RowFn, class DataValueType>
+inline auto map_reduce(const Eigen::Matrix<DataValueType,
+                                           Eigen::Dynamic, Eigen::Dynamic>& data,
+                       RowFn&& row_fn)
+{
+    return core::make_map_reduce(row_fn, data, nullptr);
+}
+
+} // namespace ad
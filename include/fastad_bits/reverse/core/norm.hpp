@@ -47,12 +47,14 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& res = expr_.feval();
-        return this->get() = res.squaredNorm();
+        return this->get() = util::accum_squared_norm(res);
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         auto&& a_expr = util::to_array(expr_.get());
         expr_.beval(seed * 2. * a_expr);
     }
@@ -62,7 +64,7 @@ public:
         begin = expr_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -75,7 +77,13 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
     }
 
 private:
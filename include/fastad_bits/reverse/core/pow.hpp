@@ -90,6 +90,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         if constexpr (util::is_scl_v<expr_t>) {
             return this->get() =
                     PowFunc<exp_>::evaluate(expr_.feval()); 
@@ -101,6 +102,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         static_cast<void>(seed);
 
         // derivative of x^0 = c is 0
@@ -167,11 +169,11 @@ public:
         if constexpr (exp == 0 || exp == 1) {
             auto adj = begin.adj;
             begin.adj = nullptr;
-            begin = value_adj_view_t::bind(begin);
+            begin = value_adj_view_t::bind_cache_slot(begin);
             begin.adj = adj;
             return begin;
         } else {
-            return value_adj_view_t::bind(begin);
+            return value_adj_view_t::bind_cache_slot(begin);
         }
     }
 
@@ -184,12 +186,18 @@ public:
     util::SizePack single_bind_cache_size() const
     {
         if constexpr (exp == 0 || exp == 1) {
-            return {this->size(), 0};
+            return {this->cache_size(), 0};
         } else {
-            return {this->size(), this->size()};
+            return {this->cache_size(), this->cache_size()};
         }
     }
 
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
+    }
+
 private:
     expr_t expr_;
     static constexpr int64_t exp_ = exp;
@@ -54,6 +54,7 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         this->ones();
         for (auto& expr : exprs_) {
             util::to_array(this->get()) *= util::to_array(expr.feval());
@@ -67,6 +68,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (exprs_.size() == 0) return;
         auto&& a_val = util::to_array(this->get());
         auto&& a_adj = util::to_array(this->get_adj());
@@ -113,7 +115,7 @@ public:
         for (auto& expr : exprs_) {
             begin = expr.bind_cache(begin);
         }
-        return value_adj_view_t::bind(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
     }
 
     util::SizePack bind_cache_size() const 
@@ -127,7 +129,13 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), this->size()}; 
+        return {this->cache_size(), this->cache_size()}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        for (auto& expr : exprs_) f(expr);
     }
 
 private:
@@ -171,6 +179,7 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& res = expr_.feval();
         if constexpr (util::is_scl_v<expr_t>) {
             return this->get() = res;
@@ -187,6 +196,7 @@ public:
      */
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         for (size_t k = 0; k < expr_.cols(); ++k) {
             for (size_t l = 0; l < expr_.rows(); ++l) {
 
@@ -222,7 +232,7 @@ public:
         begin.adj = adj_cache_.bind(begin.adj);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -235,7 +245,13 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), expr_.size()}; 
+        return {this->cache_size(), expr_.size()}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
     }
 
 private:
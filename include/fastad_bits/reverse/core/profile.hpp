@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/util/profile.hpp>
+#include <fastad_bits/util/type_name.hpp>
+
+namespace ad {
+namespace core {
+namespace details {
+
+template <class T>
+inline constexpr bool profile_enabled_v =
+#ifdef FASTAD_PROFILE
+    true;
+#else
+    false;
+#endif
+
+} // namespace details
+
+#ifdef FASTAD_PROFILE
+
+/**
+ * Profile of one node of an expression.
+ * Nodes are listed in pre-order (see for_each_node),
+ * so that id is the position of the node in the tree.
+ * Inclusive times (in feval, beval) contain the time spent in the children
+ * while exclusive times only contain the time spent in the node itself.
+ */
+struct ProfileEntry
+{
+    using duration_t = util::ProfileCounter::clock_t::duration;
+
+    size_t id = 0;
+    size_t depth = 0;
+    std::string name;
+    util::ProfileCounter feval;
+    util::ProfileCounter beval;
+    duration_t feval_exclusive = duration_t::zero();
+    duration_t beval_exclusive = duration_t::zero();
+};
+
+template <class ExprType>
+inline void collect_profile(ExprType& expr,
+                            size_t depth,
+                            std::vector<ProfileEntry>& out)
+{
+    using duration_t = ProfileEntry::duration_t;
+
+    // out may reallocate while visiting the children, so only refer to it by index
+    size_t id = out.size();
+    out.emplace_back();
+    out[id].id = id;
+    out[id].depth = depth;
+    out[id].name = util::short_type_name<ExprType>();
+    out[id].feval = expr.profile().feval;
+    out[id].beval = expr.profile().beval;
+
+    duration_t children_feval = duration_t::zero();
+    duration_t children_beval = duration_t::zero();
+    expr.for_each_child([&](auto& child) {
+        size_t child_id = out.size();
+        collect_profile(child, depth + 1, out);
+        children_feval += out[child_id].feval.time;
+        children_beval += out[child_id].beval.time;
+    });
+
+    // children evaluated outside of this node (not the case for well-formed trees)
+    // could make the difference negative
+    out[id].feval_exclusive = std::max(out[id].feval.time - children_feval,
+                                       duration_t::zero());
+    out[id].beval_exclusive = std::max(out[id].beval.time - children_beval,
+                                       duration_t::zero());
+}
+
+template <class ExprType>
+inline void reset_profile(ExprType& expr)
+{
+    for_each_node(expr, [](auto& node) {
+        node.profile().feval.reset();
+        node.profile().beval.reset();
+    });
+}
+
+#endif
+
+} // namespace core
+
+/**
+ * Returns the profile of every node of the expression in pre-order.
+ * Requires FASTAD_PROFILE.
+ */
+template <class ExprType>
+inline auto profile(ExprType& expr)
+{
+    static_assert(core::details::profile_enabled_v<ExprType>,
+                  "ad::profile requires FASTAD_PROFILE to be defined.");
+#ifdef FASTAD_PROFILE
+    std::vector<core::ProfileEntry> out;
+    core::collect_profile(expr, 0, out);
+    return out;
+#endif
+}
+
+template <class ExprType>
+inline auto profile(core::ExprBind<ExprType>& expr)
+{
+    return profile(expr.get());
+}
+
+/**
+ * Resets the profiling counters of every node of the expression.
+ * Requires FASTAD_PROFILE.
+ */
+template <class ExprType>
+inline void profile_reset(ExprType& expr)
+{
+    static_assert(core::details::profile_enabled_v<ExprType>,
+                  "ad::profile_reset requires FASTAD_PROFILE to be defined.");
+#ifdef FASTAD_PROFILE
+    core::reset_profile(expr);
+#endif
+}
+
+template <class ExprType>
+inline void profile_reset(core::ExprBind<ExprType>& expr)
+{
+    profile_reset(expr.get());
+}
+
+/**
+ * Prints the number of calls and the inclusive and exclusive times (in microseconds)
+ * of feval and beval for every node of the expression that has been evaluated.
+ * Nodes are printed in pre-order and indented by their depth in the tree.
+ * The last column is the share of the exclusive time (feval + beval)
+ * in the total time spent in the root.
+ * Leaves (VarView, Constant) are not instrumented,
+ * so their time is accounted as the exclusive time of their parents.
+ * Requires FASTAD_PROFILE.
+ */
+template <class ExprType>
+inline void profile_report(ExprType& expr, std::ostream& os = std::cout)
+{
+    static_assert(core::details::profile_enabled_v<ExprType>,
+                  "ad::profile_report requires FASTAD_PROFILE to be defined.");
+#ifdef FASTAD_PROFILE
+    auto entries = ad::profile(expr);
+    auto us = [](auto d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+    double total = entries.empty() ? 0 :
+        us(entries[0].feval.time + entries[0].beval.time);
+
+    auto flags = os.flags();
+    os << std::setw(6) << "id"
+       << std::setw(10) << "f.calls"
+       << std::setw(12) << "f.incl(us)"
+       << std::setw(12) << "f.excl(us)"
+       << std::setw(10) << "b.calls"
+       << std::setw(12) << "b.incl(us)"
+       << std::setw(12) << "b.excl(us)"
+       << std::setw(8) << "excl%"
+       << "  node\n";
+    os << std::fixed << std::setprecision(2);
+    for (const auto& e : entries) {
+        if (e.feval.calls == 0 && e.beval.calls == 0) continue;
+        double excl = us(e.feval_exclusive + e.beval_exclusive);
+        os << std::setw(6) << e.id
+           << std::setw(10) << e.feval.calls
+           << std::setw(12) << us(e.feval.time)
+           << std::setw(12) << us(e.feval_exclusive)
+           << std::setw(10) << e.beval.calls
+           << std::setw(12) << us(e.beval.time)
+           << std::setw(12) << us(e.beval_exclusive)
+           << std::setw(8) << ((total > 0) ? 100. * excl / total : 0.)
+           << "  " << std::string(2 * e.depth, ' ') << e.name << '\n';
+    }
+    os.flags(flags);
+#else
+    static_cast<void>(expr);
+    static_cast<void>(os);
+#endif
+}
+
+template <class ExprType>
+inline void profile_report(core::ExprBind<ExprType>& expr, std::ostream& os = std::cout)
+{
+    profile_report(expr.get(), os);
+}
+
+} // namespace ad
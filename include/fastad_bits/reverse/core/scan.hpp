@@ -0,0 +1,439 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <Eigen/Core>
+#include <fastad_bits/reverse/core/adj_scratch.hpp>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/reverse/core/value_adj_view.hpp>
+#include <fastad_bits/reverse/core/var_view.hpp>
+#include <fastad_bits/util/shape_traits.hpp>
+#include <fastad_bits/util/size_pack.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+#include <fastad_bits/util/value.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * ScanStorage holds the buffers that a ScanNode shares with its step expression.
+ * The step expression views the previous state (and the current input)
+ * through VarViews into these buffers, so they must have a stable address
+ * even when the ScanNode is moved.
+ * A copy of a ScanNode gets a copy of the storage (see ScanNode).
+ */
+template <class ValueType>
+struct ScanStorage
+{
+    using value_t = ValueType;
+    using vec_t = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
+    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    ScanStorage(size_t n_state, size_t n_input)
+        : prev_val(vec_t::Zero(n_state))
+        , prev_adj(vec_t::Zero(n_state))
+        , in_val(vec_t::Zero(n_input))
+        , in_adj(vec_t::Zero(n_input))
+    {}
+
+    vec_t prev_val;     // value of the previous state viewed by the step expression
+    vec_t prev_adj;     // adjoint of the previous state viewed by the step expression
+    vec_t in_val;       // current input viewed by the step expression
+    vec_t in_adj;       // adjoint of the current input (discarded)
+    mat_t checkpoints;  // every interval-th state (one per column)
+    mat_t segment;      // states of the segment being backward evaluated
+};
+
+/**
+ * ScanNode represents the state after T applications of a step expression:
+ *
+ *      x_0 = state0, x_t = step(x_{t-1}, u_t), t = 1,...,T
+ *
+ * where u_t is an optional per-step input (column t-1 of an input matrix).
+ * Unlike building T expressions with ad::for_each, a single step expression
+ * (with a single cache) is reused for every step.
+ *
+ * To backward evaluate, the step cache of every step must be available in reverse order.
+ * Instead of storing all T states, forward evaluation only stores
+ * a checkpoint every "interval" steps (default: ceil(sqrt(T))).
+ * Backward evaluation processes the segments between checkpoints from last to first:
+ * it recomputes the states of the segment from its checkpoint,
+ * then for each step in reverse, forward evaluates the step again to restore its cache
+ * and backward evaluates it.
+ * The memory is O((T / interval + interval) * n) for a state of size n
+ * instead of O(T) step caches, at the cost of at most two extra step evaluations per step.
+ *
+ * The step expression must only depend on the previous state, the current input,
+ * and variables that do not change during the scan (e.g. parameters).
+ * It must not contain placeholders (EqNode, OpEqNode)
+ * since their adjoints would accumulate across the steps.
+ * The adjoints of the inputs are discarded.
+ *
+ * Copying the node copies its storage and rebinds the step expression of the copy to it,
+ * so that copies (e.g. clones of an ExprBind) can be evaluated concurrently.
+ *
+ * @tparam  StateExprType   type of initial state expression
+ * @tparam  StepExprType    type of step expression
+ */
+
+template <class StateExprType, class StepExprType>
+struct ScanNode:
+    ValueAdjView<typename util::expr_traits<StepExprType>::value_t,
+                 typename util::shape_traits<StepExprType>::shape_t>,
+    ExprBase<ScanNode<StateExprType, StepExprType>>
+{
+private:
+    using state_expr_t = StateExprType;
+    using step_expr_t = StepExprType;
+    using step_value_t = typename util::expr_traits<step_expr_t>::value_t;
+    using step_shape_t = typename util::shape_traits<step_expr_t>::shape_t;
+
+    static_assert(std::is_same_v<step_shape_t, ad::scl> ||
+                  std::is_same_v<step_shape_t, ad::vec>,
+                  "Scan state must be a scalar or vector.");
+    static_assert(std::is_same_v<step_shape_t,
+                    typename util::shape_traits<state_expr_t>::shape_t>,
+                  "Initial state and step expression must have the same shape.");
+
+public:
+    using value_adj_view_t = ValueAdjView<step_value_t, step_shape_t>;
+    using typename value_adj_view_t::value_t;
+    using typename value_adj_view_t::shape_t;
+    using typename value_adj_view_t::var_t;
+    using typename value_adj_view_t::ptr_pack_t;
+    using storage_t = ScanStorage<value_t>;
+    using vec_t = typename storage_t::vec_t;
+    using inputs_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    ScanNode(const state_expr_t& state0,
+             const step_expr_t& step,
+             const std::shared_ptr<storage_t>& storage,
+             size_t n_steps,
+             size_t interval,
+             const inputs_t* inputs = nullptr)
+        : value_adj_view_t(nullptr, nullptr, state0.rows(), state0.cols())
+        , state0_(state0)
+        , step_(step)
+        , storage_(storage)
+        , n_steps_(n_steps)
+        , interval_(interval)
+        , inputs_(inputs)
+    {
+        assert(state0.size() == step.size());
+        assert(interval_ > 0);
+        size_t n_checkpoints = (n_steps_ + interval_ - 1) / interval_;
+        storage_->checkpoints.resize(this->size(), n_checkpoints);
+        storage_->segment.resize(this->size(), std::min(interval_, n_steps_));
+    }
+
+    ScanNode(const ScanNode& other)
+        : value_adj_view_t(other)
+        , state0_(other.state0_)
+        , step_(other.step_)
+        , storage_(std::make_shared<storage_t>(*other.storage_))
+        , n_steps_(other.n_steps_)
+        , interval_(other.interval_)
+        , inputs_(other.inputs_)
+    {
+        rebind_step(*other.storage_);
+    }
+
+    ScanNode(ScanNode&&) =default;
+
+    ScanNode& operator=(const ScanNode& other)
+    {
+        if (this != &other) *this = ScanNode(other);
+        return *this;
+    }
+
+    ScanNode& operator=(ScanNode&&) =default;
+
+    /**
+     * Forward evaluates the initial state, then applies the step expression T times.
+     * Every interval-th state is checkpointed for backward evaluation.
+     *
+     * @return  const reference to the final state
+     */
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        auto& s = *storage_;
+        set_state(state0_.feval());
+        for (size_t t = 0; t < n_steps_; ++t) {
+            if (t % interval_ == 0) {
+                s.checkpoints.col(t / interval_) = s.prev_val;
+            }
+            set_state(step_feval(t));
+        }
+        if constexpr (std::is_same_v<shape_t, ad::scl>) {
+            this->get() = s.prev_val(0);
+        } else {
+            this->get() = s.prev_val;
+        }
+        return this->get();
+    }
+
+    /**
+     * Sets the current adjoint to seed and backward evaluates
+     * the steps in reverse order segment by segment (see class description).
+     * The adjoint of each step's previous state is carried as the seed of the step before.
+     * Finally, the initial state is backward evaluated with the carried adjoint.
+     */
+    template <class T>
+    void beval(const T& seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        auto& s = *storage_;
+        auto&& a_adj = util::to_array(this->get_adj());
+        a_adj = seed;
+
+        const size_t n = this->size();
+        carry_t carry = a_adj;
+
+        // inside a parallel region, the VarViews of the previous state and input
+        // accumulate into the active scratch, so their adjoints live there.
+        // Scratch slots may move whenever a new slot is created, so always look them up again.
+        auto* scratch = AdjScratch<value_t>::active();
+        auto adj_ptr = [&](vec_t& adj) {
+            return (scratch && adj.size()) ?
+                scratch->get(adj.data(), adj.size()) : adj.data();
+        };
+
+        if (n_steps_ > 0) {
+            size_t n_segments = (n_steps_ + interval_ - 1) / interval_;
+            for (size_t seg = n_segments; seg-- > 0;) {
+                size_t begin = seg * interval_;
+                size_t end = std::min(n_steps_, begin + interval_);
+
+                // recompute the states at the beginning of each step in the segment
+                s.prev_val = s.checkpoints.col(seg);
+                for (size_t t = begin; t < end; ++t) {
+                    s.segment.col(t - begin) = s.prev_val;
+                    if (t + 1 < end) set_state(step_feval(t));
+                }
+
+                for (size_t t = end; t-- > begin;) {
+                    s.prev_val = s.segment.col(t - begin);
+                    step_feval(t);
+                    Eigen::Map<vec_t>(adj_ptr(s.prev_adj), n).setZero();
+                    Eigen::Map<vec_t>(adj_ptr(s.in_adj), s.in_adj.size()).setZero();
+                    step_.beval(carry);
+                    get_carry(carry, adj_ptr(s.prev_adj));
+                }
+            }
+        }
+
+        state0_.beval(carry);
+    }
+
+    /**
+     * Binds the initial state expression, the step expression, then itself.
+     * The checkpoints are owned by the node since their number depends on T.
+     */
+    ptr_pack_t bind_cache(ptr_pack_t begin)
+    {
+        begin = state0_.bind_cache(begin);
+        begin = step_.bind_cache(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
+    }
+
+    util::SizePack bind_cache_size() const
+    {
+        return single_bind_cache_size() +
+                state0_.bind_cache_size() +
+                step_.bind_cache_size();
+    }
+
+    util::SizePack single_bind_cache_size() const
+    {
+        return {this->cache_size(), this->cache_size()};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(state0_);
+        f(step_);
+    }
+
+private:
+    using carry_t = std::conditional_t<
+        std::is_same_v<shape_t, ad::scl>,
+        value_t,
+        Eigen::Array<value_t, Eigen::Dynamic, 1> >;
+
+    template <class V>
+    void set_state(const V& x)
+    {
+        if constexpr (std::is_same_v<shape_t, ad::scl>) {
+            storage_->prev_val(0) = x;
+        } else {
+            storage_->prev_val = x;
+        }
+    }
+
+    void get_carry(carry_t& carry, const value_t* prev_adj) const
+    {
+        if constexpr (std::is_same_v<shape_t, ad::scl>) {
+            carry = *prev_adj;
+        } else {
+            carry = Eigen::Map<const Eigen::Array<value_t, Eigen::Dynamic, 1>>(
+                    prev_adj, this->size());
+        }
+    }
+
+    // rebinds the views of the step expression into the buffers of from
+    // to the same offsets in the buffers of this node's storage
+    void rebind_step(const storage_t& from)
+    {
+        auto& to = *storage_;
+        auto move_ptr = [](value_t*& p, const vec_t& from_buf, vec_t& to_buf) {
+            std::less<const value_t*> less;
+            const value_t* begin = from_buf.data();
+            if (!p || !begin || less(p, begin) || !less(p, begin + from_buf.size())) {
+                return false;
+            }
+            p = to_buf.data() + (p - begin);
+            return true;
+        };
+        for_each_leaf(step_, [&](auto& leaf) {
+            using leaf_t = std::decay_t<decltype(leaf)>;
+            if constexpr (std::is_same_v<typename leaf_t::value_t, value_t>) {
+                value_t* val = leaf.data();
+                value_t* adj = leaf.data_adj();
+                bool moved_val = move_ptr(val, from.prev_val, to.prev_val) ||
+                                 move_ptr(val, from.in_val, to.in_val);
+                bool moved_adj = move_ptr(adj, from.prev_adj, to.prev_adj) ||
+                                 move_ptr(adj, from.in_adj, to.in_adj);
+                if (moved_val || moved_adj) leaf.bind(util::PtrPack<value_t>(val, adj));
+            }
+        });
+    }
+
+    // loads the input of step t (if any) and forward evaluates the step expression
+    decltype(auto) step_feval(size_t t)
+    {
+        if (inputs_) storage_->in_val = inputs_->col(t);
+        return step_.feval();
+    }
+
+    state_expr_t state0_;
+    step_expr_t step_;
+    std::shared_ptr<storage_t> storage_;
+    size_t n_steps_;
+    size_t interval_;
+    const inputs_t* inputs_;
+};
+
+/**
+ * Returns the checkpoint interval for n_steps steps.
+ * If interval is 0, it is ceil(sqrt(n_steps)), which minimizes the memory
+ * of the checkpoints and the recomputed segment combined.
+ */
+inline size_t scan_interval(size_t n_steps, size_t interval)
+{
+    if (interval > 0) return interval;
+    return std::max<size_t>(1,
+            static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n_steps)))));
+}
+
+} // namespace core
+
+/**
+ * Creates a ScanNode representing the state after n_steps applications of step_fn:
+ *
+ *      x_0 = state0, x_t = step_fn(x_{t-1})
+ *
+ * step_fn is invoked once with a VarView of the previous state
+ * (same value type and shape as state0, which must be a scalar or vector)
+ * and must return an expression of the same shape.
+ * Parameters are usually captured by step_fn.
+ *
+ * @param   step_fn     functor creating the step expression from the previous state
+ * @param   state0      initial state (any AD expression or convertible)
+ * @param   n_steps     number of steps T
+ * @param   interval    number of steps between checkpoints (default: ceil(sqrt(T)))
+ */
+template <class StepFn
+        , class Derived
+        , class = std::enable_if_t<
+            util::is_convertible_to_ad_v<Derived> > >
+inline auto scan(StepFn&& step_fn,
+                 const Derived& state0,
+                 size_t n_steps,
+                 size_t interval = 0)
+{
+    using state_expr_t = util::convert_to_ad_t<Derived>;
+    using value_t = typename util::expr_traits<state_expr_t>::value_t;
+    using shape_t = typename util::shape_traits<state_expr_t>::shape_t;
+    using storage_t = core::ScanStorage<value_t>;
+
+    state_expr_t state0_expr = state0;
+    auto storage = std::make_shared<storage_t>(state0_expr.size(), 0);
+    VarView<value_t, shape_t> prev(storage->prev_val.data(),
+                                   storage->prev_adj.data(),
+                                   state0_expr.rows());
+    auto step = step_fn(prev);
+    using step_expr_t = util::convert_to_ad_t<decltype(step)>;
+    step_expr_t step_expr = step;
+
+    return core::ScanNode<state_expr_t, step_expr_t>(
+            state0_expr, step_expr, storage, n_steps,
+            core::scan_interval(n_steps, interval));
+}
+
+/**
+ * Creates a ScanNode with per-step inputs:
+ *
+ *      x_0 = state0, x_t = step_fn(x_{t-1}, u_t)
+ *
+ * where u_t is column t-1 of inputs (so T is the number of columns).
+ * step_fn is invoked once with a VarView of the previous state
+ * and a vector VarView of the current input.
+ * The inputs are not copied and must outlive the returned expression.
+ *
+ * @param   step_fn     functor creating the step expression from the previous state and input
+ * @param   state0      initial state (any AD expression or convertible)
+ * @param   inputs      matrix of inputs with one column per step
+ * @param   interval    number of steps between checkpoints (default: ceil(sqrt(T)))
+ */
+template <class StepFn
+        , class Derived
+        , class = std::enable_if_t<
+            util::is_convertible_to_ad_v<Derived> > >
+inline auto scan(StepFn&& step_fn,
+                 const Derived& state0,
+                 const Eigen::Matrix<
+                    typename util::expr_traits<util::convert_to_ad_t<Derived>>::value_t,
+                    Eigen::Dynamic, Eigen::Dynamic>& inputs,
+                 size_t interval = 0)
+{
+    using state_expr_t = util::convert_to_ad_t<Derived>;
+    using value_t = typename util::expr_traits<state_expr_t>::value_t;
+    using shape_t = typename util::shape_traits<state_expr_t>::shape_t;
+    using storage_t = core::ScanStorage<value_t>;
+
+    state_expr_t state0_expr = state0;
+    auto storage = std::make_shared<storage_t>(state0_expr.size(), inputs.rows());
+    VarView<value_t, shape_t> prev(storage->prev_val.data(),
+                                   storage->prev_adj.data(),
+                                   state0_expr.rows());
+    VarView<value_t, ad::vec> input(storage->in_val.data(),
+                                    storage->in_adj.data(),
+                                    inputs.rows());
+    auto step = step_fn(prev, input);
+    using step_expr_t = util::convert_to_ad_t<decltype(step)>;
+    step_expr_t step_expr = step;
+
+    size_t n_steps = inputs.cols();
+    return core::ScanNode<state_expr_t, step_expr_t>(
+            state0_expr, step_expr, storage, n_steps,
+            core::scan_interval(n_steps, interval), &inputs);
+}
+
+} // namespace ad
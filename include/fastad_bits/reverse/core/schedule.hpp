@@ -0,0 +1,219 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/fork.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/reverse/core/var_view.hpp>
+#include <fastad_bits/util/task_pool.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+
+namespace ad {
+namespace core {
+
+// Default minimum cost of both children of a node for them to be forked (see ad::schedule).
+inline constexpr size_t default_fork_threshold = 1 << 14;
+
+namespace details {
+
+template <class T, class = std::void_t<>>
+struct has_fork_slot : std::false_type {};
+template <class T>
+struct has_fork_slot<T, std::void_t<decltype(std::declval<T&>().fork_slot())> >
+    : std::true_type {};
+
+template <class T>
+struct is_eq_node : std::false_type {};
+template <class VarViewType, class ExprType>
+struct is_eq_node<EqNode<VarViewType, ExprType>> : std::true_type {};
+template <class Op, class VarViewType, class ExprType>
+struct is_eq_node<OpEqNode<Op, VarViewType, ExprType>> : std::true_type {};
+
+/**
+ * Leaves of one child of a node to be forked.
+ */
+template <class ValueType>
+struct ForkChild
+{
+    using range_t = std::pair<const ValueType*, const ValueType*>;
+
+    bool is_leaf = false;           // VarView or constant: nothing to forward evaluate
+    bool has_eq = false;            // defines placeholders
+    bool has_other_leaves = false;  // has leaves of another value type
+    std::vector<range_t> adj;       // adjoint ranges of the leaves, sorted
+
+    template <class ExprType>
+    ForkChild(ExprType& expr)
+    {
+        using expr_t = std::decay_t<ExprType>;
+        is_leaf = util::is_var_view_v<expr_t> || util::is_constant_v<expr_t>;
+        for_each_node(expr, [&](auto& node) {
+            using node_t = std::decay_t<decltype(node)>;
+            if constexpr (is_eq_node<node_t>::value) {
+                has_eq = true;
+            } else if constexpr (util::is_var_view_v<node_t>) {
+                using leaf_value_t = typename node_t::value_t;
+                if constexpr (std::is_same_v<leaf_value_t, ValueType>) {
+                    if (node.data_adj()) {
+                        adj.emplace_back(node.data_adj(),
+                                         node.data_adj() + node.size());
+                    }
+                } else {
+                    has_other_leaves = true;
+                }
+            }
+        });
+        std::sort(adj.begin(), adj.end(), [](const range_t& x, const range_t& y) {
+            return std::less<const ValueType*>()(x.first, y.first);
+        });
+    }
+
+    // checks if any adjoint range of this overlaps with that of other
+    bool shares_leaves(const ForkChild& other) const
+    {
+        std::less<const ValueType*> less;
+        auto it = adj.begin();
+        auto jt = other.adj.begin();
+        while (it != adj.end() && jt != other.adj.end()) {
+            if (less(it->first, jt->second) && less(jt->first, it->second)) return true;
+            if (less(it->second, jt->second)) ++it;
+            else ++jt;
+        }
+        return false;
+    }
+};
+
+template <class ExprType>
+inline auto make_fork_plan(ExprType& expr, util::TaskPool& pool)
+{
+    using value_t = typename util::expr_traits<std::decay_t<ExprType>>::value_t;
+    using plan_t = ForkPlan<value_t>;
+    using child_t = ForkChild<value_t>;
+
+    std::vector<child_t> children;
+    expr.for_each_child([&](auto& child) { children.emplace_back(child); });
+
+    std::unique_ptr<plan_t> plan;
+    if (children.size() != 2 || children[0].has_eq || children[1].has_eq) return plan;
+
+    plan = std::make_unique<plan_t>();
+    plan->pool = &pool;
+    plan->feval = !children[0].is_leaf && !children[1].is_leaf;
+    if (children[0].has_other_leaves || children[1].has_other_leaves) {
+        plan->beval = plan_t::Mode::serial;
+    } else if (children[0].shares_leaves(children[1])) {
+        plan->beval = plan_t::Mode::scratch;
+        // the left child is the one backward evaluated into the scratch (see ForkSlot::beval)
+        size_t i = 0;
+        expr.for_each_child([&](auto& child) {
+            if (i++ == 0) plan->scratch.resolve(child);
+        });
+    } else {
+        plan->beval = plan_t::Mode::direct;
+    }
+    if (!plan->feval && plan->beval == plan_t::Mode::serial) plan.reset();
+    return plan;
+}
+
+/**
+ * Schedules the subtree rooted at expr and returns its cost,
+ * i.e. the total number of elements of its nodes (constants excluded).
+ */
+template <class ExprType>
+inline size_t schedule_node(ExprType& expr,
+                            util::TaskPool& pool,
+                            size_t threshold,
+                            size_t& n_forks)
+{
+    using expr_t = std::decay_t<ExprType>;
+
+    size_t cost = util::is_constant_v<expr_t> ? 0 : expr.rows() * expr.cols();
+    size_t min_child_cost = threshold;
+    expr.for_each_child([&](auto& child) {
+        size_t child_cost = schedule_node(child, pool, threshold, n_forks);
+        min_child_cost = std::min(min_child_cost, child_cost);
+        cost += child_cost;
+    });
+
+    if constexpr (has_fork_slot<expr_t>::value) {
+        auto& slot = expr.fork_slot();
+        slot.reset();
+        if (min_child_cost >= threshold) {
+            slot.set(make_fork_plan(expr, pool));
+            if (slot.plan()) ++n_forks;
+        }
+    }
+    return cost;
+}
+
+} // namespace details
+} // namespace core
+
+/**
+ * Schedules the expression to evaluate independent subtrees on the threads of pool.
+ * Every BinaryNode and DotNode whose two children both cost at least threshold
+ * (cost being the total number of elements of the nodes of a subtree)
+ * evaluates its children as a fork-join on the pool:
+ *  - forward evaluation is forked if neither child is a VarView or constant.
+ *  - backward evaluation is forked as well.
+ *    If the children share leaves, the second child accumulates into a private buffer
+ *    that is added into the adjoints after the join, so results are deterministic.
+ *    If the children have leaves of another value type, backward evaluation is not forked.
+ *
+ * Nodes whose children define placeholders (EqNode, OpEqNode) are never forked.
+ * Scheduling again replaces the previous schedule.
+ * The schedule is not copied with the expression, e.g. copies or clones of an ExprBind
+ * must be scheduled again.
+ * The pool must outlive the evaluations of the expression.
+ * Children must not share copies of ScanNode or MapReduceNode,
+ * whose storage is shared among copies.
+ *
+ * @param   expr        expression to schedule (should already be bound)
+ * @param   pool        work-stealing pool to evaluate the children on
+ * @param   threshold   minimum cost of both children of a node to fork
+ * @return  number of nodes that fork
+ */
+template <class ExprType>
+inline size_t schedule(ExprType& expr,
+                       util::TaskPool& pool,
+                       size_t threshold = core::default_fork_threshold)
+{
+    size_t n_forks = 0;
+    core::details::schedule_node(expr, pool, threshold, n_forks);
+    return n_forks;
+}
+
+template <class ExprType>
+inline size_t schedule(core::ExprBind<ExprType>& expr,
+                       util::TaskPool& pool,
+                       size_t threshold = core::default_fork_threshold)
+{
+    return schedule(expr.get(), pool, threshold);
+}
+
+/**
+ * Removes the schedule of the expression so that it is evaluated serially again.
+ */
+template <class ExprType>
+inline void unschedule(ExprType& expr)
+{
+    core::for_each_node(expr, [](auto& node) {
+        using node_t = std::decay_t<decltype(node)>;
+        if constexpr (core::details::has_fork_slot<node_t>::value) {
+            node.fork_slot().reset();
+        }
+    });
+}
+
+template <class ExprType>
+inline void unschedule(core::ExprBind<ExprType>& expr)
+{
+    unschedule(expr.get());
+}
+
+} // namespace ad
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/llt_cache.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+
+namespace ad {
+namespace core {
+namespace details {
+
+struct llt_visitor_probe
+{
+    template <class S, class E>
+    void operator()(S&, E&) const {}
+};
+
+template <class T, class = std::void_t<>>
+struct has_llt_slots : std::false_type {};
+template <class T>
+struct has_llt_slots<T, std::void_t<decltype(
+    std::declval<T&>().for_each_llt(std::declval<llt_visitor_probe>()))> >
+    : std::true_type {};
+
+} // namespace details
+} // namespace core
+
+/**
+ * Shares the Cholesky factorizations of the expression among the nodes reading the same matrix,
+ * i.e. the same variable or placeholder (a non-leaf matrix is never read by two nodes,
+ * so a common matrix subexpression should be assigned to a placeholder first).
+ * These are DetNode and LogDetNode with an LLT policy,
+ * NormalAdjLogPDFNode with a covariance matrix and WishartAdjLogPDFNode.
+ * With the factorizations shared, every such matrix is factorized once per evaluation
+ * and inverted at most once per backward evaluation, no matter how many nodes read it.
+ * Constant matrices are not shared, since each node factorizes them once at construction.
+ *
+ * The expression must already be bound, since matrices are identified by their values' addresses.
+ * Sharing again replaces the previous sharing.
+ * Sharing is not copied with the expression, e.g. copies or clones of an ExprBind
+ * must be shared again.
+ *
+ * @param   expr    expression to share the factorizations of (should already be bound)
+ * @return  number of nodes (or matrix operands of a node) that reuse
+ *          the factorization of a previous one
+ */
+template <class ExprType>
+inline size_t share_factorizations(ExprType& expr)
+{
+    using key_t = std::tuple<std::type_index, const void*, size_t>;
+    std::map<key_t, std::shared_ptr<void>> caches;
+    size_t n_shared = 0;
+
+    core::for_each_node(expr, [&](auto& node) {
+        using node_t = std::decay_t<decltype(node)>;
+        if constexpr (core::details::has_llt_slots<node_t>::value) {
+            node.for_each_llt([&](auto& slot, auto& child) {
+                using slot_t = std::decay_t<decltype(slot)>;
+                using cache_t = typename slot_t::cache_t;
+                using child_t = std::decay_t<decltype(child)>;
+                if constexpr (!util::is_constant_v<child_t>) {
+                    if (slot->shared()) slot.reset();
+                    const void* data = child.get().data();
+                    if (!data) return;
+                    key_t key(std::type_index(typeid(cache_t)), data, child.rows());
+                    auto& cache = caches[key];
+                    if (!cache) {
+                        cache = slot.cache();
+                    } else {
+                        slot.share(std::static_pointer_cast<cache_t>(cache));
+                        ++n_shared;
+                    }
+                }
+            });
+        }
+    });
+    return n_shared;
+}
+
+template <class ExprType>
+inline size_t share_factorizations(core::ExprBind<ExprType>& expr)
+{
+    return share_factorizations(expr.get());
+}
+
+} // namespace ad
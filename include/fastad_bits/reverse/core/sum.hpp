@@ -1,9 +1,11 @@
 #pragma once
 #include <iterator>
+#include <fastad_bits/reverse/core/adj_scratch.hpp>
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
 #include <fastad_bits/util/size_pack.hpp>
+#include <fastad_bits/util/thread_pool.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/value.hpp>
 
@@ -56,11 +58,20 @@ public:
      */
     const var_t& feval()
     {
-        this->zero();
-        for (auto& expr : exprs_) {
-            this->get() += expr.feval();
+        FASTAD_PROFILE_FEVAL();
+        if constexpr (std::is_same_v<shape_t, ad::scl>) {
+            util::accum_t<value_t> sum(0);
+            for (auto& expr : exprs_) {
+                sum += expr.feval();
+            }
+            return this->get() = sum;
+        } else {
+            this->zero();
+            for (auto& expr : exprs_) {
+                this->get() += expr.feval();
+            }
+            return this->get();
         }
-        return this->get();
     }
 
     /** 
@@ -75,6 +86,7 @@ public:
     template <class T>
     void beval(const T& seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (exprs_.empty()) return;
         auto&& a_adj = util::to_array(this->get_adj());
         a_adj = seed;
@@ -94,7 +106,7 @@ public:
         for (auto& expr : exprs_) {
             begin = expr.bind_cache(begin);
         }
-        return value_adj_view_t::bind(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
     }
 
     util::SizePack bind_cache_size() const 
@@ -108,13 +120,204 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), this->size()}; 
+        return {this->cache_size(), this->cache_size()}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        for (auto& expr : exprs_) f(expr);
     }
 
 private:
     std::vector<vec_elem_t> exprs_;
 };
 
+/**
+ * ParSumIterNode is the multithreaded version of SumIterNode.
+ * The expressions are split into contiguous chunks (one per thread of the pool)
+ * and each chunk is evaluated by a single thread.
+ *
+ * Forward evaluation accumulates each chunk into its own partial sum,
+ * then the partial sums are added in chunk order.
+ *
+ * Backward evaluation activates a thread-private AdjScratch for each chunk
+ * so that the leaves, which are shared among the expressions,
+ * accumulate into private buffers instead of the real adjoints.
+ * The scratches are then reduced into the real adjoints in chunk order.
+ * Hence, for a fixed pool size, the results are deterministic.
+ *
+ * Every expression is bound to its own cache region, so the only shared state are the leaves.
+ * Placeholders (EqNode, OpEqNode) must not be used inside the expressions
+ * since they read back the adjoint of the user variable during backward evaluation.
+ *
+ * If the node is itself evaluated inside a parallel region,
+ * it falls back to the serial evaluation of SumIterNode.
+ *
+ * @tparam  VecType     type of vector of expressions to sum over 
+ */
+
+template <class VecType>
+struct ParSumIterNode:
+    ValueAdjView<typename util::expr_traits< 
+                    typename VecType::value_type >::value_t,
+                 typename util::shape_traits< 
+                    typename VecType::value_type >::shape_t >,
+    ExprBase<ParSumIterNode<VecType>>
+{
+private:
+    using vec_elem_t = typename VecType::value_type;
+    using elem_value_t = typename util::expr_traits<vec_elem_t>::value_t;
+    using elem_shape_t = typename util::shape_traits<vec_elem_t>::shape_t;
+    
+public:
+    using value_adj_view_t = ValueAdjView<elem_value_t, elem_shape_t>;
+    using typename value_adj_view_t::value_t;
+    using typename value_adj_view_t::shape_t;
+    using typename value_adj_view_t::var_t;
+    using typename value_adj_view_t::ptr_pack_t;
+    // scalar partial sums accumulate in the accumulation type (see util::accum_t)
+    using partial_t = util::constant_var_t<
+        std::conditional_t<std::is_same_v<shape_t, ad::scl>,
+                           util::accum_t<value_t>, value_t>,
+        shape_t>;
+    using scratch_t = AdjScratch<value_t>;
+
+    ParSumIterNode(const VecType& exprs, util::ThreadPool& pool)
+        : value_adj_view_t(nullptr, nullptr,
+                       (exprs.size() == 0) ? 0 : exprs[0].rows(),
+                       (exprs.size() == 0) ? 0 : exprs[0].cols())
+        , exprs_{exprs}
+        , pool_{&pool}
+        , n_chunks_{std::max<size_t>(1, std::min(exprs.size(), pool.size()))}
+        , scratch_(n_chunks_)
+    {
+        partials_.reserve(n_chunks_);
+        for (size_t i = 0; i < n_chunks_; ++i) {
+            if constexpr (std::is_same_v<shape_t, ad::scl>) {
+                partials_.emplace_back(0);
+            } else {
+                partials_.emplace_back(this->rows(), this->cols());
+            }
+        }
+    }
+
+    /** 
+     * Forward evaluate every chunk in parallel into its own partial sum,
+     * then accumulate the partial sums in chunk order.
+     *
+     * @return forward evaluation of sum of functor on every expr.
+     */
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        pool_->parallel_for(n_chunks_, [&](size_t c) {
+            auto range = util::chunk_range(exprs_.size(), n_chunks_, c);
+            auto& partial = partials_[c];
+            if constexpr (std::is_same_v<shape_t, ad::scl>) partial = 0;
+            else partial.setZero();
+            for (size_t i = range.first; i < range.second; ++i) {
+                partial += exprs_[i].feval();
+            }
+        });
+        if constexpr (std::is_same_v<shape_t, ad::scl>) {
+            partial_t sum(0);
+            for (const auto& partial : partials_) {
+                sum += partial;
+            }
+            return this->get() = sum;
+        } else {
+            this->zero();
+            for (const auto& partial : partials_) {
+                this->get() += partial;
+            }
+            return this->get();
+        }
+    }
+
+    /** 
+     * Backward evaluate every chunk in parallel with the same seed.
+     * Like SumIterNode, the seed is first evaluated into the current adjoint.
+     */
+    template <class T>
+    void beval(const T& seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        if (exprs_.empty()) return;
+        auto&& a_adj = util::to_array(this->get_adj());
+        a_adj = seed;
+
+        // nested parallel region: leaves already accumulate into the outer scratch
+        if (scratch_t::active()) {
+            std::for_each(exprs_.rbegin(), exprs_.rend(),
+                [&](auto& expr) {
+                    expr.beval(a_adj);
+                });
+            return;
+        }
+
+        pool_->parallel_for(n_chunks_, [&](size_t c) {
+            typename scratch_t::Guard guard(scratch_[c]);
+            auto range = util::chunk_range(exprs_.size(), n_chunks_, c);
+            for (size_t i = range.second; i > range.first; --i) {
+                exprs_[i-1].beval(a_adj);
+            }
+        });
+
+        for (auto& scratch : scratch_) {
+            scratch.reduce();
+        }
+    }
+
+    /**
+     * Bind every expression from left to right then bind itself.
+     * The leaves of every chunk are resolved in the scratch of the chunk.
+     *
+     * @return  the next pointer not bound by any of the expressions and itself.
+     */
+    ptr_pack_t bind_cache(ptr_pack_t begin)
+    {
+        for (auto& expr : exprs_) {
+            begin = expr.bind_cache(begin);
+        }
+        for (size_t c = 0; c < n_chunks_; ++c) {
+            auto range = util::chunk_range(exprs_.size(), n_chunks_, c);
+            scratch_[c].clear();
+            for (size_t i = range.first; i < range.second; ++i) {
+                scratch_[c].resolve(exprs_[i]);
+            }
+        }
+        return value_adj_view_t::bind_cache_slot(begin);
+    }
+
+    util::SizePack bind_cache_size() const 
+    { 
+        util::SizePack out = util::SizePack::Zero();
+        for (const auto& expr : exprs_) {
+            out += expr.bind_cache_size();
+        }
+        return out + single_bind_cache_size();
+    }
+
+    util::SizePack single_bind_cache_size() const
+    { 
+        return {this->cache_size(), this->cache_size()}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        for (auto& expr : exprs_) f(expr);
+    }
+
+private:
+    std::vector<vec_elem_t> exprs_;
+    util::ThreadPool* pool_;
+    size_t n_chunks_;
+    std::vector<partial_t> partials_;
+    std::vector<scratch_t> scratch_;
+};
+
 /** 
  * SumElemNode represents a summation of all elements of an expression.
  * Ex. \sum_{i,j=1}^{m,n} e_{ij}
@@ -155,11 +358,12 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& res = expr_.feval();
         if constexpr (util::is_scl_v<expr_t>) {
             return this->get() = res;
         } else {
-            return this->get() = res.sum();
+            return this->get() = util::accum_sum(res);
         }
     }
 
@@ -169,6 +373,7 @@ public:
      */
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         expr_.beval(seed);
     }
 
@@ -182,7 +387,7 @@ public:
         begin = expr_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -195,7 +400,13 @@ public:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
     }
 
 private:
@@ -240,6 +451,31 @@ inline auto sum(Iter begin, Iter end, Lmda&& f)
     }
 }
 
+/**
+ * Helper function to create a ParSumIterNode, 
+ * which evaluates the expressions f(x) in parallel using the given thread pool.
+ * The pool must outlive the returned expression.
+ * If the expressions are constant, the constant optimization of
+ * the serial version is used since there is nothing to parallelize.
+ */
+template <class Iter, class Lmda>
+inline auto sum(util::ThreadPool& pool, Iter begin, Iter end, Lmda&& f)
+{
+    using expr_t = std::decay_t<decltype(f(*begin))>;
+
+    if constexpr (util::is_constant_v<expr_t>) {
+        return ad::sum(begin, end, std::forward<Lmda>(f));
+    } else {
+        std::vector<expr_t> exprs;
+        exprs.reserve(std::distance(begin, end));
+        std::for_each(begin, end, 
+                [&](const auto& x) {
+                    exprs.emplace_back(f(x));
+                });
+        return core::ParSumIterNode<std::vector<expr_t>>(exprs, pool);
+    }
+}
+
 template <class Derived
         , class = std::enable_if_t<
             util::is_convertible_to_ad_v<Derived> &&
@@ -34,11 +34,13 @@ struct TransposeNode : ValueAdjView<typename util::expr_traits<ExprType>::value_
         : value_adj_view_t(nullptr, nullptr, expr.cols(), expr.rows()), expr_{expr} {}
 
     const var_t &feval() {
+        FASTAD_PROFILE_FEVAL();
         auto &&res = expr_.feval();
         return this->get() = res.transpose();
     }
 
     template <class T> void beval(const T &seed) {
+        FASTAD_PROFILE_BEVAL();
         util::to_array(this->get_adj()) = seed;
         auto adj = util::to_array(this->get_adj().transpose());
         expr_.beval(adj);
@@ -46,14 +48,16 @@ struct TransposeNode : ValueAdjView<typename util::expr_traits<ExprType>::value_
 
     ptr_pack_t bind_cache(ptr_pack_t begin) {
         begin = expr_.bind_cache(begin);
-        return value_adj_view_t::bind(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
     };
 
     util::SizePack bind_cache_size() const {
         return expr_.bind_cache_size() + single_bind_cache_size();
     };
 
-    util::SizePack single_bind_cache_size() const { return {this->size(), this->size()}; }
+    util::SizePack single_bind_cache_size() const { return {this->cache_size(), this->cache_size()}; }
+
+    template <class F> void for_each_child(F &&f) { f(expr_); }
 
   private:
     expr_t expr_;
@@ -0,0 +1,58 @@
+#pragma once
+#include <type_traits>
+#include <fastad_bits/reverse/core/expr_base.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+
+namespace ad {
+namespace core {
+
+/**
+ * Applies f to every node of the expression tree in pre-order,
+ * i.e. a node is visited before its children, and children are visited left to right.
+ * A node that appears multiple times in the tree (e.g. a VarView used twice)
+ * is visited once per appearance.
+ *
+ * @param   expr    root of the expression to traverse
+ * @param   f       functor called on every node as f(node)
+ */
+template <class ExprType, class F>
+inline void for_each_node(ExprType& expr, F&& f)
+{
+    f(expr);
+    expr.for_each_child([&](auto& child) {
+        for_each_node(child, f);
+    });
+}
+
+/**
+ * Applies f to every VarView of the expression tree in pre-order.
+ * This includes the leaves as well as the placeholders of EqNode and OpEqNode,
+ * i.e. every view that accumulates adjoints from outside of the expression cache.
+ *
+ * @param   expr    root of the expression to traverse
+ * @param   f       functor called on every VarView as f(var_view)
+ */
+template <class ExprType, class F>
+inline void for_each_leaf(ExprType& expr, F&& f)
+{
+    for_each_node(expr, [&](auto& node) {
+        using node_t = std::decay_t<decltype(node)>;
+        if constexpr (util::is_var_view_v<node_t>) {
+            f(node);
+        }
+    });
+}
+
+/**
+ * Zeroes the adjoints of every VarView of the expression tree.
+ * Since VarViews view the adjoint of the variables,
+ * this resets the adjoints of the variables and placeholders themselves.
+ */
+template <class ExprType>
+inline void zero_leaf_adj(ExprType& expr)
+{
+    for_each_leaf(expr, [](auto& leaf) { leaf.zero_adj(); });
+}
+
+} // namespace core
+} // namespace ad
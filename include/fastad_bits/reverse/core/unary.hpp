@@ -3,6 +3,7 @@
 #include <unsupported/Eigen/SpecialFunctions>       // needed for erf
 #include <fastad_bits/forward/core/forward.hpp>    
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/fuse.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/shape_traits.hpp>
@@ -62,8 +63,11 @@ public:
      */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& a_expr = util::to_array(expr_.feval());
-        util::to_array(this->get()) = Unary::fmap(a_expr);
+        this->visit_aligned([&](auto&& val) {
+            util::to_array(val) = Unary::fmap(a_expr);
+        });
         return this->get();
     }
 
@@ -81,11 +85,14 @@ public:
     template <class T>
     void beval(const T& seed)
     {
-        auto&& a_val = util::to_array(this->get());
-        auto&& a_adj = util::to_array(this->get_adj());
-        auto&& a_expr = util::to_array(expr_.get());
-        a_adj = seed;
-        expr_.beval(Unary::bmap(a_adj, a_expr, a_val));
+        FASTAD_PROFILE_BEVAL();
+        this->visit_aligned_adj([&](auto&& val, auto&& adj) {
+            auto&& a_val = util::to_array(val);
+            auto&& a_adj = util::to_array(adj);
+            auto&& a_expr = util::to_array(expr_.get());
+            a_adj = seed;
+            expr_.beval(Unary::bmap(a_adj, a_expr, a_val));
+        });
     }
 
     /**
@@ -95,7 +102,7 @@ public:
     ptr_pack_t bind_cache(ptr_pack_t begin)
     { 
         begin = expr_.bind_cache(begin);
-        return value_adj_view_t::bind(begin);
+        return value_adj_view_t::bind_cache_slot(begin);
     }
 
     /**
@@ -112,7 +119,53 @@ public:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), this->size()};
+        return {this->cache_size(), this->cache_size()};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(expr_);
+    }
+
+    /**
+     * Fused evaluation inside of a FuseNode (see fuse.hpp).
+     * The node never caches its own values or adjoints in this mode.
+     */
+    static constexpr size_t fused_depth = 1 + details::fused_depth<expr_t>();
+
+    void fused_feval()
+    {
+        details::fused_feval(expr_);
+    }
+
+    auto fused_get()
+    {
+        return Unary::fmap(details::fused_get(expr_));
+    }
+
+    template <class T, class F>
+    void fused_beval(const T& seed, const F& f)
+    {
+        auto&& a_expr = details::fused_get(expr_);
+        details::fused_beval(expr_, Unary::bmap(seed, a_expr, f), a_expr);
+    }
+
+    ptr_pack_t fused_bind_cache(ptr_pack_t begin)
+    {
+        return details::fused_bind_cache(expr_, begin);
+    }
+
+    util::SizePack fused_bind_cache_size() const
+    {
+        return details::fused_bind_cache_size(expr_);
+    }
+
+    template <class G>
+    auto fused_transform(G&& g) const
+    {
+        using child_t = std::decay_t<decltype(g(expr_))>;
+        return UnaryNode<Unary, child_t>(g(expr_));
     }
 
 private:
@@ -274,25 +327,27 @@ UNARY_STRUCT(Sigmoid,
              USING_STD_AD_EIGEN(exp);
              return 1/(1+exp(-x));, 
              static_cast<void>(x); 
-             return seed * exp(-x)/((exp(-x)+1)*(exp(-x)+1)););
+             return seed * f * (1 - f););
 
 // sinh
 UNARY_STRUCT(Sinh, 
-             //USING_STD_AD_EIGEN(tanh);
-             return Eigen::sinh(x);, 
+             USING_STD_AD_EIGEN(sinh);
+             return sinh(x);, 
              static_cast<void>(f); 
-             return seed *(Eigen::cosh(x)););
+             USING_STD_AD_EIGEN(cosh);
+             return seed * cosh(x););
 // cosh
 UNARY_STRUCT(Cosh, 
-             //USING_STD_AD_EIGEN(tanh);
-             return Eigen::cosh(x);, 
+             USING_STD_AD_EIGEN(cosh);
+             return cosh(x);, 
              static_cast<void>(f); 
-             return seed *(Eigen::sinh(x)););			 
+             USING_STD_AD_EIGEN(sinh);
+             return seed * sinh(x););
 // tanh
 UNARY_STRUCT(Tanh, 
-             //USING_STD_AD_EIGEN(tanh);
-             return Eigen::tanh(x);, 
-             static_cast<void>(f); 
+             USING_STD_AD_EIGEN(tanh);
+             return tanh(x);, 
+             static_cast<void>(x); 
              return seed *(1-f*f););
 			 
 // operator- (IMPORTANT TO DECLARE IN core)
@@ -1,5 +1,6 @@
 #pragma once
 #include <fastad_bits/reverse/core/value_view.hpp>
+#include <fastad_bits/util/align.hpp>
 #include <fastad_bits/util/ptr_pack.hpp>
 
 namespace ad {
@@ -30,6 +31,7 @@ struct ValueAdjView
     using typename base_t::shape_t;
     using typename base_t::var_t;
     using ptr_pack_t = util::PtrPack<value_t>;
+    using aligned_var_t = util::shape_to_aligned_view_t<value_t, shape_t>;
 
     ValueAdjView(value_t* val, 
                  value_t* adj,
@@ -51,6 +53,70 @@ struct ValueAdjView
         return begin;
     }
 
+    /**
+     * Binds to a new slot of an expression cache.
+     * Unlike bind, the value and adjoint pointers are first rounded up
+     * to the cache alignment (see FASTAD_CACHE_ALIGN) if the slot is a vector or matrix.
+     * Nodes must reserve cache_size() elements for such a slot.
+     *
+     * @return  next pointers after the slot including any padding
+     */
+    ptr_pack_t bind_cache_slot(ptr_pack_t begin)
+    {
+        bind({util::align_cache_ptr<value_t, shape_t>(begin.val),
+              util::align_cache_ptr<value_t, shape_t>(begin.adj)});
+        begin.val += cache_size();
+        begin.adj += cache_size();
+        return begin;
+    }
+
+    /**
+     * Returns the number of elements needed by bind_cache_slot,
+     * i.e. the size including the padding for alignment.
+     */
+    size_t cache_size() const
+    {
+        return util::cache_slot_size<value_t, shape_t>(this->size());
+    }
+
+    /**
+     * Calls f with a viewer of the values.
+     * If the values are at a cache alignment boundary, it is an aligned Eigen::Map
+     * so that Eigen can use aligned SIMD loads and stores.
+     * Otherwise, e.g. if the view was rebound to a placeholder, it is get().
+     */
+    template <class F>
+    void visit_aligned(F&& f)
+    {
+        if constexpr (util::is_cache_aligned_map_v<value_t, shape_t>) {
+            if (util::is_cache_aligned_ptr(this->data())) {
+                aligned_var_t val(this->data(), this->rows(), this->cols());
+                f(val);
+                return;
+            }
+        }
+        f(this->get());
+    }
+
+    /**
+     * Same as visit_aligned, but calls f with viewers of both the values and adjoints.
+     * Adjoints must be bound.
+     */
+    template <class F>
+    void visit_aligned_adj(F&& f)
+    {
+        if constexpr (util::is_cache_aligned_map_v<value_t, shape_t>) {
+            if (util::is_cache_aligned_ptr(this->data()) &&
+                util::is_cache_aligned_ptr(this->data_adj())) {
+                aligned_var_t val(this->data(), this->rows(), this->cols());
+                aligned_var_t adj(this->data_adj(), this->rows(), this->cols());
+                f(val, adj);
+                return;
+            }
+        }
+        f(this->get(), this->get_adj());
+    }
+
     value_t* data_adj() { return adj_view_.data(); }
     const value_t* data_adj() const { return adj_view_.data(); }
     void zero_adj() { adj_view_.zero(); }
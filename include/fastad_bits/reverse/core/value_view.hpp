@@ -172,5 +172,85 @@ private:
     var_t val_;
 };
 
+/*
+ * Fixed-size shapes view the values through a fixed-size Eigen::Map.
+ * The sizes passed at construction are only checked against the compile-time sizes.
+ */
+template <class ValueType, int Rows>
+struct ValueView<ValueType, fixed_vec<Rows>>
+{
+    using value_t = ValueType;
+    using shape_t = fixed_vec<Rows>;
+    using var_t = util::shape_to_raw_view_t<value_t, shape_t>;
+
+    ValueView(value_t* begin, size_t rows=Rows, size_t=1)
+        : val_(begin)
+    {
+        static_cast<void>(rows);
+        assert(rows == static_cast<size_t>(Rows));
+    }
+     
+    var_t& get() { return val_; }
+    const var_t& get() const { return val_; }
+    value_t& get(size_t i, size_t) { return val_(i); }
+    const value_t& get(size_t i, size_t) const { return val_(i); }
+
+    value_t* bind(value_t* begin)
+    { 
+        new (&val_) var_t(begin);
+        return begin + this->size(); 
+    }
+
+    constexpr size_t size() const { return Rows; }
+    constexpr size_t rows() const { return Rows; }
+    constexpr size_t cols() const { return 1; }
+    value_t* data() { return val_.data(); }
+    const value_t* data() const { return val_.data(); }
+    void zero() { val_.setZero(); }
+    void ones() { val_.setOnes(); }
+
+private:
+    var_t val_;
+};
+
+template <class ValueType, int Rows, int Cols>
+struct ValueView<ValueType, fixed_mat<Rows, Cols>>
+{
+    using value_t = ValueType;
+    using shape_t = fixed_mat<Rows, Cols>;
+    using var_t = util::shape_to_raw_view_t<value_t, shape_t>;
+
+    ValueView(value_t* begin, size_t rows=Rows, size_t cols=Cols)
+        : val_(begin)
+    {
+        static_cast<void>(rows);
+        static_cast<void>(cols);
+        assert(rows == static_cast<size_t>(Rows));
+        assert(cols == static_cast<size_t>(Cols));
+    }
+     
+    var_t& get() { return val_; }
+    const var_t& get() const { return val_; }
+    value_t& get(size_t i, size_t j) { return val_(i,j); }
+    const value_t& get(size_t i, size_t j) const { return val_(i,j); }
+
+    value_t* bind(value_t* begin)
+    { 
+        new (&val_) var_t(begin);
+        return begin + this->size(); 
+    }
+
+    constexpr size_t size() const { return Rows * Cols; }
+    constexpr size_t rows() const { return Rows; }
+    constexpr size_t cols() const { return Cols; }
+    value_t* data() { return val_.data(); }
+    const value_t* data() const { return val_.data(); }
+    void zero() { val_.setZero(); }
+    void ones() { val_.setOnes(); }
+
+private:
+    var_t val_;
+};
+
 } // namespace core
 } // namespace ad
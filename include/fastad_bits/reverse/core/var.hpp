@@ -8,11 +8,12 @@ namespace ad {
  * Var objects are VarView, since they view themselves.
  * Var objects own the variable value(s) and partial derivative(s), or adjoint(s).
  *
- * ShapeType must be one of scl, vec, or mat.
+ * ShapeType must be one of scl, vec, mat, or a fixed-size shape fixed_vec<N>, fixed_mat<R, C>.
  * All other specializations are disabled (see VarView).
  *
  * @tparam ValueType    underlying data type
- * @tparam ShapeType    shape of variable (one of scl, vec, mat, selfadjmat).
+ * @tparam ShapeType    shape of variable (one of scl, vec, mat, selfadjmat,
+ *                      fixed_vec<N>, fixed_mat<R, C>).
  *                      Default is scl.
  */
 
@@ -219,8 +220,137 @@ private:
     mat_t adj_;
 };
 
+/*
+ * Fixed-size variables own fixed-size Eigen matrices,
+ * so they are default-constructible and never allocate.
+ */
+template <class ValueType, int Rows>
+struct Var<ValueType, fixed_vec<Rows>>:
+    VarView<ValueType, fixed_vec<Rows>>
+{
+private:
+    using base_t = VarView<ValueType, fixed_vec<Rows>>;
+    using vec_t = Eigen::Matrix<
+        typename base_t::value_t, Rows, 1>;
+
+public:
+    using typename base_t::value_t;
+    using typename base_t::shape_t;
+    using typename base_t::var_t;
+    using base_t::operator=;
+
+    Var()
+        : base_t(nullptr, nullptr) 
+        , val_(vec_t::Zero())
+        , adj_(vec_t::Zero())
+    { rebind(); }
+
+    Var(const Var& v)
+        : base_t(v)
+        , val_(v.val_)
+        , adj_(v.adj_)
+    { rebind(); }
+
+    Var(Var&& v)
+        : base_t(std::move(v))
+        , val_(std::move(v.val_))
+        , adj_(std::move(v.adj_))
+    { rebind(); }
+
+    Var& operator=(const Var& v)
+    {
+        if (this == &v) return *this;
+        val_ = v.val_;
+        adj_ = v.adj_;
+        rebind();
+        return *this;
+    }
+
+    Var& operator=(Var&& v) 
+    {
+        if (this == &v) return *this;
+        val_ = std::move(v.val_);
+        adj_ = std::move(v.adj_);
+        rebind();
+        return *this;
+    }
+
+private:
+    void rebind() 
+    {
+        this->bind({val_.data(), adj_.data()});
+    }
+
+    vec_t val_;
+    vec_t adj_;
+};
+
+template <class ValueType, int Rows, int Cols>
+struct Var<ValueType, fixed_mat<Rows, Cols>>:
+    VarView<ValueType, fixed_mat<Rows, Cols>>
+{
+private:
+    using base_t = VarView<ValueType, fixed_mat<Rows, Cols>>;
+    using mat_t = Eigen::Matrix<
+        typename base_t::value_t, Rows, Cols>;
+
+public:
+    using typename base_t::value_t;
+    using typename base_t::shape_t;
+    using typename base_t::var_t;
+    using base_t::operator=;
+
+    Var()
+        : base_t(nullptr, nullptr) 
+        , val_(mat_t::Zero())
+        , adj_(mat_t::Zero())
+    { rebind(); }
+
+    Var(const Var& v)
+        : base_t(v)
+        , val_(v.val_)
+        , adj_(v.adj_)
+    { rebind(); }
+
+    Var(Var&& v)
+        : base_t(std::move(v))
+        , val_(std::move(v.val_))
+        , adj_(std::move(v.adj_))
+    { rebind(); }
+
+    Var& operator=(const Var& v)
+    {
+        if (this == &v) return *this;
+        val_ = v.val_;
+        adj_ = v.adj_;
+        rebind();
+        return *this;
+    }
+
+    Var& operator=(Var&& v) 
+    {
+        if (this == &v) return *this;
+        val_ = std::move(v.val_);
+        adj_ = std::move(v.adj_);
+        rebind();
+        return *this;
+    }
+
+private:
+    void rebind() 
+    {
+        this->bind({val_.data(), adj_.data()});
+    }
+
+    mat_t val_;
+    mat_t adj_;
+};
+
 template struct Var<double, scl>;
 template struct Var<double, vec>;
 template struct Var<double, mat>;
+template struct Var<float, scl>;
+template struct Var<float, vec>;
+template struct Var<float, mat>;
 
 } // namespace ad
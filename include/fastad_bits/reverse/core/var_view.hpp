@@ -1,4 +1,5 @@
 #pragma once
+#include <fastad_bits/reverse/core/adj_scratch.hpp>
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/util/shape_traits.hpp>
 #include <fastad_bits/util/type_traits.hpp>
@@ -87,12 +88,42 @@ struct VarViewBase<VarView<ValueType, ShapeType>>:
      *
      * Keep it templated since seed can be scalar or Eigen type regardless of current var view shape.
      * Helper to_array function converts them properly to make the operation make sense in all cases.
+     *
+     * If an adjoint scratch is active on the current thread (parallel backward evaluation),
+     * the seed is accumulated into the thread-private slot for this adjoint instead.
      */
     template <class T>
-    void beval(const T& seed) { 
-        util::to_array(this->get_adj()) += seed; 
+    void beval(const T& seed) {
+        visit_beval_adj([&](auto&& adj) {
+            util::to_array(adj) += seed;
+        });
+    }
+
+    /**
+     * Calls f with a writeable view of the adjoints that beval accumulates into,
+     * i.e. the thread-private slot if an adjoint scratch is active.
+     * A parent node may use this to accumulate its seed in-place (e.g. a product with noalias)
+     * rather than materializing the seed and calling beval.
+     */
+    template <class F>
+    void visit_beval_adj(F&& f) {
+        auto* scratch = AdjScratch<value_t>::active();
+        if (scratch) {
+            ValueView<value_t, shape_t> slot(
+                    scratch->get(this->data_adj(), this->size(), scratch_slot_),
+                    this->rows(), this->cols());
+            f(slot.get());
+            return;
+        }
+        f(this->get_adj());
     }
 
+    /**
+     * Records the index of the slot of this view in the adjoint scratch
+     * of the enclosing parallel node (see AdjScratch::resolve).
+     */
+    void set_scratch_slot(size_t slot) { scratch_slot_ = slot; }
+
     /**
      * Cache bind size is 0 since it will never get rebound once an expression is constructed.
      */
@@ -100,6 +131,13 @@ struct VarViewBase<VarView<ValueType, ShapeType>>:
     constexpr T bind_cache(T begin) { return begin; }
     util::SizePack bind_cache_size() const { return {0,0}; }
     util::SizePack single_bind_cache_size() const { return {0,0}; }
+
+    // views are leaves
+    template <class F>
+    void for_each_child(F&&) {}
+
+private:
+    size_t scratch_slot_ = AdjScratch<value_t>::npos;
 };
 
 } // namespace core
@@ -109,11 +147,11 @@ struct VarViewBase<VarView<ValueType, ShapeType>>:
  * VarView objects are precisely the leaves of the computation tree.
  * VarView objects view the variable value(s) and partial derivative(s), or adjoint(s).
  *
- * ShapeType must be one of scl, vec, or mat.
+ * ShapeType must be one of scl, vec, mat, or a fixed-size shape fixed_vec<N>, fixed_mat<R, C>.
  * All other specializations are disabled.
  *
  * @tparam ValueType    underlying data type
- * @tparam ShapeType    shape of variable (one of scl, vec, mat).
+ * @tparam ShapeType    shape of variable (one of scl, vec, mat, fixed_vec<N>, fixed_mat<R, C>).
  *                      Default is scl.
  */
 
@@ -188,10 +226,66 @@ struct VarView<ValueType, mat>:
     {}
 };
 
+template <class ValueType, int Rows>
+struct VarView<ValueType, fixed_vec<Rows>>: 
+    core::VarViewBase<VarView<ValueType, fixed_vec<Rows>>>
+{
+    using base_t = core::VarViewBase<VarView<ValueType, fixed_vec<Rows>>>;
+    using typename base_t::value_t;
+    using base_t::operator=;
+
+    VarView(value_t* val,
+            value_t* adj,
+            size_t rows = Rows,
+            size_t = 1)
+        : base_t(val, adj, rows, 1)
+    {}
+
+    // subviews
+    auto operator()(size_t i) {
+        assert(i < base_t::size());
+        return VarView<value_t, scl>(base_t::data() + i, 
+                                     base_t::data_adj() + i);
+    }
+    auto operator[](size_t i) {
+        return operator()(i);
+    }
+    auto head(size_t n) {
+        assert(n <= base_t::size());
+        return VarView<value_t, vec>(base_t::data(), base_t::data_adj(), n);
+    }
+    auto tail(size_t n) {
+        assert(n <= base_t::size());
+        size_t offset = base_t::size() - n;
+        return VarView<value_t, vec>(base_t::data() + offset, 
+                                     base_t::data_adj() + offset,
+                                     n);
+    }
+};
+
+template <class ValueType, int Rows, int Cols>
+struct VarView<ValueType, fixed_mat<Rows, Cols>>: 
+    core::VarViewBase<VarView<ValueType, fixed_mat<Rows, Cols>>>
+{
+    using base_t = core::VarViewBase<VarView<ValueType, fixed_mat<Rows, Cols>>>;
+    using typename base_t::value_t;
+    using base_t::operator=;
+
+    VarView(value_t* val,
+            value_t* adj,
+            size_t rows = Rows,
+            size_t cols = Cols)
+        : base_t(val, adj, rows, cols)
+    {}
+};
+
 // Explicit template instantiation to help compile-time
 template struct VarView<double, scl>;
 template struct VarView<double, vec>;
 template struct VarView<double, mat>;
+template struct VarView<float, scl>;
+template struct VarView<float, vec>;
+template struct VarView<float, mat>;
 
 /*
  * Useful operator overloads
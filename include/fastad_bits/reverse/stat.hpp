@@ -3,5 +3,6 @@
 #include "stat/bernoulli.hpp"
 #include "stat/cauchy.hpp"
 #include "stat/normal.hpp"
+#include "stat/normal_cholesky.hpp"
 #include "stat/uniform.hpp"
 #include "stat/wishart.hpp"
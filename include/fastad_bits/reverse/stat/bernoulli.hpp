@@ -39,7 +39,7 @@ struct BernoulliBase:
         begin = p_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -53,7 +53,14 @@ struct BernoulliBase:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(x_);
+        f(p_);
     }
 
 protected:
@@ -87,8 +94,8 @@ protected:
 template <class XExprType
         , class PExprType
         , class = std::tuple<
-            typename util::shape_traits<XExprType>::shape_t,
-            typename util::shape_traits<PExprType>::shape_t> >
+            util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<PExprType>::shape_t>> >
 struct BernoulliAdjLogPDFNode;
 
 // Case 1: ss
@@ -109,6 +116,7 @@ public:
     using typename base_t::p_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::p_;
 
@@ -125,6 +133,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         p_.feval();
 
@@ -152,6 +161,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range() || (x_.get() != 0 && x_.get() != 1)) return;
 
         auto adj = (x_.get() == 0) ? -seed / (1-p_.get()) : seed / p_.get();
@@ -193,6 +203,7 @@ public:
     using typename base_t::p_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::p_;
 
@@ -214,6 +225,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         p_.feval();
 
@@ -245,6 +257,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range() || !is_x_zero_one_) return;
 
         value_t adj = (x_sum_ - (x_.size() * p_.get())) /
@@ -295,6 +308,7 @@ public:
     using typename base_t::p_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::p_;
 
@@ -314,6 +328,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& p = p_.feval().array();
 
@@ -326,21 +341,21 @@ public:
 
         if (is_x_zero_one_) {
             if (!is_p_within_range_) {
-                this->get() = 0;
+                util::accum_t<value_t> sum = 0;
                 for (size_t i = 0; i < p_.size(); ++i) {
                     if (p(i) <= 0 && x(i) != 0) {
                         return this->get() = util::neg_inf<value_t>;
                     } else if (p(i) >= 1 && x(i) != 1){
                         return this->get() = util::neg_inf<value_t>;
                     } else if (0 < p(i) && p(i) < 1){
-                        this->get() += (x(i) == 1) ? 
+                        sum += (x(i) == 1) ? 
                             std::log(p(i)) : std::log(1-p(i));
                     }
                 }
-                return this->get();
+                return this->get() = sum;
             }
-            return this->get() = (x.template cast<value_t>()*p + 
-                                  (1-x.template cast<value_t>())*(1-p)).log().sum();
+            return this->get() = util::accum_sum((x.template cast<value_t>()*p + 
+                                  (1-x.template cast<value_t>())*(1-p)).log());
         } else {
             return this->get() = util::neg_inf<value_t>;
         }
@@ -348,6 +363,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !is_x_zero_one_) return;
 
         auto&& x = x_.get().array();
@@ -47,7 +47,7 @@ struct CauchyBase:
         begin = scale_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -62,7 +62,15 @@ struct CauchyBase:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(x_);
+        f(loc_);
+        f(scale_);
     }
 
 protected:
@@ -94,9 +102,9 @@ template <class XExprType
         , class LocExprType
         , class ScaleExprType
         , class = std::tuple<
-            typename util::shape_traits<XExprType>::shape_t,
-            typename util::shape_traits<LocExprType>::shape_t,
-            typename util::shape_traits<ScaleExprType>::shape_t> >
+            util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<LocExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<ScaleExprType>::shape_t>> >
 struct CauchyAdjLogPDFNode;
 
 // Case 1: sss
@@ -120,6 +128,7 @@ public:
     using typename base_t::scale_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::loc_;
     using base_t::scale_;
@@ -133,6 +142,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval();
         auto&& x0 = loc_.feval();
         auto&& gamma = scale_.feval();
@@ -148,6 +158,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& x = x_.get();
@@ -193,6 +204,7 @@ public:
     using typename base_t::scale_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::loc_;
     using base_t::scale_;
@@ -205,6 +217,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval();
         auto&& x0 = loc_.feval();
         auto&& gamma = scale_.feval();
@@ -214,11 +227,12 @@ public:
         }
 
         auto diff_sq = (x.array() - x0).square();
-        return this->get() = -(gamma + (1./gamma) * diff_sq).log().sum();
+        return this->get() = -util::accum_sum((gamma + (1./gamma) * diff_sq).log());
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& x = x_.get().array();
@@ -263,6 +277,7 @@ public:
     using typename base_t::scale_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::loc_;
     using base_t::scale_;
@@ -275,6 +290,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& x0 = loc_.feval();
         auto&& gamma = scale_.feval().array();
@@ -284,11 +300,12 @@ public:
         }
         
         auto diff = x - x0;
-        return this->get() = -(gamma + (diff.square() / gamma)).log().sum();
+        return this->get() = -util::accum_sum((gamma + (diff.square() / gamma)).log());
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& x = x_.get().array();
@@ -332,6 +349,7 @@ public:
     using typename base_t::scale_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::loc_;
     using base_t::scale_;
@@ -344,6 +362,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& x0 = loc_.feval().array();
         auto&& gamma = scale_.feval();
@@ -353,11 +372,12 @@ public:
         }
 
         auto diff = x - x0;
-        return this->get() = -(gamma + (1./gamma) * diff.square()).log().sum();
+        return this->get() = -util::accum_sum((gamma + (1./gamma) * diff.square()).log());
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& x = x_.get().array();
@@ -402,6 +422,7 @@ public:
     using typename base_t::scale_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::loc_;
     using base_t::scale_;
@@ -414,6 +435,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& x0 = loc_.feval().array();
         auto&& gamma = scale_.feval().array();
@@ -423,11 +445,12 @@ public:
         }
 
         auto diff = x - x0;
-        return this->get() = -(gamma + (diff.square()/gamma)).log().sum();
+        return this->get() = -util::accum_sum((gamma + (diff.square()/gamma)).log());
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& x = x_.get().array();
@@ -3,8 +3,11 @@
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/llt_cache.hpp>
+#include <fastad_bits/util/intra_op.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/numeric.hpp>
+#include <fastad_bits/util/value.hpp>
 #include <Eigen/Dense>
 
 namespace ad {
@@ -47,7 +50,7 @@ struct NormalBase:
         begin = sigma_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -62,7 +65,15 @@ struct NormalBase:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(x_);
+        f(mean_);
+        f(sigma_);
     }
 
 protected:
@@ -83,12 +94,16 @@ protected:
  * The only possible shape combinations are as follows:
  * x -> scalar, mean -> scalar, sigma -> scalar
  * x -> vec, mean -> scalar | vector, sigma -> scalar | vector | self adjoint matrix
+ * x -> matrix, mean -> vector, sigma -> self adjoint matrix
  *
+ * In the last case, every row of x is an observation
+ * and the node is the sum of the log pdfs of all rows (see Case 8).
  * No other shapes are permitted for this node.
  *
  * At construction, the actual sizes of the three expressions are checked -
  * specifically if x is a vector, and mean and sigma are not scalar,
  * then size of x must be the same as that of mean rows and sigma rows.
+ * If x is a matrix, the number of columns of x must be the same as mean rows and sigma rows.
  * Additionally, we check that sigma is square if it is a matrix.
  *
  * @tparam  XExprType           type of x expression at which to evaluate log-pdf
@@ -99,9 +114,9 @@ template <class XExprType
         , class MeanExprType
         , class SigmaExprType
         , class = std::tuple<
-            typename util::shape_traits<XExprType>::shape_t,
-            typename util::shape_traits<MeanExprType>::shape_t,
-            typename util::shape_traits<SigmaExprType>::shape_t> >
+            util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<MeanExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<SigmaExprType>::shape_t>> >
 struct NormalAdjLogPDFNode;
 
 // Case 1: sss
@@ -123,6 +138,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -140,6 +156,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval();
         auto&& m = mean_.feval();
         auto&& s = sigma_.feval();
@@ -157,6 +174,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || sigma_.get() <= 0) return;
 
         value_t inv_s = 1./sigma_.get();
@@ -197,6 +215,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -218,12 +237,13 @@ public:
         // reduced exponential form
         if constexpr (util::is_constant_v<x_t>) {
             x_mean_ = x_.get().mean();
-            x_var_ = (x_.get().array() - x_mean_).matrix().squaredNorm();
+            x_var_ = util::accum_squared_norm(x_.get().array() - x_mean_);
         }
     }
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& m = mean_.feval();
         auto&& s = sigma_.feval();
@@ -242,13 +262,14 @@ public:
                         - x_.rows() * log_sigma_;
         } else {
             auto z = (x - m).matrix();
-            z_sq = z.squaredNorm() / (s * s);
+            z_sq = util::accum_squared_norm(z) / (s * s);
             return this->get() = -0.5 * z_sq - x_.rows() * log_sigma_; 
         }
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || sigma_.get() <= 0) return;
 
         value_t inv_s = 1./sigma_.get();
@@ -319,6 +340,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -337,6 +359,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& m = mean_.feval().array();
         auto&& s = sigma_.feval();
@@ -348,13 +371,14 @@ public:
         }
 
         auto z = (x - m).matrix();
-        z_sq = z.squaredNorm() / (s * s);
+        z_sq = util::accum_squared_norm(z) / (s * s);
         
         return this->get() = -0.5 * z_sq - x_.rows() * log_sigma_; 
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || sigma_.get() <= 0) return;
 
         value_t inv_s = 1./sigma_.get();
@@ -399,6 +423,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -420,15 +445,16 @@ public:
             if constexpr (util::is_constant_v<x_t>) {
                 auto&& x = x_.get().array();
                 auto&& s = sigma_.get().array();
-                sq_term_ = (x/s).matrix().squaredNorm(); 
-                lin_term_ = (x/(s * s)).sum();
-                const_term_ = (1./s).matrix().squaredNorm();
+                sq_term_ = util::accum_squared_norm(x/s);
+                lin_term_ = util::accum_sum(x/(s * s));
+                const_term_ = util::accum_squared_norm(1./s);
             }
         }
     }
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& m = mean_.feval();
         auto&& s = sigma_.feval().array();
@@ -448,12 +474,13 @@ public:
                     - log_sigma_;
         } else {
             auto z = ((x - m) / s).matrix();
-            return this->get() = -0.5 * z.squaredNorm() - log_sigma_; 
+            return this->get() = -0.5 * util::accum_squared_norm(z) - log_sigma_; 
         }
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !is_pos_def_) return;
 
         auto&& x = x_.get().array();
@@ -481,7 +508,7 @@ private:
     void update_cache() {
         is_pos_def_ = (sigma_.get().array() > 0).all();
         if (is_pos_def_) {
-            log_sigma_ = sigma_.get().array().log().sum();
+            log_sigma_ = util::accum_sum(sigma_.get().array().log());
         }
     }
 
@@ -513,6 +540,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -531,6 +559,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& m = mean_.feval().array();
         auto&& s = sigma_.feval().array();
@@ -545,11 +574,12 @@ public:
 
         auto z = ((x - m) / s).matrix();
         
-        return this->get() = -0.5 * z.squaredNorm() - log_sigma_; 
+        return this->get() = -0.5 * util::accum_squared_norm(z) - log_sigma_; 
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !is_pos_def_) return;
 
         auto&& x = x_.get().array();
@@ -569,7 +599,7 @@ private:
     {
         is_pos_def_ = (sigma_.get().array() > 0).all();
         if (is_pos_def_) {
-            log_sigma_ = sigma_.get().array().log().sum();
+            log_sigma_ = util::accum_sum(sigma_.get().array().log());
         }
     }
 
@@ -584,7 +614,7 @@ template <class XExprType
 struct NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType,
                            std::tuple<vec, scl, 
                                 std::enable_if_t<util::is_mat_v<SigmaExprType>,
-                                    typename util::shape_traits<SigmaExprType>::shape_t>> >:
+                                    util::dynamic_shape_t<typename util::shape_traits<SigmaExprType>::shape_t>>> >:
     details::NormalBase<XExprType, MeanExprType, SigmaExprType>,
     core::ExprBase<NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType>>
 {
@@ -598,6 +628,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -609,8 +640,9 @@ public:
         , llt_(sigma.rows())
         , log_det_{0}
         , is_pos_def_{false}
-        , inv_(sigma.rows(), sigma.cols())
-        , z_(mean.cols())
+        , sigma_adj_(sigma.rows(), sigma.cols())
+        , diff_(x.rows())
+        , z_(x.rows())
     {
         // must be square matrix
         assert(sigma_.rows() == sigma_.cols());
@@ -623,6 +655,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval().array();
         auto&& m = mean_.feval();
         sigma_.feval();
@@ -635,42 +668,55 @@ public:
             return this->get() = util::neg_inf<value_t>;
         }
         
-        z_ = inv_ * (x - m).matrix();
-        value_t sq_term = (x - m).matrix().transpose() * z_;
+        diff_ = (x - m).matrix();
+        z_ = llt_->llt().solve(diff_);
+        value_t sq_term = diff_.dot(z_);
         
         return this->get() = -0.5 * sq_term - log_det_; 
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !is_pos_def_) return;
 
         if constexpr (!util::is_constant_v<sigma_t>) {
-            auto adj = (-0.5 * seed) * (inv_ - z_ * z_.transpose());
-            sigma_.beval(adj.array());
+            sigma_adj_ = llt_->inverse();
+            sigma_adj_.noalias() -= z_ * z_.transpose();
+            sigma_adj_ *= -0.5 * seed;
+            sigma_.beval(sigma_adj_.array());
         }
 
         mean_.beval(seed * z_.sum());
         x_.beval((-seed) * z_.array());
     }
 
+    /**
+     * Applies f to the factorization slot of sigma and sigma (see ad::share_factorizations).
+     */
+    template <class F>
+    void for_each_llt(F&& f)
+    {
+        f(llt_, sigma_);
+    }
+
 private:
     void update_cache() {
-        llt_.compute(sigma_.get());
-        is_pos_def_ = (llt_.info() == Eigen::Success);
+        llt_->compute(sigma_.get());
+        is_pos_def_ = llt_->valid();
         if (is_pos_def_) {
-            log_det_ = std::log(llt_.matrixL().determinant());
-            inv_ = llt_.solve(mat_t::Identity(sigma_.rows(), sigma_.cols()));
+            log_det_ = std::log(llt_->llt().matrixL().determinant());
         }
     }
 
     using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
     using vec_t = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
 
-    Eigen::LLT<mat_t, Eigen::Lower> llt_;
+    core::LLTSlot<value_t> llt_;
     value_t log_det_;
     bool is_pos_def_;
-    mat_t inv_;
+    mat_t sigma_adj_;   // buffer for the adjoint of sigma
+    vec_t diff_;        // x - mean
     vec_t z_;
 };
 
@@ -681,7 +727,7 @@ template <class XExprType
 struct NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType,
                            std::tuple<vec, vec, 
                                 std::enable_if_t<util::is_mat_v<SigmaExprType>,
-                                    typename util::shape_traits<SigmaExprType>::shape_t>> >:
+                                    util::dynamic_shape_t<typename util::shape_traits<SigmaExprType>::shape_t>>> >:
     details::NormalBase<XExprType, MeanExprType, SigmaExprType>,
     core::ExprBase<NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType>>
 {
@@ -695,6 +741,7 @@ public:
     using typename base_t::sigma_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::mean_;
     using base_t::sigma_;
@@ -706,8 +753,9 @@ public:
         , llt_(sigma.rows())
         , log_det_{0}
         , is_pos_def_{false}
-        , inv_(sigma.rows(), sigma.cols())
-        , z_(mean.cols())
+        , sigma_adj_(sigma.rows(), sigma.cols())
+        , diff_(x.rows())
+        , z_(x.rows())
     {
         // must be square matrix
         assert(sigma_.rows() == sigma_.cols());
@@ -721,6 +769,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         auto&& x = x_.feval();
         auto&& m = mean_.feval();
         sigma_.feval();
@@ -733,45 +782,195 @@ public:
             return this->get() = util::neg_inf<value_t>;
         }
         
-        z_ = inv_ * (x - m);
-        value_t sq_term = (x - m).transpose() * z_;
+        diff_ = x - m;
+        z_ = llt_->llt().solve(diff_);
+        value_t sq_term = diff_.dot(z_);
         
         return this->get() = -0.5 * sq_term - log_det_; 
     }
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !is_pos_def_) return;
 
         if constexpr (!util::is_constant_v<sigma_t>) {
-            auto adj = (-0.5 * seed) * (inv_ - z_ * z_.transpose());
-            sigma_.beval(adj.array());
+            sigma_adj_ = llt_->inverse();
+            sigma_adj_.noalias() -= z_ * z_.transpose();
+            sigma_adj_ *= -0.5 * seed;
+            sigma_.beval(sigma_adj_.array());
         }
 
         mean_.beval(seed * z_.array());
         x_.beval((-seed) * z_.array());
     }
 
+    /**
+     * Applies f to the factorization slot of sigma and sigma (see ad::share_factorizations).
+     */
+    template <class F>
+    void for_each_llt(F&& f)
+    {
+        f(llt_, sigma_);
+    }
+
 private:
     void update_cache() {
-        llt_.compute(sigma_.get());
-        is_pos_def_ = (llt_.info() == Eigen::Success);
+        llt_->compute(sigma_.get());
+        is_pos_def_ = llt_->valid();
         if (is_pos_def_) {
-            log_det_ = std::log(llt_.matrixL().determinant());
-            inv_ = llt_.solve(mat_t::Identity(sigma_.rows(), sigma_.cols()));
+            log_det_ = std::log(llt_->llt().matrixL().determinant());
         }
     }
 
     using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
     using vec_t = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
 
-    Eigen::LLT<mat_t, Eigen::Lower> llt_;
+    core::LLTSlot<value_t> llt_;
     value_t log_det_;
     bool is_pos_def_;
-    mat_t inv_;
+    mat_t sigma_adj_;   // buffer for the adjoint of sigma
+    vec_t diff_;        // x - mean
     vec_t z_;
 };
 
+// Case 8: mvm
+// Every row of x is an observation sharing mean and sigma.
+// Sigma is factorized once per forward evaluation and the quadratic forms
+// of all observations are computed with one triangular solve against (x - mean)^T,
+// so the cost is O(d^3 + N d^2) rather than O(N d^3) for N observations of size d.
+template <class XExprType
+        , class MeanExprType
+        , class SigmaExprType>
+struct NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType,
+                           std::tuple<mat, vec, 
+                                std::enable_if_t<util::is_mat_v<SigmaExprType>,
+                                    util::dynamic_shape_t<typename util::shape_traits<SigmaExprType>::shape_t>>> >:
+    details::NormalBase<XExprType, MeanExprType, SigmaExprType>,
+    core::ExprBase<NormalAdjLogPDFNode<XExprType, MeanExprType, SigmaExprType>>
+{
+private:
+    using base_t = details::NormalBase<
+        XExprType, MeanExprType, SigmaExprType>;
+    
+public:
+    using typename base_t::x_t;
+    using typename base_t::mean_t;
+    using typename base_t::sigma_t;
+    using typename base_t::value_t;
+    using typename base_t::var_t;
+    using base_t::for_each_child;
+    using base_t::x_;
+    using base_t::mean_;
+    using base_t::sigma_;
+
+    NormalAdjLogPDFNode(const x_t& x,
+                        const mean_t& mean,
+                        const sigma_t& sigma)
+        : base_t(x, mean, sigma)
+        , llt_(sigma.rows())
+        , log_det_{0}
+        , is_pos_def_{false}
+        , sigma_adj_(sigma.rows(), sigma.cols())
+        , mean_adj_(mean.rows())
+        , w_(x.cols(), x.rows())
+        , z_(x.cols(), x.rows())
+    {
+        // must be square matrix
+        assert(sigma_.rows() == sigma_.cols());
+        assert(x_.cols() == mean_.rows());
+        assert(x_.cols() == sigma_.rows());
+
+        if constexpr (util::is_constant_v<sigma_t>) {
+            this->update_cache();
+        }
+    }
+
+    /**
+     * Computes W = L^{-1} (x - mean)^T, where sigma = L L^T,
+     * so that the sum of the quadratic forms is the squared norm of W.
+     */
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        auto&& x = x_.feval();
+        auto&& m = mean_.feval();
+        sigma_.feval();
+
+        if constexpr (!util::is_constant_v<sigma_t>) {
+            this->update_cache();
+        }
+
+        if (!is_pos_def_) {
+            return this->get() = util::neg_inf<value_t>;
+        }
+
+        w_ = x.transpose();
+        w_.colwise() -= m;
+        util::solve_in_place(llt_->llt().matrixL(), w_);
+        value_t sq_term = w_.squaredNorm();
+        value_t n_obs = x_.rows();
+        
+        return this->get() = -0.5 * sq_term - n_obs * log_det_; 
+    }
+
+    /**
+     * With Z = sigma^{-1} (x - mean)^T = L^{-T} W, the adjoints are
+     * -Z^T for x, the row sums of Z for mean,
+     * and -(N sigma^{-1} - Z Z^T) / 2 for sigma, where Z Z^T is a single product.
+     */
+    void beval(value_t seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        if (seed == 0 || !is_pos_def_) return;
+
+        z_ = w_;
+        util::solve_in_place(llt_->llt().matrixU(), z_);
+
+        if constexpr (!util::is_constant_v<sigma_t>) {
+            value_t n_obs = x_.rows();
+            util::product(sigma_adj_, z_, z_.transpose());
+            sigma_adj_ -= n_obs * llt_->inverse();
+            sigma_adj_ *= 0.5 * seed;
+            sigma_.beval(sigma_adj_.array());
+        }
+
+        mean_adj_.noalias() = z_.rowwise().sum();
+        mean_adj_ *= seed;
+        mean_.beval(mean_adj_.array());
+        x_.beval((-seed) * z_.transpose().array());
+    }
+
+    /**
+     * Applies f to the factorization slot of sigma and sigma (see ad::share_factorizations).
+     */
+    template <class F>
+    void for_each_llt(F&& f)
+    {
+        f(llt_, sigma_);
+    }
+
+private:
+    void update_cache() {
+        llt_->compute(sigma_.get());
+        is_pos_def_ = llt_->valid();
+        if (is_pos_def_) {
+            log_det_ = std::log(llt_->llt().matrixL().determinant());
+        }
+    }
+
+    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using vec_t = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
+
+    core::LLTSlot<value_t> llt_;
+    value_t log_det_;
+    bool is_pos_def_;
+    mat_t sigma_adj_;   // buffer for the adjoint of sigma
+    vec_t mean_adj_;    // buffer for the adjoint of mean
+    mat_t w_;           // L^{-1} (x - mean)^T
+    mat_t z_;           // sigma^{-1} (x - mean)^T
+};
+
 } // namespace stat
 
 template <class XType
@@ -0,0 +1,187 @@
+#pragma once
+#include <cmath>
+#include <fastad_bits/reverse/stat/normal.hpp>
+#include <fastad_bits/util/intra_op.hpp>
+#include <fastad_bits/util/type_traits.hpp>
+#include <fastad_bits/util/numeric.hpp>
+#include <Eigen/Dense>
+
+namespace ad {
+namespace stat {
+
+/**
+ * NormalCholeskyAdjLogPDFNode represents the multivariate normal log pdf
+ * adjusted to omit all fixed constants, where the covariance matrix
+ * is parametrized by its lower Cholesky factor L, i.e. sigma = L L^T.
+ * Only the lower triangular part of L is read, and the adjoint of its upper part is 0.
+ *
+ * It assumes the value type that is common to all three expressions.
+ * Since it represents a log-pdf, it is always a scalar expression.
+ *
+ * The only possible shape combinations are as follows:
+ * x -> vector | matrix, mean -> vector, L -> matrix
+ *
+ * If x is a matrix, every row of x is an observation
+ * and the node is the sum of the log pdfs of all rows.
+ *
+ * Sigma is never formed nor inverted:
+ * with W = L^{-1} (x - mean)^T and Z = L^{-T} W,
+ * the log pdf is -||W||^2 / 2 - N log|det L| and the adjoints are
+ * -Z^T for x, the row sums of Z for mean,
+ * and the lower triangular part of Z W^T - N diag(L)^{-1} for L,
+ * where N is the number of observations.
+ * Hence, an evaluation costs O(N d^2) for observations of size d.
+ *
+ * If a diagonal entry of L is 0, the log pdf is -inf and backward evaluation does nothing.
+ *
+ * @tparam  XExprType           type of x expression at which to evaluate log-pdf
+ * @tparam  MeanExprType        type of mean expression
+ * @tparam  LExprType           type of Cholesky factor expression
+ */
+template <class XExprType
+        , class MeanExprType
+        , class LExprType>
+struct NormalCholeskyAdjLogPDFNode:
+    details::NormalBase<XExprType, MeanExprType, LExprType>,
+    core::ExprBase<NormalCholeskyAdjLogPDFNode<XExprType, MeanExprType, LExprType>>
+{
+private:
+    // sigma_ of the base holds the Cholesky factor L
+    using base_t = details::NormalBase<
+        XExprType, MeanExprType, LExprType>;
+
+    static_assert(util::is_vec_v<XExprType> || util::is_mat_v<XExprType>);
+    static_assert(util::is_vec_v<MeanExprType>);
+    static_assert(util::is_mat_v<LExprType>);
+
+public:
+    using typename base_t::x_t;
+    using typename base_t::mean_t;
+    using typename base_t::sigma_t;
+    using typename base_t::value_t;
+    using typename base_t::var_t;
+    using base_t::for_each_child;
+    using base_t::x_;
+    using base_t::mean_;
+    using base_t::sigma_;
+
+    NormalCholeskyAdjLogPDFNode(const x_t& x,
+                                const mean_t& mean,
+                                const sigma_t& l)
+        : base_t(x, mean, l)
+        , is_valid_{false}
+        , l_adj_(l.rows(), l.cols())
+        , mean_adj_(mean.rows())
+        , w_(mean.rows(), n_obs())
+        , z_(mean.rows(), n_obs())
+    {
+        // must be square matrix
+        assert(sigma_.rows() == sigma_.cols());
+        assert(mean_.rows() == sigma_.rows());
+        if constexpr (util::is_vec_v<x_t>) {
+            assert(x_.rows() == mean_.rows());
+        } else {
+            assert(x_.cols() == mean_.rows());
+        }
+    }
+
+    const var_t& feval()
+    {
+        FASTAD_PROFILE_FEVAL();
+        auto&& x = x_.feval();
+        auto&& m = mean_.feval();
+        auto&& l = sigma_.feval();
+
+        is_valid_ = (l.diagonal().array() != 0).all();
+        if (!is_valid_) {
+            return this->get() = util::neg_inf<value_t>;
+        }
+
+        if constexpr (util::is_vec_v<x_t>) {
+            w_.col(0) = x - m;
+        } else {
+            w_ = x.transpose();
+            w_.colwise() -= m;
+        }
+        util::solve_in_place(l.template triangularView<Eigen::Lower>(), w_);
+
+        value_t log_det = l.diagonal().array().abs().log().sum();
+        value_t sq_term = w_.squaredNorm();
+        return this->get() = -0.5 * sq_term - n_obs() * log_det;
+    }
+
+    void beval(value_t seed)
+    {
+        FASTAD_PROFILE_BEVAL();
+        if (seed == 0 || !is_valid_) return;
+
+        auto&& l = sigma_.get();
+        z_ = w_;
+        util::solve_in_place(l.transpose().template triangularView<Eigen::Upper>(), z_);
+
+        if constexpr (!util::is_constant_v<sigma_t>) {
+            util::product(l_adj_, z_, w_.transpose());
+            l_adj_.template triangularView<Eigen::StrictlyUpper>().setZero();
+            l_adj_.diagonal().array() -=
+                static_cast<value_t>(n_obs()) / l.diagonal().array();
+            l_adj_ *= seed;
+            sigma_.beval(l_adj_.array());
+        }
+
+        mean_adj_.noalias() = z_.rowwise().sum();
+        mean_adj_ *= seed;
+        mean_.beval(mean_adj_.array());
+        if constexpr (util::is_vec_v<x_t>) {
+            x_.beval((-seed) * z_.col(0).array());
+        } else {
+            x_.beval((-seed) * z_.transpose().array());
+        }
+    }
+
+private:
+    size_t n_obs() const
+    {
+        if constexpr (util::is_vec_v<x_t>) return 1;
+        else return x_.rows();
+    }
+
+    using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using vec_t = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
+
+    bool is_valid_;     // every diagonal entry of L is non-zero
+    mat_t l_adj_;       // buffer for the adjoint of L
+    vec_t mean_adj_;    // buffer for the adjoint of mean
+    mat_t w_;           // L^{-1} (x - mean)^T
+    mat_t z_;           // L^{-T} L^{-1} (x - mean)^T
+};
+
+} // namespace stat
+
+/**
+ * Creates a multivariate normal log-pdf (adjusted to omit constants)
+ * with covariance matrix L L^T, given its lower Cholesky factor L.
+ * If x is a matrix, every row is an observation (see NormalCholeskyAdjLogPDFNode).
+ */
+template <class XType
+        , class MeanType
+        , class LType
+        , class = std::enable_if_t<
+            util::is_convertible_to_ad_v<XType> &&
+            util::is_convertible_to_ad_v<MeanType> &&
+            util::is_convertible_to_ad_v<LType> &&
+            util::any_ad_v<XType, MeanType, LType> > >
+inline auto normal_cholesky_adj_log_pdf(const XType& x,
+                                        const MeanType& mean,
+                                        const LType& l)
+{
+    using x_expr_t = util::convert_to_ad_t<XType>;
+    using mean_expr_t = util::convert_to_ad_t<MeanType>;
+    using l_expr_t = util::convert_to_ad_t<LType>;
+    x_expr_t x_expr = x;
+    mean_expr_t mean_expr = mean;
+    l_expr_t l_expr = l;
+    return stat::NormalCholeskyAdjLogPDFNode<
+        x_expr_t, mean_expr_t, l_expr_t>(x_expr, mean_expr, l_expr);
+}
+
+} // namespace ad
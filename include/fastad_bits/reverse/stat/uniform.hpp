@@ -5,6 +5,7 @@
 #include <fastad_bits/reverse/core/constant.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/numeric.hpp>
+#include <fastad_bits/util/value.hpp>
 
 namespace ad {
 namespace stat {
@@ -46,7 +47,7 @@ struct UniformBase:
         begin = max_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -61,7 +62,15 @@ struct UniformBase:
 
     util::SizePack single_bind_cache_size() const
     {
-        return {this->size(), 0};
+        return {this->cache_size(), 0};
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(x_);
+        f(min_);
+        f(max_);
     }
 
 protected:
@@ -93,9 +102,9 @@ template <class XExprType
         , class MinExprType
         , class MaxExprType
         , class = std::tuple<
-            typename util::shape_traits<XExprType>::shape_t,
-            typename util::shape_traits<MinExprType>::shape_t,
-            typename util::shape_traits<MaxExprType>::shape_t> >
+            util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<MinExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<MaxExprType>::shape_t>> >
 struct UniformAdjLogPDFNode;
 
 // Case 1: sss
@@ -119,6 +128,7 @@ public:
     using typename base_t::max_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::min_;
     using base_t::max_;
@@ -137,6 +147,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         min_.feval();
         max_.feval();
@@ -156,6 +167,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
         value_t adj = seed / (max_.get() - min_.get());
         max_.beval(-adj);
@@ -196,6 +208,7 @@ public:
     using typename base_t::max_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::min_;
     using base_t::max_;
@@ -219,6 +232,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         min_.feval();
         max_.feval();
@@ -242,6 +256,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
         value_t adj = seed * static_cast<value_t>(x_.size()) /
             (max_.get() - min_.get());
@@ -290,6 +305,7 @@ public:
     using typename base_t::max_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::min_;
     using base_t::max_;
@@ -313,6 +329,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         min_.feval();
         max_.feval();
@@ -335,6 +352,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& min = min_.get();
@@ -345,7 +363,7 @@ public:
 
 private:
     void update_log_diff_cache() {
-        log_diff_ = (max_.get().array() - min_.get()).log().sum();
+        log_diff_ = util::accum_sum((max_.get().array() - min_.get()).log());
     }
 
     void update_x_cache() {
@@ -383,6 +401,7 @@ public:
     using typename base_t::max_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::min_;
     using base_t::max_;
@@ -406,6 +425,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         min_.feval();
         max_.feval();
@@ -428,6 +448,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
 
         auto&& min = min_.get().array();
@@ -438,7 +459,7 @@ public:
 
 private:
     void update_log_diff_cache() {
-        log_diff_ = (max_.get() - min_.get().array()).log().sum();
+        log_diff_ = util::accum_sum((max_.get() - min_.get().array()).log());
     }
 
     void update_x_cache() {
@@ -476,6 +497,7 @@ public:
     using typename base_t::max_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::min_;
     using base_t::max_;
@@ -496,6 +518,7 @@ public:
 
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         min_.feval();
         max_.feval();
@@ -517,6 +540,7 @@ public:
 
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !within_range()) return;
         auto&& min = min_.get().array();
         auto&& max = max_.get().array();
@@ -526,7 +550,7 @@ public:
 
 private:
     void update_log_diff_cache() {
-        log_diff_ = (max_.get().array() - min_.get().array()).log().sum();
+        log_diff_ = util::accum_sum((max_.get().array() - min_.get().array()).log());
     }
 
     bool within_range() const {
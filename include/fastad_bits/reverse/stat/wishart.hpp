@@ -3,6 +3,8 @@
 #include <fastad_bits/reverse/core/expr_base.hpp>
 #include <fastad_bits/reverse/core/value_adj_view.hpp>
 #include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/llt_cache.hpp>
+#include <fastad_bits/util/intra_op.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <fastad_bits/util/numeric.hpp>
 #include <Eigen/Dense>
@@ -50,7 +52,7 @@ struct WishartBase:
         begin = v_.bind_cache(begin);
         auto adj = begin.adj;
         begin.adj = nullptr;
-        begin = value_adj_view_t::bind(begin);
+        begin = value_adj_view_t::bind_cache_slot(begin);
         begin.adj = adj;
         return begin;
     }
@@ -65,7 +67,15 @@ struct WishartBase:
 
     util::SizePack single_bind_cache_size() const
     { 
-        return {this->size(), 0}; 
+        return {this->cache_size(), 0}; 
+    }
+
+    template <class F>
+    void for_each_child(F&& f)
+    {
+        f(x_);
+        f(v_);
+        f(n_);
     }
 
 protected:
@@ -85,6 +95,9 @@ protected:
  *
  * Note: n MUST be a constant.
  *
+ * The inverses and products of large matrices are split into blocks
+ * evaluated on the intra-node pool (see util::set_intra_op).
+ *
  * The only possible shape combinations are as follows:
  * x -> matrix (or self-adj), 
  * v -> matrix (or self-adj)
@@ -100,9 +113,9 @@ template <class XExprType
         , class VExprType
         , class NExprType
         , class = std::tuple<
-            typename util::shape_traits<XExprType>::shape_t,
-            typename util::shape_traits<VExprType>::shape_t,
-            typename util::shape_traits<NExprType>::shape_t> >
+            util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<VExprType>::shape_t>,
+            util::dynamic_shape_t<typename util::shape_traits<NExprType>::shape_t>> >
 struct WishartAdjLogPDFNode;
 
 template <class XExprType
@@ -114,10 +127,10 @@ struct WishartAdjLogPDFNode<XExprType,
                             std::tuple<
                                 std::enable_if_t<
                                     util::is_mat_v<XExprType>, 
-                                    typename util::shape_traits<XExprType>::shape_t>,
+                                    util::dynamic_shape_t<typename util::shape_traits<XExprType>::shape_t>>,
                                 std::enable_if_t<
                                     util::is_mat_v<VExprType>, 
-                                    typename util::shape_traits<VExprType>::shape_t>,
+                                    util::dynamic_shape_t<typename util::shape_traits<VExprType>::shape_t>>,
                                 scl> >:
     details::WishartBase<XExprType, VExprType, NExprType>,
     core::ExprBase<WishartAdjLogPDFNode<XExprType, VExprType, NExprType>>
@@ -131,6 +144,7 @@ public:
     using typename base_t::n_t;
     using typename base_t::value_t;
     using typename base_t::var_t;
+    using base_t::for_each_child;
     using base_t::x_;
     using base_t::v_;
     using base_t::n_;
@@ -145,9 +159,9 @@ public:
         , log_v_det_(0)
         , is_x_pos_def_(false)
         , is_v_pos_def_(false)
-        , x_inv_(x.rows(), x.cols())
-        , v_inv_(v.rows(), v.cols())
-        , xv_inv_(x.rows(), v.rows())
+        , m_(v.rows(), x.cols())
+        , y_(v.rows(), x.cols())
+        , v_adj_(v.rows(), v.cols())
     {
         if constexpr (util::is_constant_v<v_t>) {
             update_v_cache();
@@ -157,8 +171,13 @@ public:
         }
     }
 
+    /**
+     * Forward evaluation only factorizes X and V.
+     * With X = L_X L_X^T and V = L_V L_V^T, tr(V^{-1} X) is the squared norm of M = L_V^{-1} L_X.
+     */
     const var_t& feval()
     {
+        FASTAD_PROFILE_FEVAL();
         x_.feval();
         v_.feval();
         auto&& n = n_.feval();
@@ -174,44 +193,66 @@ public:
             return this->get() = util::neg_inf<value_t>;
         }
 
+        m_ = x_llt_->llt().matrixL();
+        util::solve_in_place(v_llt_->llt().matrixL(), m_);
+
         value_t p = v_.rows();
         return this->get() = (n-p-1.) * log_x_det_ 
-                              - 0.5 * xv_inv_.trace()
+                              - 0.5 * m_.squaredNorm()
                               - n * log_v_det_;
     }
 
+    /**
+     * Backward evaluation uses the inverses of X and V from their factorizations
+     * and V^{-1} X V^{-1} = Y Y^T with Y = L_V^{-T} M.
+     */
     void beval(value_t seed)
     {
+        FASTAD_PROFILE_BEVAL();
         if (seed == 0 || !valid()) return;
 
         value_t n = n_.get();
         value_t p = v_.rows();
 
-        auto x_adj = (0.5 * seed) * ((n-p-1) * x_inv_ - v_inv_);
-        auto v_adj = (0.5 * seed) * (v_inv_ * xv_inv_ - n * v_inv_);
-        v_.beval(v_adj.array());
-        x_.beval(x_adj.array());
+        const auto& v_inv = v_llt_->inverse();
+        if constexpr (!util::is_constant_v<v_t>) {
+            y_ = m_;
+            util::solve_in_place(v_llt_->llt().matrixU(), y_);
+            util::product(v_adj_, y_, y_.transpose());
+            v_adj_ -= n * v_inv;
+            v_adj_ *= 0.5 * seed;
+            v_.beval(v_adj_.array());
+        }
+        if constexpr (!util::is_constant_v<x_t>) {
+            auto x_adj = (0.5 * seed) * ((n-p-1) * x_llt_->inverse() - v_inv);
+            x_.beval(x_adj.array());
+        }
+    }
+
+    /**
+     * Applies f to the factorization slots of X and V and X and V (see ad::share_factorizations).
+     */
+    template <class F>
+    void for_each_llt(F&& f)
+    {
+        f(x_llt_, x_);
+        f(v_llt_, v_);
     }
 
 private:
     void update_v_cache() {
-        v_llt_.compute(v_.get());
-        is_v_pos_def_ = (v_llt_.info() == Eigen::Success);
+        v_llt_->compute(v_.get());
+        is_v_pos_def_ = v_llt_->valid();
         if (is_v_pos_def_) {
-            log_v_det_ = std::log(v_llt_.matrixL().determinant());
-            v_inv_ = v_llt_.solve(mat_t::Identity(v_.rows(), v_.cols()));
+            log_v_det_ = std::log(v_llt_->llt().matrixL().determinant());
         }
     }
 
     void update_x_cache() {
-        if (is_v_pos_def_) {
-            x_llt_.compute(x_.get());
-            is_x_pos_def_ = (x_llt_.info() == Eigen::Success);
-            if (is_x_pos_def_) {
-                log_x_det_ = std::log(x_llt_.matrixL().determinant());
-                x_inv_ = x_llt_.solve(mat_t::Identity(x_.rows(), x_.cols()));
-                xv_inv_ = x_.get() * v_inv_;
-            }
+        x_llt_->compute(x_.get());
+        is_x_pos_def_ = x_llt_->valid();
+        if (is_x_pos_def_) {
+            log_x_det_ = std::log(x_llt_->llt().matrixL().determinant());
         }
     }
 
@@ -223,15 +264,15 @@ private:
 
     using mat_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
 
-    Eigen::LLT<mat_t, Eigen::Lower> x_llt_;
-    Eigen::LLT<mat_t, Eigen::Lower> v_llt_;
+    core::LLTSlot<value_t> x_llt_;
+    core::LLTSlot<value_t> v_llt_;
     value_t log_x_det_;
     value_t log_v_det_;
     bool is_x_pos_def_;
     bool is_v_pos_def_;
-    mat_t x_inv_;
-    mat_t v_inv_;
-    mat_t xv_inv_;
+    mat_t m_;       // L_V^{-1} L_X
+    mat_t y_;       // L_V^{-T} L_V^{-1} L_X
+    mat_t v_adj_;   // buffer for the adjoint of v
 };
 
 } // namespace stat
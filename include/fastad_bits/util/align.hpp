@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <fastad_bits/util/shape_traits.hpp>
+
+/**
+ * FASTAD_CACHE_ALIGN is the alignment (in bytes) of every vector and matrix
+ * cache slot bound by an expression (see ValueAdjView::bind_cache_slot).
+ * If 0 (default), cache slots are packed contiguously without any padding.
+ * Otherwise, it must be a power of 2, e.g. 64 to start every slot on a cache line
+ * so that SIMD loads of node values and adjoints never straddle two cache lines
+ * and no two nodes share a cache line.
+ * The padding is accounted for in the bind cache sizes,
+ * so every TU of a program must be compiled with the same value.
+ */
+#ifndef FASTAD_CACHE_ALIGN
+#define FASTAD_CACHE_ALIGN 0
+#endif
+
+static_assert((FASTAD_CACHE_ALIGN & (FASTAD_CACHE_ALIGN - 1)) == 0,
+              "FASTAD_CACHE_ALIGN must be 0 or a power of 2.");
+
+namespace ad {
+namespace util {
+
+// Number of elements of type T in one cache alignment unit.
+// It is 1 (no padding) if alignment is disabled or T does not evenly divide it.
+template <class T>
+inline constexpr size_t cache_align_elems =
+    (FASTAD_CACHE_ALIGN > 0 && FASTAD_CACHE_ALIGN % sizeof(T) == 0) ?
+    FASTAD_CACHE_ALIGN / sizeof(T) : 1;
+
+// Check if a cache slot of the given value and shape type is aligned.
+// Scalar slots are never padded since a single element cannot straddle a SIMD register.
+template <class T, class ShapeType>
+inline constexpr bool is_cache_aligned_v =
+    !std::is_same_v<ShapeType, ad::scl> && (cache_align_elems<T> > 1);
+
+/**
+ * Returns the number of elements a cache slot of n elements occupies
+ * including the worst-case padding needed to align its beginning.
+ */
+template <class T, class ShapeType>
+inline constexpr size_t cache_slot_size(size_t n)
+{
+    if constexpr (is_cache_aligned_v<T, ShapeType>) {
+        return n + cache_align_elems<T> - 1;
+    } else {
+        return n;
+    }
+}
+
+// Check if cache slots of the given value and shape type can be viewed
+// with aligned Eigen::Map's, i.e. the cache alignment satisfies Eigen's maximum alignment.
+template <class T, class ShapeType>
+inline constexpr bool is_cache_aligned_map_v =
+    is_cache_aligned_v<T, ShapeType> &&
+    (FASTAD_CACHE_ALIGN >= EIGEN_MAX_ALIGN_BYTES);
+
+/**
+ * Defines the Eigen::Map viewer of an aligned cache slot.
+ * If the slot cannot be aligned (see is_cache_aligned_map_v),
+ * it is the usual (unaligned) viewer from shape_to_raw_view_t.
+ */
+namespace details {
+
+template <class T, class ShapeType, bool = is_cache_aligned_map_v<T, ShapeType>>
+struct shape_to_aligned_view
+{
+    using type = shape_to_raw_view_t<T, ShapeType>;
+};
+
+template <class T>
+struct shape_to_aligned_view<T, vec, true>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Eigen::Dynamic, 1>, Eigen::AlignedMax>;
+};
+
+template <class T>
+struct shape_to_aligned_view<T, mat, true>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, Eigen::AlignedMax>;
+};
+
+template <class T, int Rows>
+struct shape_to_aligned_view<T, fixed_vec<Rows>, true>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Rows, 1>, Eigen::AlignedMax>;
+};
+
+template <class T, int Rows, int Cols>
+struct shape_to_aligned_view<T, fixed_mat<Rows, Cols>, true>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Rows, Cols>, Eigen::AlignedMax>;
+};
+
+} // namespace details
+
+template <class T, class ShapeType>
+using shape_to_aligned_view_t = typename
+    details::shape_to_aligned_view<T, ShapeType>::type;
+
+/**
+ * Checks if ptr is at a cache alignment boundary.
+ * Null pointers (unused cache) are considered aligned.
+ */
+template <class T>
+inline bool is_cache_aligned_ptr(const T* ptr)
+{
+    if constexpr (FASTAD_CACHE_ALIGN > 0) {
+        constexpr std::uintptr_t align = FASTAD_CACHE_ALIGN;
+        return (reinterpret_cast<std::uintptr_t>(ptr) & (align - 1)) == 0;
+    } else {
+        return true;
+    }
+}
+
+/**
+ * Rounds ptr up to the next cache alignment boundary.
+ * Null pointers (unused cache) are returned as-is.
+ */
+template <class T, class ShapeType>
+inline T* align_cache_ptr(T* ptr)
+{
+    if constexpr (is_cache_aligned_v<T, ShapeType>) {
+        if (!ptr) return ptr;
+        constexpr std::uintptr_t align = FASTAD_CACHE_ALIGN;
+        auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+        auto offset = ((addr + align - 1) & ~(align - 1)) - addr;
+        return ptr + offset / sizeof(T);
+    } else {
+        return ptr;
+    }
+}
+
+} // namespace util
+} // namespace ad
@@ -0,0 +1,221 @@
+#pragma once
+/*
+ * Allocation tracking for tests and benchmarks.
+ *
+ * This header is not part of <fastad> and is meant only for test and benchmark executables.
+ * It must be included before any Eigen (or FastAD) header in every translation unit
+ * of the executable, since it configures Eigen with EIGEN_RUNTIME_NO_MALLOC
+ * and its own eigen_assert to count Eigen's heap allocations.
+ *
+ * Heap allocations through the global operator new (std::vector, std::function, etc.)
+ * are counted by replacing the global operator new/delete.
+ * Exactly one translation unit must define FASTAD_ALLOC_TRACKER_DEFINE_NEW
+ * before including this header to define the replacements.
+ *
+ * Usage:
+ *
+ *      ad::util::AllocTracker tracker;
+ *      ad::autodiff(expr);
+ *      auto stats = tracker.stats();   // allocations since construction of tracker
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace ad {
+namespace util {
+
+/**
+ * Number of heap allocations.
+ * Eigen's allocations are counted separately since Eigen does not use operator new.
+ * The number of bytes is only known for the allocations through operator new.
+ */
+struct AllocStats
+{
+    size_t count = 0;
+    size_t bytes = 0;
+    size_t eigen_count = 0;
+
+    size_t total() const { return count + eigen_count; }
+};
+
+namespace details {
+
+struct alloc_counters
+{
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> eigen_count{0};
+};
+
+inline alloc_counters& get_alloc_counters()
+{
+    static alloc_counters counters;
+    return counters;
+}
+
+inline void record_alloc(size_t bytes)
+{
+    auto& counters = get_alloc_counters();
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/*
+ * Eigen checks every heap allocation with
+ * eigen_assert(is_malloc_allowed() && "heap allocation is forbidden ...")
+ * when EIGEN_RUNTIME_NO_MALLOC is defined.
+ * Such failures are counted as Eigen allocations and the allocation proceeds.
+ * Any other failure aborts like the default eigen_assert.
+ */
+inline void eigen_assert_fail(const char* expr, const char* file, int line)
+{
+    if (std::strstr(expr, "heap allocation is forbidden")) {
+        get_alloc_counters().eigen_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::fprintf(stderr, "%s:%d: Eigen assertion `%s' failed.\n", file, line, expr);
+    std::abort();
+}
+
+} // namespace details
+} // namespace util
+} // namespace ad
+
+#ifndef EIGEN_RUNTIME_NO_MALLOC
+#define EIGEN_RUNTIME_NO_MALLOC
+#endif
+
+#ifndef eigen_assert
+#define eigen_assert(x) \
+    ((x) ? static_cast<void>(0) : \
+     ::ad::util::details::eigen_assert_fail(#x, __FILE__, __LINE__))
+#endif
+
+#include <Eigen/Core>
+
+namespace ad {
+namespace util {
+
+/**
+ * AllocTracker counts the heap allocations from its construction.
+ * While any tracker is alive, Eigen's allocations are reported (and counted) through eigen_assert.
+ * The counters are global, so allocations from other threads are counted as well.
+ */
+struct AllocTracker
+{
+    AllocTracker()
+        : begin_(current())
+        , prev_eigen_allowed_(Eigen::internal::is_malloc_allowed())
+    {
+        Eigen::internal::set_is_malloc_allowed(false);
+    }
+
+    ~AllocTracker()
+    {
+        Eigen::internal::set_is_malloc_allowed(prev_eigen_allowed_);
+    }
+
+    AllocTracker(const AllocTracker&) =delete;
+    AllocTracker& operator=(const AllocTracker&) =delete;
+
+    /**
+     * Returns the allocations since construction or the last reset.
+     */
+    AllocStats stats() const
+    {
+        AllocStats curr = current();
+        AllocStats out;
+        out.count = curr.count - begin_.count;
+        out.bytes = curr.bytes - begin_.bytes;
+        out.eigen_count = curr.eigen_count - begin_.eigen_count;
+        return out;
+    }
+
+    void reset() { begin_ = current(); }
+
+private:
+    static AllocStats current()
+    {
+        auto& counters = details::get_alloc_counters();
+        AllocStats out;
+        out.count = counters.count.load(std::memory_order_relaxed);
+        out.bytes = counters.bytes.load(std::memory_order_relaxed);
+        out.eigen_count = counters.eigen_count.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    AllocStats begin_;
+    bool prev_eigen_allowed_;
+};
+
+} // namespace util
+} // namespace ad
+
+#ifdef FASTAD_ALLOC_TRACKER_DEFINE_NEW
+
+void* operator new(std::size_t size)
+{
+    ::ad::util::details::record_alloc(size);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ::ad::util::details::record_alloc(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#define FASTAD_ALIGNED_ALLOC(a, size) _aligned_malloc(size, a)
+#define FASTAD_ALIGNED_FREE(p) _aligned_free(p)
+#else
+#define FASTAD_ALIGNED_ALLOC(a, size) std::aligned_alloc(a, size)
+#define FASTAD_ALIGNED_FREE(p) std::free(p)
+#endif
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    ::ad::util::details::record_alloc(size);
+    std::size_t a = static_cast<std::size_t>(align);
+    void* p = FASTAD_ALIGNED_ALLOC(a, ((size ? size : 1) + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { FASTAD_ALIGNED_FREE(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FASTAD_ALIGNED_FREE(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FASTAD_ALIGNED_FREE(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FASTAD_ALIGNED_FREE(p); }
+
+#undef FASTAD_ALIGNED_ALLOC
+#undef FASTAD_ALIGNED_FREE
+
+#endif
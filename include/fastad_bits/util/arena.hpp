@@ -0,0 +1,194 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace ad {
+namespace util {
+
+/**
+ * Arena is a bump allocator for short-lived memory such as expression caches
+ * (see ad::bind(expr, arena)).
+ *
+ * Memory is handed out from large chunks by advancing an offset,
+ * so an allocation is only a few arithmetic operations.
+ * Individual allocations are never freed; instead, reset() releases
+ * everything at once while keeping the memory for reuse.
+ * If a request does not fit in the current chunk, a new chunk is allocated.
+ * On reset(), multiple chunks are merged into one chunk of the total size,
+ * so that a steady workload is eventually served from a single chunk without any malloc.
+ *
+ * Every allocation is aligned to the arena alignment (default 64 bytes, a cache line).
+ * If huge pages are requested, chunks are aligned to 2MB and,
+ * on Linux, advised to be backed by transparent huge pages.
+ *
+ * Arena is not thread-safe; use one arena per thread.
+ */
+
+struct Arena
+{
+    static constexpr size_t default_alignment = 64;
+    static constexpr size_t default_chunk_size = 1 << 16;
+    static constexpr size_t huge_page_size = 1 << 21;
+
+    explicit Arena(size_t chunk_size = default_chunk_size,
+                   size_t alignment = default_alignment,
+                   bool huge_pages = false)
+        : chunk_size_{std::max<size_t>(1, chunk_size)}
+        , alignment_{alignment}
+        , huge_pages_{huge_pages}
+    {
+        assert(alignment_ > 0 && (alignment_ & (alignment_ - 1)) == 0);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() { release(); }
+
+    /**
+     * Allocates memory for n objects of type T aligned to the arena alignment
+     * (or alignof(T) if larger).
+     * The objects are value-initialized.
+     * Since they are never destroyed, T must be trivially destructible.
+     *
+     * @return  pointer to the first object
+     */
+    template <class T>
+    T* allocate(size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "Arena only supports trivially destructible types.");
+        void* p = allocate_bytes(n * sizeof(T), std::max(alignment_, alignof(T)));
+        T* out = static_cast<T*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            new (out + i) T();
+        }
+        return out;
+    }
+
+    /**
+     * Allocates the given number of bytes aligned to alignment.
+     * The memory is uninitialized.
+     */
+    void* allocate_bytes(size_t bytes, size_t alignment)
+    {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        if (!chunks_.empty()) {
+            void* p = bump(bytes, alignment);
+            if (p) return p;
+        }
+        add_chunk(std::max(chunk_size_, bytes + alignment));
+        offset_ = 0;
+        return bump(bytes, alignment);
+    }
+
+    /**
+     * Releases all allocations at once.
+     * Every pointer handed out by the arena is invalidated.
+     * If more than one chunk was used, they are merged into a single chunk.
+     */
+    void reset()
+    {
+        if (chunks_.size() > 1) {
+            size_t total = capacity();
+            release();
+            add_chunk(total);
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    /**
+     * Returns the total number of bytes handed out since the last reset.
+     */
+    size_t used() const { return used_; }
+
+    /**
+     * Returns the total number of bytes owned by the arena.
+     */
+    size_t capacity() const
+    {
+        size_t out = 0;
+        for (const auto& chunk : chunks_) out += chunk.size;
+        return out;
+    }
+
+    size_t n_chunks() const { return chunks_.size(); }
+    size_t alignment() const { return alignment_; }
+
+private:
+    struct Chunk
+    {
+        char* data;
+        size_t size;
+    };
+
+    static size_t align_up(size_t x, size_t alignment)
+    {
+        return (x + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Tries to allocate from the last chunk. Returns nullptr if it does not fit.
+    void* bump(size_t bytes, size_t alignment)
+    {
+        auto& chunk = chunks_.back();
+        auto base = reinterpret_cast<std::uintptr_t>(chunk.data);
+        size_t offset = align_up(base + offset_, alignment) - base;
+        if (offset + bytes > chunk.size) return nullptr;
+        offset_ = offset + bytes;
+        used_ += bytes;
+        return chunk.data + offset;
+    }
+
+    void add_chunk(size_t size)
+    {
+        size_t align = huge_pages_ ?
+            std::max(alignment_, huge_page_size) : alignment_;
+        // aligned_alloc requires alignment of at least sizeof(void*)
+        align = std::max(align, sizeof(void*));
+        size = align_up(size, align);
+#if defined(_MSC_VER)
+        void* p = _aligned_malloc(size, align);
+#else
+        void* p = std::aligned_alloc(align, size);
+#endif
+        if (!p) throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (huge_pages_) madvise(p, size, MADV_HUGEPAGE);
+#endif
+        chunks_.push_back({static_cast<char*>(p), size});
+    }
+
+    void release()
+    {
+        for (auto& chunk : chunks_) {
+#if defined(_MSC_VER)
+            _aligned_free(chunk.data);
+#else
+            std::free(chunk.data);
+#endif
+        }
+        chunks_.clear();
+    }
+
+    size_t chunk_size_;
+    size_t alignment_;
+    bool huge_pages_;
+    std::vector<Chunk> chunks_;
+    size_t offset_ = 0;     // offset into the last chunk
+    size_t used_ = 0;
+};
+
+} // namespace util
+} // namespace ad
@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <Eigen/Core>
+#include <unsupported/Eigen/SpecialFunctions>       // needed for erf
+
+namespace ad {
+namespace util {
+
+/**
+ * Batch is a value type that holds K lanes of ValueType.
+ * It is used as the value type of AD expressions to evaluate
+ * the same expression structure for K input points at once (batch mode).
+ * The lanes are stored contiguously as a fixed-size Eigen array (SoA)
+ * so that every elementwise operation is vectorized across the batch.
+ *
+ * Every arithmetic operation and mathematical function is applied lane-wise.
+ * Arithmetic values are implicitly broadcast to all lanes,
+ * which allows batched expressions to mix with ordinary scalar constants.
+ *
+ * Batch mode is supported for scalar-shaped expressions whose leaves
+ * are all of type Batch (constants may be arithmetic).
+ * After backward evaluation, each lane of a leaf adjoint holds the gradient
+ * for the corresponding input point.
+ * Use lane_sum to get the gradient summed across the batch.
+ *
+ * @tparam  ValueType   underlying data type of each lane
+ * @tparam  K           number of lanes
+ */
+
+template <class ValueType, int K>
+struct Batch
+{
+    static_assert(std::is_arithmetic_v<ValueType>);
+    static_assert(K > 0);
+
+    using value_t = ValueType;
+    using lanes_t = Eigen::Array<value_t, K, 1>;
+    static constexpr int n_lanes = K;
+
+    Batch() : lanes_(lanes_t::Zero()) {}
+
+    template <class S
+            , class = std::enable_if_t<std::is_arithmetic_v<S>> >
+    Batch(S x) : lanes_(lanes_t::Constant(static_cast<value_t>(x))) {}
+
+    template <class Derived>
+    explicit Batch(const Eigen::ArrayBase<Derived>& x) : lanes_(x) {}
+
+    /**
+     * Returns the underlying lanes as an Eigen array.
+     */
+    lanes_t& lanes() { return lanes_; }
+    const lanes_t& lanes() const { return lanes_; }
+
+    value_t& operator[](size_t k) { return lanes_(k); }
+    const value_t& operator[](size_t k) const { return lanes_(k); }
+
+    Batch& operator+=(const Batch& x) { lanes_ += x.lanes_; return *this; }
+    Batch& operator-=(const Batch& x) { lanes_ -= x.lanes_; return *this; }
+    Batch& operator*=(const Batch& x) { lanes_ *= x.lanes_; return *this; }
+    Batch& operator/=(const Batch& x) { lanes_ /= x.lanes_; return *this; }
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+    lanes_t lanes_;
+};
+
+/**
+ * Check if type T is Batch
+ */
+namespace details {
+
+template <class T>
+struct is_batch : std::false_type
+{};
+
+template <class ValueType, int K>
+struct is_batch<Batch<ValueType, K>> : std::true_type
+{};
+
+} // namespace details
+
+template <class T>
+inline constexpr bool is_batch_v =
+    details::is_batch<T>::value;
+
+/**
+ * Sums all lanes of x.
+ * Overloaded for arithmetic types as the identity for uniform usage.
+ */
+template <class ValueType, int K>
+inline ValueType lane_sum(const Batch<ValueType, K>& x)
+{ return x.lanes().sum(); }
+
+template <class T
+        , class = std::enable_if_t<std::is_arithmetic_v<T>> >
+inline T lane_sum(T x) { return x; }
+
+/*
+ * Lane-wise operator overloads.
+ * Arithmetic operands are broadcast to all lanes.
+ */
+#define BATCH_BINARY_OP(op) \
+    template <class ValueType, int K> \
+    inline Batch<ValueType, K> operator op(const Batch<ValueType, K>& x, \
+                                           const Batch<ValueType, K>& y) \
+    { return Batch<ValueType, K>(x.lanes() op y.lanes()); } \
+    template <class ValueType, int K, class S \
+            , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+    inline Batch<ValueType, K> operator op(const Batch<ValueType, K>& x, S y) \
+    { return x op Batch<ValueType, K>(y); } \
+    template <class ValueType, int K, class S \
+            , class = std::enable_if_t<std::is_arithmetic_v<S>> > \
+    inline Batch<ValueType, K> operator op(S x, const Batch<ValueType, K>& y) \
+    { return Batch<ValueType, K>(x) op y; }
+
+BATCH_BINARY_OP(+)
+BATCH_BINARY_OP(-)
+BATCH_BINARY_OP(*)
+BATCH_BINARY_OP(/)
+
+template <class ValueType, int K>
+inline Batch<ValueType, K> operator-(const Batch<ValueType, K>& x)
+{ return Batch<ValueType, K>(-x.lanes()); }
+
+/*
+ * Lane-wise mathematical functions.
+ * These are found through ADL by the unary functors of reverse-mode.
+ */
+#define BATCH_UNARY_FUNC(name) \
+    template <class ValueType, int K> \
+    inline Batch<ValueType, K> name(const Batch<ValueType, K>& x) \
+    { return Batch<ValueType, K>(x.lanes().name()); }
+
+BATCH_UNARY_FUNC(sin)
+BATCH_UNARY_FUNC(cos)
+BATCH_UNARY_FUNC(tan)
+BATCH_UNARY_FUNC(asin)
+BATCH_UNARY_FUNC(acos)
+BATCH_UNARY_FUNC(atan)
+BATCH_UNARY_FUNC(sinh)
+BATCH_UNARY_FUNC(cosh)
+BATCH_UNARY_FUNC(tanh)
+BATCH_UNARY_FUNC(exp)
+BATCH_UNARY_FUNC(log)
+BATCH_UNARY_FUNC(sqrt)
+BATCH_UNARY_FUNC(erf)
+BATCH_UNARY_FUNC(abs)
+
+} // namespace util
+
+using util::Batch;
+using util::lane_sum;
+
+} // namespace ad
+
+namespace Eigen {
+
+/**
+ * NumTraits specialization so that Batch can be stored in Eigen containers
+ * (e.g. the cache of ExprBind).
+ */
+template <class ValueType, int K>
+struct NumTraits<ad::util::Batch<ValueType, K>>
+    : NumTraits<ValueType>
+{
+    using Real = ad::util::Batch<ValueType, K>;
+    using NonInteger = ad::util::Batch<ValueType, K>;
+    using Literal = ad::util::Batch<ValueType, K>;
+    using Nested = ad::util::Batch<ValueType, K>;
+
+    enum {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = K * NumTraits<ValueType>::ReadCost,
+        AddCost = K * NumTraits<ValueType>::AddCost,
+        MulCost = K * NumTraits<ValueType>::MulCost
+    };
+};
+
+} // namespace Eigen
+
+#undef BATCH_BINARY_OP
+#undef BATCH_UNARY_FUNC
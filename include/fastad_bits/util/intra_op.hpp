@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fastad_bits/util/thread_pool.hpp>
+
+namespace ad {
+namespace util {
+
+/*
+ * Intra-node parallelism.
+ *
+ * Large linear-algebra nodes (DotNode, DetNode, LogDetNode, WishartAdjLogPDFNode)
+ * split their matrix products and inversions into column (or row) blocks
+ * and evaluate the blocks on the pool set by set_intra_op.
+ * Only operations of at least min_work flops (roughly) are split,
+ * so small nodes stay serial.
+ * Without a pool (the default), every node is serial.
+ *
+ * The setting is process-wide and the pool must outlive every evaluation that uses it.
+ * Since ThreadPool runs nested parallel_for serially,
+ * nodes evaluated inside a parallel region (e.g. ad::sum(pool, ...)) are not split again.
+ */
+
+// Default minimum number of flops of an operation to be split.
+inline constexpr size_t default_intra_op_min_work = 1 << 20;
+
+namespace details {
+
+inline std::atomic<ThreadPool*>& intra_op_pool_ref()
+{
+    static std::atomic<ThreadPool*> pool{nullptr};
+    return pool;
+}
+
+inline std::atomic<size_t>& intra_op_min_work_ref()
+{
+    static std::atomic<size_t> min_work{default_intra_op_min_work};
+    return min_work;
+}
+
+} // namespace details
+
+/**
+ * Sets the pool used for intra-node parallelism
+ * and the minimum number of flops of an operation to be split.
+ */
+inline void set_intra_op(ThreadPool& pool,
+                         size_t min_work = default_intra_op_min_work)
+{
+    details::intra_op_min_work_ref().store(min_work);
+    details::intra_op_pool_ref().store(&pool);
+}
+
+/**
+ * Disables intra-node parallelism.
+ */
+inline void reset_intra_op()
+{
+    details::intra_op_pool_ref().store(nullptr);
+    details::intra_op_min_work_ref().store(default_intra_op_min_work);
+}
+
+/**
+ * Returns the pool to split an operation of work flops on,
+ * or nullptr if it should be evaluated serially.
+ */
+inline ThreadPool* intra_op_pool(size_t work)
+{
+    ThreadPool* pool = details::intra_op_pool_ref().load();
+    if (!pool || pool->size() <= 1 ||
+        work < details::intra_op_min_work_ref().load()) return nullptr;
+    return pool;
+}
+
+/**
+ * Splits [0, n) into contiguous blocks and invokes f(begin, size) on every block.
+ * The blocks are evaluated in parallel if the total work is large enough (see intra_op_pool),
+ * otherwise f(0, n) is invoked on the calling thread.
+ */
+template <class F>
+inline void parallel_blocks(size_t n, size_t work, F&& f)
+{
+    ThreadPool* pool = intra_op_pool(work);
+    size_t n_blocks = pool ? std::min(n, pool->size()) : 1;
+    if (n_blocks <= 1) {
+        f(size_t(0), n);
+        return;
+    }
+    pool->parallel_for(n_blocks, [&](size_t i) {
+        auto range = chunk_range(n, n_blocks, i);
+        f(range.first, range.second - range.first);
+    });
+}
+
+namespace details {
+
+template <bool Add, class Dst, class Lhs, class Rhs>
+inline void product(Dst& dst, const Lhs& lhs, const Rhs& rhs)
+{
+    auto assign = [](auto&& d, const auto& l, const auto& r) {
+        if constexpr (Add) d.noalias() += l * r;
+        else d.noalias() = l * r;
+    };
+    size_t work = 2 * lhs.rows() * lhs.cols() * rhs.cols();
+    ThreadPool* pool = intra_op_pool(work);
+    if (!pool) {
+        assign(dst, lhs, rhs);
+        return;
+    }
+    // split the output by columns if there are enough, otherwise by rows (e.g. GEMV)
+    if (static_cast<size_t>(dst.cols()) >= pool->size()) {
+        parallel_blocks(dst.cols(), work, [&](size_t begin, size_t size) {
+            assign(dst.middleCols(begin, size), lhs, rhs.middleCols(begin, size));
+        });
+    } else {
+        parallel_blocks(dst.rows(), work, [&](size_t begin, size_t size) {
+            assign(dst.middleRows(begin, size), lhs.middleRows(begin, size), rhs);
+        });
+    }
+}
+
+} // namespace details
+
+/**
+ * Evaluates dst = lhs * rhs, split into blocks of dst if the product is large enough.
+ * dst must already have the size of the product and must not alias lhs or rhs.
+ */
+template <class Dst, class Lhs, class Rhs>
+inline void product(Dst&& dst, const Lhs& lhs, const Rhs& rhs)
+{
+    details::product<false>(dst, lhs, rhs);
+}
+
+/**
+ * Evaluates dst += lhs * rhs (see product).
+ */
+template <class Dst, class Lhs, class Rhs>
+inline void product_add(Dst&& dst, const Lhs& lhs, const Rhs& rhs)
+{
+    details::product<true>(dst, lhs, rhs);
+}
+
+/**
+ * Evaluates dst = A^{-1} given a decomposition dec of A (e.g. Eigen::LLT),
+ * by solving for blocks of columns of the identity, in parallel if A is large enough.
+ * dst must already have the size of A.
+ */
+template <class Decomp, class Dst>
+inline void solve_identity(const Decomp& dec, Dst& dst)
+{
+    size_t n = dec.rows();
+    parallel_blocks(n, 2 * n * n * n, [&](size_t begin, size_t size) {
+        dst.middleCols(begin, size) = dec.solve(Dst::Identity(n, n).middleCols(begin, size));
+    });
+}
+
+/**
+ * Solves tri * X = dst in place for a triangular view tri (e.g. L.triangularView<Eigen::Lower>()),
+ * split into blocks of columns of dst if the solve is large enough.
+ */
+template <class TriangularType, class Dst>
+inline void solve_in_place(const TriangularType& tri, Dst& dst)
+{
+    size_t n = tri.rows();
+    parallel_blocks(dst.cols(), n * n * dst.cols(), [&](size_t begin, size_t size) {
+        auto block = dst.middleCols(begin, size);
+        tri.solveInPlace(block);
+    });
+}
+
+} // namespace util
+} // namespace ad
@@ -16,5 +16,30 @@ inline constexpr T neg_inf =
     -std::numeric_limits<T>::infinity() :
     std::numeric_limits<T>::lowest();
 
+/**
+ * FASTAD_MIXED_PRECISION enables mixed-precision reverse mode.
+ * Values and adjoints are still stored as float,
+ * but reductions (sums, norms, log-pdf accumulations) of float values
+ * accumulate in double before the result is stored back as float.
+ * Every TU of a program must be compiled with the same setting.
+ */
+template <class T>
+struct accum_type
+{
+    using type = T;
+};
+
+#ifdef FASTAD_MIXED_PRECISION
+template <>
+struct accum_type<float>
+{
+    using type = double;
+};
+#endif
+
+// Type in which reductions of values of type T accumulate.
+template <class T>
+using accum_t = typename accum_type<T>::type;
+
 } // namespace util
 } // namespace ad
@@ -0,0 +1,81 @@
+#pragma once
+/*
+ * Per-node profiling instrumentation.
+ *
+ * If FASTAD_PROFILE is defined, every node (ExprBase) carries a NodeProfile
+ * and every node's feval/beval is timed with FASTAD_PROFILE_FEVAL/FASTAD_PROFILE_BEVAL.
+ * Otherwise, the macros expand to nothing and nodes carry no extra state,
+ * so there is no overhead at all.
+ * FASTAD_PROFILE must be the same in every translation unit.
+ *
+ * See reverse/core/profile.hpp for collecting and reporting the counters.
+ */
+
+#ifdef FASTAD_PROFILE
+
+#include <chrono>
+#include <cstddef>
+
+namespace ad {
+namespace util {
+
+/**
+ * Number of calls and total time spent in one member function of a node.
+ * Time is inclusive, i.e. it contains the time spent in the children.
+ */
+struct ProfileCounter
+{
+    using clock_t = std::chrono::steady_clock;
+
+    size_t calls = 0;
+    clock_t::duration time = clock_t::duration::zero();
+
+    void reset() { *this = ProfileCounter(); }
+};
+
+struct NodeProfile
+{
+    ProfileCounter feval;
+    ProfileCounter beval;
+};
+
+/**
+ * RAII timer that adds the time from construction to destruction to a counter.
+ * The counters are not synchronized, so a node must not be evaluated
+ * from multiple threads at once while profiling.
+ */
+struct ProfileScope
+{
+    ProfileScope(ProfileCounter& counter)
+        : counter_(counter)
+        , begin_(ProfileCounter::clock_t::now())
+    {}
+
+    ~ProfileScope()
+    {
+        counter_.time += ProfileCounter::clock_t::now() - begin_;
+        ++counter_.calls;
+    }
+
+    ProfileScope(const ProfileScope&) =delete;
+    ProfileScope& operator=(const ProfileScope&) =delete;
+
+private:
+    ProfileCounter& counter_;
+    ProfileCounter::clock_t::time_point begin_;
+};
+
+} // namespace util
+} // namespace ad
+
+#define FASTAD_PROFILE_FEVAL() \
+    ::ad::util::ProfileScope fastad_profile_scope_(this->profile().feval)
+#define FASTAD_PROFILE_BEVAL() \
+    ::ad::util::ProfileScope fastad_profile_scope_(this->profile().beval)
+
+#else
+
+#define FASTAD_PROFILE_FEVAL() static_cast<void>(0)
+#define FASTAD_PROFILE_BEVAL() static_cast<void>(0)
+
+#endif
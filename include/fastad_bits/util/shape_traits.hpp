@@ -8,6 +8,29 @@ struct scl { static constexpr size_t dim = 0; };
 struct vec { static constexpr size_t dim = 1; };
 struct mat { static constexpr size_t dim = 2; };
 
+/*
+ * Fixed-size shapes are vec and mat whose sizes are known at compile-time.
+ * They are views of Eigen fixed-size matrices, so that small problems
+ * (e.g. 3x3 matrices) can be fully unrolled and need no dynamic allocation.
+ * Every fixed-size shape is also a vec or mat, so nodes that accept vec or mat
+ * accept the corresponding fixed-size shape as well.
+ */
+template <int Rows>
+struct fixed_vec : vec
+{
+    static_assert(Rows > 0);
+    static constexpr int rows = Rows;
+    static constexpr int cols = 1;
+};
+
+template <int Rows, int Cols>
+struct fixed_mat : mat
+{
+    static_assert(Rows > 0 && Cols > 0);
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+};
+
 namespace util {
 
 template <class T>
@@ -42,13 +65,68 @@ inline constexpr bool is_scl_v =
 
 template <class T>
 inline constexpr bool is_vec_v =
-    std::is_same_v<details::get_shape_t<T>,
-                   vec>;
+    std::is_base_of_v<vec, details::get_shape_t<T>>;
 
 template <class T>
 inline constexpr bool is_mat_v =
     std::is_base_of_v<mat, details::get_shape_t<T>>;
 
+/**
+ * Checks if a shape tag is a fixed-size shape.
+ */
+namespace details {
+
+template <class ShapeType>
+struct is_fixed_shape : std::false_type {};
+
+template <int Rows>
+struct is_fixed_shape<fixed_vec<Rows>> : std::true_type {};
+
+template <int Rows, int Cols>
+struct is_fixed_shape<fixed_mat<Rows, Cols>> : std::true_type {};
+
+} // namespace details
+
+template <class ShapeType>
+inline constexpr bool is_fixed_shape_v =
+    details::is_fixed_shape<ShapeType>::value;
+
+template <class T>
+inline constexpr bool is_fixed_v =
+    is_fixed_shape_v<details::get_shape_t<T>>;
+
+/**
+ * Maps a fixed-size shape to its dynamic counterpart.
+ * All other shapes are mapped to themselves.
+ *
+ * fixed_vec<N> -> vec
+ * fixed_mat<R, C> -> mat
+ */
+namespace details {
+
+template <class ShapeType>
+struct dynamic_shape
+{
+    using type = ShapeType;
+};
+
+template <int Rows>
+struct dynamic_shape<fixed_vec<Rows>>
+{
+    using type = vec;
+};
+
+template <int Rows, int Cols>
+struct dynamic_shape<fixed_mat<Rows, Cols>>
+{
+    using type = mat;
+};
+
+} // namespace details
+
+template <class ShapeType>
+using dynamic_shape_t = typename details::dynamic_shape<ShapeType>::type;
+
 /**
  * Defines a mapping from shape tags to corresponding
  * Eigen::Map/scalar viewers.
@@ -56,6 +134,8 @@ inline constexpr bool is_mat_v =
  * scl -> T*
  * vec -> Map<Matrix<T, Dynamic, 1>>
  * mat -> Map<Matrix<T, Dynamic, Dynamic>>
+ * fixed_vec<N> -> Map<Matrix<T, N, 1>>
+ * fixed_mat<R, C> -> Map<Matrix<T, R, C>>
  */
 namespace details {
 
@@ -82,6 +162,20 @@ struct shape_to_raw_view<T, mat>
         Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >;
 };
 
+template <class T, int Rows>
+struct shape_to_raw_view<T, fixed_vec<Rows>>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Rows, 1> >;
+};
+
+template <class T, int Rows, int Cols>
+struct shape_to_raw_view<T, fixed_mat<Rows, Cols>>
+{
+    using type = Eigen::Map<
+        Eigen::Matrix<T, Rows, Cols> >;
+};
+
 } // namespace details
 
 template <class T, class ShapeType>
@@ -97,15 +191,26 @@ using shape_to_raw_view_t = typename
  * (FOLLOWING DEPRECATED: selfadjmat is deprecated) 
  * This is so that for cases when one is a mat and the other is selfadjmat, the result is mat,
  * and when both are selfadjmats, then the result is selfadjmat.
+ *
+ * If both shapes have the same dimension and one of them is fixed-size,
+ * the result is the fixed-size shape, since the sizes must agree anyway.
  */
 
 template <class T1, class T2>
 using max_shape_t = std::conditional_t<
-    std::is_same_v<T1, mat> ||
-    std::is_same_v<T2, mat>,
-    mat,
+    (T1::dim == T2::dim) && is_fixed_shape_v<T1>,
+    T1,
     std::conditional_t<
-        (T1::dim > T2::dim), T1, T2
+        (T1::dim == T2::dim) && is_fixed_shape_v<T2>,
+        T2,
+        std::conditional_t<
+            std::is_same_v<T1, mat> ||
+            std::is_same_v<T2, mat>,
+            mat,
+            std::conditional_t<
+                (T1::dim > T2::dim), T1, T2
+            >
+        >
     >
 >;
 
@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ad {
+namespace util {
+
+/**
+ * TaskPool is a fixed-size work-stealing pool of worker threads
+ * used to evaluate independent subtrees of an expression in parallel (see ad::schedule).
+ *
+ * The only supported job type is a blocking fork-join of two functors:
+ * fork_join(f, g) pushes g onto the task queue of the calling thread,
+ * runs f, then runs g itself unless another thread has stolen it in the meantime.
+ * Every thread owns a queue and idle threads steal the oldest task of another queue,
+ * which is usually the largest subtree.
+ * Unlike ThreadPool, nested fork-joins are executed in parallel as well:
+ * a thread waiting for a stolen task runs tasks stolen from other queues.
+ *
+ * Like ThreadPool, the thread calling fork_join participates,
+ * so a pool of size n spawns n-1 workers.
+ * Calls from threads outside of the pool are serialized.
+ */
+
+struct TaskPool
+{
+    explicit TaskPool(size_t n_threads =
+                          std::max<size_t>(1, std::thread::hardware_concurrency()))
+        : n_queues_(std::max<size_t>(1, n_threads))
+        , queues_(new Queue[n_queues_])
+    {
+        workers_.reserve(n_queues_ - 1);
+        for (size_t i = 1; i < n_queues_; ++i) {
+            workers_.emplace_back([this, i]() { worker_loop(i); });
+        }
+    }
+
+    TaskPool(const TaskPool&) =delete;
+    TaskPool& operator=(const TaskPool&) =delete;
+
+    ~TaskPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(sleep_mtx_);
+            stop_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    /**
+     * Returns the number of threads that participate in a fork_join,
+     * i.e. number of workers plus the calling thread.
+     */
+    size_t size() const { return n_queues_; }
+
+    /**
+     * Invokes f() and g(), possibly in parallel, and blocks until both are done.
+     * If the pool has a single thread, f() is invoked before g() on the calling thread.
+     * The first exception thrown by f or g is rethrown in the caller
+     * after both have finished.
+     */
+    template <class F, class G>
+    void fork_join(F&& f, G&& g)
+    {
+        if (n_queues_ == 1) {
+            f();
+            g();
+            return;
+        }
+
+        auto& me = participant();
+        if (me.pool == this) {
+            fork_join(me.index, f, g);
+            return;
+        }
+
+        // external thread: takes the place of queue 0
+        std::unique_lock<std::mutex> lock(root_mtx_);
+        Participant prev = me;
+        me = {this, 0};
+        struct Restore
+        {
+            Participant& me;
+            Participant prev;
+            ~Restore() { me = prev; }
+        } restore{me, prev};
+        fork_join(0, f, g);
+    }
+
+private:
+    struct Task
+    {
+        void (*run)(void*);
+        void* fn;
+        std::atomic<bool> done{false};
+        std::exception_ptr error;
+    };
+
+    struct Queue
+    {
+        std::mutex mtx;
+        std::deque<Task*> tasks;
+    };
+
+    struct Participant
+    {
+        TaskPool* pool;
+        size_t index;
+    };
+
+    static Participant& participant()
+    {
+        static thread_local Participant p{nullptr, 0};
+        return p;
+    }
+
+    template <class F, class G>
+    void fork_join(size_t i, F& f, G& g)
+    {
+        using g_t = std::remove_reference_t<G>;
+        Task task;
+        task.fn = const_cast<void*>(static_cast<const void*>(std::addressof(g)));
+        task.run = [](void* fn) { (*static_cast<g_t*>(fn))(); };
+        push(i, &task);
+
+        std::exception_ptr error;
+        try {
+            f();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        if (pop_if(i, &task)) {
+            execute(&task);
+        } else {
+            // stolen: help the other threads until it is done
+            while (!task.done.load(std::memory_order_acquire)) {
+                Task* other = steal(i);
+                if (other) execute(other);
+                else std::this_thread::yield();
+            }
+        }
+
+        if (!error) error = task.error;
+        if (error) std::rethrow_exception(error);
+    }
+
+    static void execute(Task* task)
+    {
+        try {
+            task->run(task->fn);
+        } catch (...) {
+            task->error = std::current_exception();
+        }
+        task->done.store(true, std::memory_order_release);
+    }
+
+    void push(size_t i, Task* task)
+    {
+        {
+            // counted before it is visible so that n_queued_ never underflows
+            std::unique_lock<std::mutex> lock(queues_[i].mtx);
+            n_queued_.fetch_add(1);
+            queues_[i].tasks.push_back(task);
+        }
+        {
+            std::unique_lock<std::mutex> lock(sleep_mtx_);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    // pops task from the back of queue i if it has not been stolen
+    bool pop_if(size_t i, Task* task)
+    {
+        std::unique_lock<std::mutex> lock(queues_[i].mtx);
+        auto& tasks = queues_[i].tasks;
+        if (tasks.empty() || tasks.back() != task) return false;
+        tasks.pop_back();
+        n_queued_.fetch_sub(1);
+        return true;
+    }
+
+    Task* pop_back(size_t i)
+    {
+        std::unique_lock<std::mutex> lock(queues_[i].mtx);
+        auto& tasks = queues_[i].tasks;
+        if (tasks.empty()) return nullptr;
+        Task* task = tasks.back();
+        tasks.pop_back();
+        n_queued_.fetch_sub(1);
+        return task;
+    }
+
+    // steals the oldest task of the first non-empty queue other than i
+    Task* steal(size_t i)
+    {
+        for (size_t k = 1; k < n_queues_; ++k) {
+            auto& queue = queues_[(i + k) % n_queues_];
+            std::unique_lock<std::mutex> lock(queue.mtx);
+            if (queue.tasks.empty()) continue;
+            Task* task = queue.tasks.front();
+            queue.tasks.pop_front();
+            n_queued_.fetch_sub(1);
+            return task;
+        }
+        return nullptr;
+    }
+
+    void worker_loop(size_t i)
+    {
+        participant() = {this, i};
+        while (true) {
+            Task* task = pop_back(i);
+            if (!task) task = steal(i);
+            if (task) {
+                execute(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mtx_);
+            sleep_cv_.wait(lock, [&]() { return stop_ || n_queued_.load() > 0; });
+            if (stop_) return;
+        }
+    }
+
+    size_t n_queues_;
+    std::unique_ptr<Queue[]> queues_;   // queue 0 belongs to the external caller
+    std::vector<std::thread> workers_;
+    std::mutex root_mtx_;               // serializes external fork_join callers
+    std::mutex sleep_mtx_;
+    std::condition_variable sleep_cv_;
+    std::atomic<size_t> n_queued_{0};
+    bool stop_ = false;
+};
+
+} // namespace util
+} // namespace ad
@@ -0,0 +1,189 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ad {
+namespace util {
+
+/**
+ * ThreadPool is a minimal fixed-size pool of worker threads
+ * used by the parallel evaluation modes of the AD nodes.
+ *
+ * The only supported job type is a blocking parallel-for:
+ * tasks 0,...,n-1 are handed out to the workers and the calling thread,
+ * which all participate until every task is finished.
+ * Since the caller participates, a pool of size n spawns n-1 workers.
+ *
+ * A parallel_for issued from inside a task (nested parallelism)
+ * is executed serially by the calling thread to avoid deadlocks.
+ */
+
+struct ThreadPool
+{
+    explicit ThreadPool(size_t n_threads =
+                            std::max<size_t>(1, std::thread::hardware_concurrency()))
+    {
+        n_threads = std::max<size_t>(1, n_threads);
+        workers_.reserve(n_threads - 1);
+        for (size_t i = 0; i + 1 < n_threads; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) =delete;
+    ThreadPool& operator=(const ThreadPool&) =delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    /**
+     * Returns the number of threads that participate in a parallel_for,
+     * i.e. number of workers plus the calling thread.
+     */
+    size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * Invokes f(i) for every i in [0, n_tasks) and blocks until all are done.
+     * The first exception thrown by any task is rethrown in the caller.
+     */
+    template <class F>
+    void parallel_for(size_t n_tasks, F&& f)
+    {
+        if (n_tasks == 0) return;
+
+        // serial fallback: single task, no workers, or nested call
+        if (n_tasks == 1 || workers_.empty() || in_task()) {
+            for (size_t i = 0; i < n_tasks; ++i) f(i);
+            return;
+        }
+
+        std::unique_lock<std::mutex> job_lock(job_mtx_);
+
+        Job job([&f](size_t i) { f(i); }, n_tasks);
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            job_ = &job;
+            ++generation_;
+        }
+        cv_.notify_all();
+
+        run_tasks(job);
+
+        // wait for the tasks, then for the workers still holding the job
+        std::unique_lock<std::mutex> lock(mtx_);
+        done_cv_.wait(lock, [&]() { return job.n_done == n_tasks; });
+        job_ = nullptr;
+        done_cv_.wait(lock, [&]() { return job.n_workers == 0; });
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    static bool& in_task()
+    {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    // State of one parallel_for, owned by the caller.
+    // A worker picks up the job it was woken up for and registers itself in n_workers,
+    // so that it never touches the state of another job,
+    // and the caller does not return (destroying the job) until every worker let go of it.
+    struct Job
+    {
+        Job(std::function<void(size_t)> task, size_t n_tasks)
+            : task(std::move(task))
+            , n_tasks(n_tasks)
+        {}
+
+        std::function<void(size_t)> task;
+        const size_t n_tasks;
+        std::atomic<size_t> next{0};
+        size_t n_done = 0;              // guarded by mtx_
+        size_t n_workers = 0;           // guarded by mtx_
+        std::exception_ptr error;       // guarded by mtx_
+    };
+
+    // grabs tasks from job until there are none left
+    void run_tasks(Job& job)
+    {
+        bool& flag = in_task();
+        flag = true;
+        size_t n_finished = 0;
+        size_t i;
+        while ((i = job.next.fetch_add(1)) < job.n_tasks) {
+            try {
+                job.task(i);
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(mtx_);
+                if (!job.error) job.error = std::current_exception();
+            }
+            ++n_finished;
+        }
+        flag = false;
+        if (n_finished) {
+            std::unique_lock<std::mutex> lock(mtx_);
+            job.n_done += n_finished;
+            if (job.n_done == job.n_tasks) done_cv_.notify_all();
+        }
+    }
+
+    void worker_loop()
+    {
+        size_t seen = 0;
+        while (true) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+                if (!job) continue;
+                ++job->n_workers;
+            }
+            run_tasks(*job);
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (--job->n_workers == 0) done_cv_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex job_mtx_;                // serializes concurrent parallel_for callers
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    Job* job_ = nullptr;                // current job, guarded by mtx_
+    size_t generation_ = 0;
+    bool stop_ = false;
+};
+
+/**
+ * Returns the half-open range [begin, end) of the ith chunk
+ * when n items are split into n_chunks contiguous chunks of near-equal size.
+ */
+inline std::pair<size_t, size_t> chunk_range(size_t n, size_t n_chunks, size_t i)
+{
+    size_t q = n / n_chunks;
+    size_t r = n % n_chunks;
+    size_t begin = i * q + std::min(i, r);
+    size_t end = begin + q + (i < r);
+    return {begin, end};
+}
+
+} // namespace util
+} // namespace ad
@@ -0,0 +1,79 @@
+#pragma once
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#if defined(__GNUG__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
+
+namespace ad {
+namespace util {
+
+/**
+ * Returns the (demangled, if supported by the compiler) name of type T.
+ */
+template <class T>
+inline std::string type_name()
+{
+    const char* name = typeid(T).name();
+#if defined(__GNUG__) || defined(__clang__)
+    int status = 0;
+    std::unique_ptr<char, void(*)(void*)> demangled(
+            abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+    if (status == 0 && demangled) return demangled.get();
+#endif
+    return name;
+}
+
+/**
+ * Returns a short name of type T for human-readable output.
+ * Namespace qualifiers are removed and template arguments
+ * nested deeper than max_depth are elided, e.g. with max_depth = 1,
+ * ad::core::BinaryNode<ad::core::Add, ad::core::UnaryNode<...>, ad::VarView<double, ad::vec>>
+ * becomes BinaryNode<Add, UnaryNode<...>, VarView<...>>.
+ * Expression types of large models are otherwise thousands of characters long.
+ */
+template <class T>
+inline std::string short_type_name(size_t max_depth = 1)
+{
+    std::string name = type_name<T>();
+    std::string out;
+    out.reserve(name.size());
+    size_t depth = 0;
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        if (c == '<') {
+            if (depth == max_depth) out += "<...";
+            else if (depth < max_depth) out += c;
+            ++depth;
+            continue;
+        }
+        if (c == '>') {
+            --depth;
+            if (depth <= max_depth) {
+                // some compilers print "> >"
+                if (!out.empty() && out.back() == ' ') out.pop_back();
+                out += c;
+            }
+            continue;
+        }
+        if (depth > max_depth) continue;
+        if (c == ':' && i + 1 < name.size() && name[i+1] == ':') {
+            // drop the qualifier just written, e.g. "ad::core::"
+            while (!out.empty() &&
+                   (std::isalnum(static_cast<unsigned char>(out.back())) ||
+                    out.back() == '_')) {
+                out.pop_back();
+            }
+            ++i;
+            continue;
+        }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace util
+} // namespace ad
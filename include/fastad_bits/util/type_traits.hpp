@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <iterator>
 #include <tuple>
+#include <fastad_bits/util/batch.hpp>
 #include <fastad_bits/util/shape_traits.hpp>
 
 namespace ad {
@@ -154,6 +155,18 @@ struct constant_var<ValueType, ad::mat>
     using type = Eigen::Matrix<ValueType, Eigen::Dynamic, Eigen::Dynamic>;
 };
 
+template <class ValueType, int Rows>
+struct constant_var<ValueType, ad::fixed_vec<Rows>>
+{
+    using type = Eigen::Matrix<ValueType, Rows, 1>;
+};
+
+template <class ValueType, int Rows, int Cols>
+struct constant_var<ValueType, ad::fixed_mat<Rows, Cols>>
+{
+    using type = Eigen::Matrix<ValueType, Rows, Cols>;
+};
+
 } // namespace details
 
 template <class ValueType, class ShapeType>
@@ -220,6 +233,13 @@ struct convert_to_ad<T, std::enable_if_t<std::is_arithmetic_v<T>>>
     using type = core::Constant<T, ad::scl>;
 };
 
+// specialization: batch (scalar-shaped)
+template <class T>
+struct convert_to_ad<T, std::enable_if_t<is_batch_v<T>>>
+{
+    using type = core::Constant<T, ad::scl>;
+};
+
 // specialization: column vector
 template <class T>
 struct convert_to_ad<T, std::enable_if_t<
@@ -1,5 +1,6 @@
 #pragma once
 #include <utility>
+#include <fastad_bits/util/numeric.hpp>
 #include <fastad_bits/util/type_traits.hpp>
 #include <Eigen/Dense>
 
@@ -44,5 +45,39 @@ constexpr inline void ones(T& x)
     }
 };
 
+/**
+ * Sums the elements of an Eigen object in the accumulation type
+ * of its scalar type (see accum_t).
+ * @return  sum as accum_t of the scalar type
+ */
+template <class T>
+inline auto accum_sum(const T& x)
+{
+    using scalar_t = typename T::Scalar;
+    using accum_value_t = accum_t<scalar_t>;
+    if constexpr (std::is_same_v<scalar_t, accum_value_t>) {
+        return x.sum();
+    } else {
+        return x.template cast<accum_value_t>().sum();
+    }
+}
+
+/**
+ * Computes the squared norm of an Eigen object (matrix or array)
+ * in the accumulation type of its scalar type (see accum_t).
+ * @return  squared norm as accum_t of the scalar type
+ */
+template <class T>
+inline auto accum_squared_norm(const T& x)
+{
+    using scalar_t = typename T::Scalar;
+    using accum_value_t = accum_t<scalar_t>;
+    if constexpr (std::is_same_v<scalar_t, accum_value_t>) {
+        return x.matrix().squaredNorm();
+    } else {
+        return x.template cast<accum_value_t>().matrix().squaredNorm();
+    }
+}
+
 } // namespace util
 } // namespace ad
@@ -40,5 +40,28 @@ TEST_F(dualnum_fixture, get_set_adjoint)
     EXPECT_DOUBLE_EQ(dual.get_adjoint(), 3.4);  // adjoint changed
 }
 
+TEST(dualnum_vec, adjoint_type)
+{
+    bool scalar_adjoint = std::is_same<DualNum<double>::adjoint_type, double>::value;
+    EXPECT_TRUE(scalar_adjoint);
+    bool packet_adjoint = std::is_same<DualNum<double, 4>::adjoint_type, 
+                                       Eigen::Array<double, 4, 1>>::value;
+    EXPECT_TRUE(packet_adjoint);
+}
+
+TEST(dualnum_vec, get_set_adjoint)
+{
+    DualNum<double, 3> dual(1.5, DualNum<double, 3>::zero_adjoint());
+    EXPECT_DOUBLE_EQ(dual.get_value(), 1.5);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_DOUBLE_EQ(dual.get_adjoint()(k), 0.);
+    }
+    dual.set_adjoint(Eigen::Array3d(1., 2., 3.));
+    EXPECT_DOUBLE_EQ(dual.get_value(), 1.5);    // value did not change
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_DOUBLE_EQ(dual.get_adjoint()(k), k + 1.);
+    }
+}
+
 } // namespace core
 } // namespace ad
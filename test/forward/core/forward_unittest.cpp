@@ -1,5 +1,6 @@
 #define _USE_MATH_DEFINES
 #include <fastad_bits/forward/core/forward.hpp>
+#include <Eigen/Dense>
 #include "gtest/gtest.h"
 
 namespace ad {
@@ -148,4 +149,169 @@ TEST_F(adforward_fixture, div)
     EXPECT_DOUBLE_EQ(res.get_adjoint(), 1./3 + 4./9);    // directional derivative in direction (1,1)
 }
 
+////////////////////////////////////////////////////////////
+// Vector mode
+////////////////////////////////////////////////////////////
+
+TEST_F(adforward_fixture, vec_mode_unary)
+{
+    ForwardVar<double, 4> x(0.3);
+    x.get_adjoint() << 1, -2, 0, 0.5;   // four directions at once
+    ForwardVar<double, 4> res = ad::sin(x);
+    EXPECT_DOUBLE_EQ(res.get_value(), std::sin(0.3));
+    for (int k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(res.get_adjoint()(k), 
+                         std::cos(0.3) * x.get_adjoint()(k));
+    }
+}
+
+TEST_F(adforward_fixture, vec_mode_binary)
+{
+    ForwardVar<double, 2> x(4), y(3);
+    x.get_adjoint() << 1, 0;
+    y.get_adjoint() << 0, 1;
+    ForwardVar<double, 2> res = x * y / (x + y) - 2. * x;
+    EXPECT_DOUBLE_EQ(res.get_value(), 12./7 - 8);
+    EXPECT_DOUBLE_EQ(res.get_adjoint()(0), 9./49 - 2);  // partial w.r.t. x
+    EXPECT_DOUBLE_EQ(res.get_adjoint()(1), 16./49);     // partial w.r.t. y
+}
+
+TEST_F(adforward_fixture, vec_mode_matches_scalar)
+{
+    auto f = [](const auto& x, const auto& y) {
+        return ad::exp(x) * ad::cos(y) + ad::sqrt(x * y) - ad::tanh(y / x);
+    };
+
+    ForwardVar<double, 3> xv(1.3), yv(0.7);
+    xv.get_adjoint() << 1, 0, 2;
+    yv.get_adjoint() << 0, 1, -1;
+    auto res = f(xv, yv);
+
+    for (int k = 0; k < 3; ++k) {
+        ForwardVar<double> xs(1.3, xv.get_adjoint()(k));
+        ForwardVar<double> ys(0.7, yv.get_adjoint()(k));
+        auto res_s = f(xs, ys);
+        EXPECT_DOUBLE_EQ(res.get_value(), res_s.get_value());
+        EXPECT_DOUBLE_EQ(res.get_adjoint()(k), res_s.get_adjoint());
+    }
+}
+
+TEST_F(adforward_fixture, abs)
+{
+    ForwardVar<double> x(-2, 1);
+    ForwardVar<double> res = ad::abs(x);
+    EXPECT_DOUBLE_EQ(res.get_value(), 2.);
+    EXPECT_DOUBLE_EQ(res.get_adjoint(), -1.);
+    x.set_value(3);
+    res = ad::abs(x);
+    EXPECT_DOUBLE_EQ(res.get_value(), 3.);
+    EXPECT_DOUBLE_EQ(res.get_adjoint(), 1.);
+}
+
+TEST_F(adforward_fixture, compare)
+{
+    ForwardVar<double> x(2, 1), y(3, -5);
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_FALSE(x > y);
+    EXPECT_FALSE(x == y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == 2.);       // tangents are ignored
+    EXPECT_TRUE(1 < x);
+}
+
+////////////////////////////////////////////////////////////
+// Eigen integration
+////////////////////////////////////////////////////////////
+
+struct adforward_eigen_fixture: ::testing::Test
+{
+protected:
+    using fvar_t = ForwardVar<double>;
+    using fmat_t = Eigen::Matrix<fvar_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using fvec_t = Eigen::Matrix<fvar_t, Eigen::Dynamic, 1>;
+
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd dA;
+    Eigen::VectorXd b;
+    fmat_t Af;
+    fvec_t bf;
+
+    adforward_eigen_fixture()
+        : A(3, 3), dA(3, 3), b(3), Af(3, 3), bf(3)
+    {
+        A << 4, 1, 0.5,
+             1, 3, 0.2,
+             0.5, 0.2, 2;
+        dA << 1, 0.3, 0,
+              0.3, -1, 0.1,
+              0, 0.1, 0.5;
+        b << 1, 2, 3;
+        // differentiate in the (symmetric) direction dA
+        for (int i = 0; i < A.size(); ++i) {
+            Af(i) = fvar_t(A(i), dA(i));
+        }
+        bf = b.cast<fvar_t>();
+    }
+};
+
+TEST_F(adforward_eigen_fixture, product)
+{
+    fmat_t res = Af * Af;
+    Eigen::MatrixXd val = A * A;
+    Eigen::MatrixXd tan = dA * A + A * dA;
+    for (int i = 0; i < val.size(); ++i) {
+        EXPECT_NEAR(res(i).get_value(), val(i), 1e-14);
+        EXPECT_NEAR(res(i).get_adjoint(), tan(i), 1e-14);
+    }
+}
+
+TEST_F(adforward_eigen_fixture, mixed_scalar)
+{
+    fmat_t res = (Af * 2. + A.cast<fvar_t>()).array() * A.array();
+    for (int i = 0; i < A.size(); ++i) {
+        EXPECT_DOUBLE_EQ(res(i).get_value(), 3 * A(i) * A(i));
+        EXPECT_DOUBLE_EQ(res(i).get_adjoint(), 2 * dA(i) * A(i));
+    }
+}
+
+TEST_F(adforward_eigen_fixture, llt_solve)
+{
+    // x = A^{-1} b => dx = -A^{-1} dA x
+    fvec_t res = Af.llt().solve(bf);
+    Eigen::VectorXd x = A.llt().solve(b);
+    Eigen::VectorXd dx = -A.llt().solve(dA * x);
+    for (int i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(res(i).get_value(), x(i), 1e-14);
+        EXPECT_NEAR(res(i).get_adjoint(), dx(i), 1e-14);
+    }
+}
+
+TEST_F(adforward_eigen_fixture, lu_determinant)
+{
+    // d det(A) = det(A) tr(A^{-1} dA)
+    fvar_t res = Af.partialPivLu().determinant();
+    double det = A.determinant();
+    double ddet = det * (A.inverse() * dA).trace();
+    EXPECT_NEAR(res.get_value(), det, 1e-12);
+    EXPECT_NEAR(res.get_adjoint(), ddet, 1e-12);
+}
+
+TEST_F(adforward_eigen_fixture, vec_mode)
+{
+    // two directions at once: dA and identity
+    using fvar2_t = ForwardVar<double, 2>;
+    Eigen::Matrix<fvar2_t, Eigen::Dynamic, Eigen::Dynamic> A2(3, 3);
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            A2(i,j) = fvar2_t(A(i,j));
+            A2(i,j).get_adjoint() << dA(i,j), (i == j);
+        }
+    }
+    fvar2_t res = (A2 * A2).trace();
+    EXPECT_NEAR(res.get_value(), (A * A).trace(), 1e-14);
+    EXPECT_NEAR(res.get_adjoint()(0), 2 * (A * dA).trace(), 1e-14);
+    EXPECT_NEAR(res.get_adjoint()(1), 2 * A.trace(), 1e-14);
+}
+
 } // namespace ad
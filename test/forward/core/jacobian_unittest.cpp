@@ -0,0 +1,113 @@
+#include <cmath>
+#include <vector>
+#include <fastad_bits/forward/core/jacobian.hpp>
+#include "gtest/gtest.h"
+
+namespace ad {
+
+struct forward_jacobian_fixture: ::testing::Test
+{
+protected:
+    Eigen::VectorXd x;
+    Eigen::MatrixXd J;
+
+    forward_jacobian_fixture()
+        : x(5)
+    {
+        x << 0.3, -1.2, 2.1, 0.5, 1.7;
+    }
+
+    // f(x)_i = sin(x_i) * x_{i+1} for i < n-1, f(x)_{n-1} = prod_j x_j
+    template <class VecType>
+    static auto f(const VecType& x)
+    {
+        using fvar_t = typename VecType::Scalar;
+        size_t n = x.size();
+        Eigen::Matrix<fvar_t, Eigen::Dynamic, 1> y(n);
+        fvar_t prod(1);
+        for (size_t i = 0; i < n; ++i) {
+            if (i + 1 < n) y(i) = ad::sin(x(i)) * x(i+1);
+            prod *= x(i);
+        }
+        y(n-1) = prod;
+        return y;
+    }
+
+    void check_f(const Eigen::VectorXd& res)
+    {
+        size_t n = x.size();
+        ASSERT_EQ(static_cast<size_t>(res.size()), n);
+        ASSERT_EQ(static_cast<size_t>(J.rows()), n);
+        ASSERT_EQ(static_cast<size_t>(J.cols()), n);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            EXPECT_DOUBLE_EQ(res(i), std::sin(x(i)) * x(i+1));
+            for (size_t j = 0; j < n; ++j) {
+                double actual = 0;
+                if (j == i) actual = std::cos(x(i)) * x(i+1);
+                else if (j == i + 1) actual = std::sin(x(i));
+                EXPECT_DOUBLE_EQ(J(i,j), actual);
+            }
+        }
+        double prod = x.prod();
+        EXPECT_DOUBLE_EQ(res(n-1), prod);
+        for (size_t j = 0; j < n; ++j) {
+            EXPECT_NEAR(J(n-1,j), prod / x(j), 1e-14);
+        }
+    }
+};
+
+TEST_F(forward_jacobian_fixture, scalar_mode)
+{
+    Eigen::VectorXd res = ad::forward_jacobian<1>(
+            [](const auto& x) { return f(x); }, x, J);
+    check_f(res);
+}
+
+TEST_F(forward_jacobian_fixture, vec_mode_uneven_chunks)
+{
+    // 5 inputs with 2 tangents: last chunk only uses one tangent
+    Eigen::VectorXd res = ad::forward_jacobian<2>(
+            [](const auto& x) { return f(x); }, x, J);
+    check_f(res);
+}
+
+TEST_F(forward_jacobian_fixture, vec_mode_single_chunk)
+{
+    Eigen::VectorXd res = ad::forward_jacobian<8>(
+            [](const auto& x) { return f(x); }, x, J);
+    check_f(res);
+}
+
+TEST_F(forward_jacobian_fixture, scalar_output)
+{
+    auto g = [](const auto& x) {
+        return ad::exp(x(0)) * x(1) - x(2) / x(3) + x(4);
+    };
+    Eigen::VectorXd res = ad::forward_jacobian(g, x, J);
+    ASSERT_EQ(res.size(), 1);
+    EXPECT_DOUBLE_EQ(res(0), std::exp(x(0)) * x(1) - x(2) / x(3) + x(4));
+    ASSERT_EQ(J.rows(), 1);
+    ASSERT_EQ(J.cols(), 5);
+    EXPECT_DOUBLE_EQ(J(0,0), std::exp(x(0)) * x(1));
+    EXPECT_DOUBLE_EQ(J(0,1), std::exp(x(0)));
+    EXPECT_DOUBLE_EQ(J(0,2), -1. / x(3));
+    EXPECT_DOUBLE_EQ(J(0,3), x(2) / (x(3) * x(3)));
+    EXPECT_DOUBLE_EQ(J(0,4), 1.);
+}
+
+TEST_F(forward_jacobian_fixture, std_vector_output)
+{
+    auto g = [](const auto& x) {
+        using fvar_t = std::decay_t<decltype(x(0))>;
+        return std::vector<fvar_t>{x(0) * x(1), ad::log(x(2))};
+    };
+    Eigen::VectorXd res = ad::forward_jacobian<4>(g, x, J);
+    ASSERT_EQ(res.size(), 2);
+    EXPECT_DOUBLE_EQ(res(1), std::log(x(2)));
+    EXPECT_DOUBLE_EQ(J(0,0), x(1));
+    EXPECT_DOUBLE_EQ(J(0,1), x(0));
+    EXPECT_DOUBLE_EQ(J(1,2), 1. / x(2));
+    EXPECT_DOUBLE_EQ(J(1,4), 0.);
+}
+
+} // namespace ad
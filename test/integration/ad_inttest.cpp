@@ -155,5 +155,69 @@ TEST_F(ad_fixture, function_vector_complex) {
     autodiff(expr);
 }
 
+// Batch mode: every lane must match the scalar evaluation
+TEST_F(ad_fixture, F_batch_test) {
+    using batch_t = ad::Batch<double, 4>;
+    std::array<ad::Var<batch_t>, 5> x;
+    std::array<ad::Var<batch_t>, 10> wb;
+    for (size_t i = 0; i < x.size(); ++i) {
+        for (size_t k = 0; k < 4; ++k) {
+            x[i].get()[k] = val[i] + 0.1 * k;
+        }
+    }
+    auto expr = ad::bind(F_lmda(x, wb));
+    batch_t res = autodiff(expr);
+    for (size_t k = 0; k < 4; ++k) {
+        std::array<double, 5> val_k;
+        std::array<double, 5> adj_k;
+        for (size_t i = 0; i < x.size(); ++i) {
+            val_k[i] = x[i].get()[k];
+            adj_k[i] = x[i].get_adj()[k];
+        }
+        EXPECT_DOUBLE_EQ(res[k], std::sin(val_k[0])*std::cos(val_k[1]) +
+                                 val_k[2] + val_k[3]*val_k[4]);
+        f_test(val_k, adj_k);
+    }
+}
+
+TEST_F(ad_fixture, G_batch_test) {
+    using batch_t = ad::Batch<double, 2>;
+    std::array<ad::Var<batch_t>, 5> x;
+    std::array<ad::Var<batch_t>, 10> wb;
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i].get()[0] = val[i];
+        x[i].get()[1] = -val[i];
+    }
+    auto expr = ad::bind(G_lmda(x, wb));
+    autodiff(expr);
+    for (size_t k = 0; k < 2; ++k) {
+        std::array<double, 5> val_k;
+        std::array<double, 5> adj_k;
+        for (size_t i = 0; i < x.size(); ++i) {
+            val_k[i] = x[i].get()[k];
+            adj_k[i] = x[i].get_adj()[k];
+        }
+        g_test(val_k, adj_k);
+    }
+}
+
+TEST_F(ad_fixture, batch_lane_sum_test) {
+    // gradient of sum over points of (w * x_k - y_k)^2 w.r.t. shared w
+    using batch_t = ad::Batch<double, 4>;
+    ad::Var<batch_t> w_b(batch_t(0.7));
+    batch_t x_b;
+    batch_t y_b;
+    double actual = 0;
+    for (size_t k = 0; k < 4; ++k) {
+        x_b[k] = 1. + k;
+        y_b[k] = 2. - 0.5 * k;
+        actual += 2. * (0.7 * x_b[k] - y_b[k]) * x_b[k];
+    }
+    auto r = w_b * ad::constant(x_b) - ad::constant(y_b);
+    auto expr = ad::bind(r * r);
+    autodiff(expr);
+    EXPECT_DOUBLE_EQ(ad::lane_sum(w_b.get_adj()), actual);
+}
+
 } // namespace core
 } // namespace ad
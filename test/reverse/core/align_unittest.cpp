@@ -0,0 +1,105 @@
+#define FASTAD_CACHE_ALIGN 64
+#include <testutil/base_fixture.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+
+namespace ad {
+
+struct align_fixture : base_fixture
+{
+protected:
+    static constexpr size_t align_elems = 64 / sizeof(value_t);
+    static constexpr size_t size = 5;
+
+    vec_expr_t x{size}, y{size};
+    scl_expr_t w{3.0};
+
+    align_fixture()
+        : base_fixture()
+    {
+        for (size_t i = 0; i < size; ++i) {
+            x.get()(i) = i + 1.;
+            y.get()(i) = 2. * i - 1.;
+        }
+    }
+
+    static bool is_aligned(const value_t* ptr)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0;
+    }
+};
+
+TEST_F(align_fixture, cache_slot_size)
+{
+    // scalar slots are never padded
+    size_t scl_size = util::cache_slot_size<value_t, scl>(1);
+    size_t vec_size = util::cache_slot_size<value_t, vec>(size);
+    size_t mat_size = util::cache_slot_size<value_t, mat>(size);
+    EXPECT_EQ(scl_size, 1ul);
+    EXPECT_EQ(vec_size, size + align_elems - 1);
+    EXPECT_EQ(mat_size, size + align_elems - 1);
+}
+
+TEST_F(align_fixture, bind_cache_size_padded)
+{
+    using unary_t = core::UnaryNode<MockUnary, vec_expr_view_t>;
+    unary_t expr(x);
+    auto size_pack = expr.bind_cache_size();
+    EXPECT_EQ(size_pack(0), size + align_elems - 1);
+    EXPECT_EQ(size_pack(1), size + align_elems - 1);
+}
+
+TEST_F(align_fixture, bind_aligned)
+{
+    using unary_t = core::UnaryNode<MockUnary, vec_expr_view_t>;
+    using binary_t = core::BinaryNode<MockBinary, unary_t, vec_expr_view_t>;
+    binary_t expr(unary_t(x), y);
+    auto size_pack = expr.bind_cache_size();
+
+    // deliberately misalign the beginning of the cache
+    std::vector<value_t> val(size_pack(0) + 1);
+    std::vector<value_t> adj(size_pack(1) + 1);
+    ptr_pack_t begin(val.data() + 1, adj.data() + 1);
+    ptr_pack_t end = expr.bind_cache(begin);
+
+    EXPECT_TRUE(is_aligned(expr.data()));
+    EXPECT_TRUE(is_aligned(expr.data_adj()));
+    EXPECT_EQ(end.val, begin.val + size_pack(0));
+    EXPECT_EQ(end.adj, begin.adj + size_pack(1));
+}
+
+TEST_F(align_fixture, autodiff_vec)
+{
+    // f(x, y) = sum(2x - 2y)
+    auto expr = ad::bind(ad::sum(core::BinaryNode<MockBinary,
+                core::UnaryNode<MockUnary, vec_expr_view_t>,
+                vec_expr_view_t>(core::UnaryNode<MockUnary, vec_expr_view_t>(x), y)));
+    value_t res = ad::autodiff(expr);
+    EXPECT_DOUBLE_EQ(res, 2. * (x.get().sum() - y.get().sum()));
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_DOUBLE_EQ(x.get_adj(i,0), 2.);
+        EXPECT_DOUBLE_EQ(y.get_adj(i,0), -2.);
+    }
+}
+
+TEST_F(align_fixture, autodiff_eq_placeholder)
+{
+    // root of the expression is rebound to the placeholder, which need not be aligned
+    std::vector<value_t> val(size + 1), adj(size + 1);
+    vec_expr_view_t z(val.data() + 1, adj.data() + 1, size);
+    using unary_t = core::UnaryNode<MockUnary, vec_expr_view_t>;
+    auto expr = ad::bind((z = unary_t(x), ad::sum(z)));
+    value_t res = ad::autodiff(expr);
+    EXPECT_DOUBLE_EQ(res, 2. * x.get().sum());
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_DOUBLE_EQ(z.get(i,0), 2. * x.get(i,0));
+        EXPECT_DOUBLE_EQ(x.get_adj(i,0), 2.);
+    }
+}
+
+} // namespace ad
@@ -0,0 +1,201 @@
+#define FASTAD_ALLOC_TRACKER_DEFINE_NEW
+#include <fastad_bits/util/alloc_tracker.hpp>
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+#include <fastad>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+
+namespace ad {
+
+struct alloc_fixture : ::testing::Test
+{
+protected:
+    using value_t = double;
+    static constexpr size_t size = 5;
+
+    Var<value_t> s{0.3}, t{1.5};
+    Var<value_t, vec> x{size}, y{size};
+    Var<value_t, mat> A{size, size}, S{size, size};
+    std::vector<Var<value_t>> vs;
+
+    alloc_fixture()
+        : vs(size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            x.get()(i) = 0.5 * i - 1.;
+            y.get()(i) = i + 2.;
+            vs[i].get() = i + 1.;
+            for (size_t j = 0; j < size; ++j) {
+                A.get()(i,j) = (i == j) ? 3. : 1. / (i + j + 1.);
+            }
+        }
+        S.get() = A.get() * A.get().transpose();
+    }
+
+    // Checks that neither forward evaluation nor a full autodiff
+    // allocates once the expression has been bound.
+    template <class ExprType>
+    void check_no_alloc(ExprType&& e)
+    {
+        auto expr = ad::bind(std::forward<ExprType>(e));
+        ad::autodiff(expr);
+
+        util::AllocTracker tracker;
+        ad::evaluate(expr);
+        auto fwd = tracker.stats();
+        tracker.reset();
+        ad::autodiff(expr);
+        auto bwd = tracker.stats();
+
+        EXPECT_EQ(fwd.total(), 0ul);
+        EXPECT_EQ(bwd.total(), 0ul);
+    }
+};
+
+TEST_F(alloc_fixture, tracker_counts_new)
+{
+    util::AllocTracker tracker;
+    auto p = std::make_unique<std::vector<value_t>>(10);
+    auto stats = tracker.stats();
+    EXPECT_EQ(stats.count, 2ul);
+    EXPECT_GE(stats.bytes, 10 * sizeof(value_t));
+    EXPECT_EQ(stats.eigen_count, 0ul);
+}
+
+TEST_F(alloc_fixture, tracker_counts_eigen)
+{
+    util::AllocTracker tracker;
+    Eigen::MatrixXd m(3, 3);
+    m.setZero();
+    auto stats = tracker.stats();
+    EXPECT_EQ(stats.count, 0ul);
+    EXPECT_EQ(stats.eigen_count, 1ul);
+}
+
+TEST_F(alloc_fixture, tracker_restores_eigen)
+{
+    {
+        util::AllocTracker tracker;
+        EXPECT_FALSE(Eigen::internal::is_malloc_allowed());
+    }
+    EXPECT_TRUE(Eigen::internal::is_malloc_allowed());
+}
+
+TEST_F(alloc_fixture, unary)
+{
+    check_no_alloc(ad::sum(ad::exp(ad::sin(x))));
+}
+
+TEST_F(alloc_fixture, binary)
+{
+    check_no_alloc(ad::sum(x * y + s));
+}
+
+TEST_F(alloc_fixture, fuse)
+{
+    check_no_alloc(ad::sum(ad::fuse(ad::exp(s * x + y) * x)));
+}
+
+TEST_F(alloc_fixture, dot)
+{
+    check_no_alloc(ad::sum(ad::dot(A, ad::sin(x))));
+    check_no_alloc(ad::sum(ad::dot(A, A)));
+}
+
+TEST_F(alloc_fixture, det)
+{
+    check_no_alloc(ad::det(A));
+    check_no_alloc(ad::det<DetLLT>(S));
+    check_no_alloc(ad::det<DetLDLT>(S));
+}
+
+TEST_F(alloc_fixture, log_det)
+{
+    check_no_alloc(ad::log_det(A));
+    check_no_alloc(ad::log_det<LogDetLLT>(S));
+    check_no_alloc(ad::log_det<LogDetLDLT>(S));
+}
+
+TEST_F(alloc_fixture, pow)
+{
+    check_no_alloc(ad::sum(ad::pow<3>(x)));
+}
+
+TEST_F(alloc_fixture, norm)
+{
+    check_no_alloc(ad::norm(x));
+}
+
+TEST_F(alloc_fixture, transpose)
+{
+    check_no_alloc(ad::sum(ad::transpose(A)));
+}
+
+TEST_F(alloc_fixture, if_else)
+{
+    check_no_alloc(ad::if_else(s < t, s * t, t));
+}
+
+TEST_F(alloc_fixture, eq_glue)
+{
+    Var<value_t> w;
+    check_no_alloc((w = s * t, w * s));
+}
+
+TEST_F(alloc_fixture, sum_prod)
+{
+    check_no_alloc(ad::sum(vs.begin(), vs.end(),
+                [](const auto& v) { return v * v; }));
+    check_no_alloc(ad::prod(vs.begin(), vs.end(),
+                [](const auto& v) { return v; }));
+    check_no_alloc(ad::prod(y));
+}
+
+// the slots of the adjoint scratches are resolved at bind time,
+// so even the first backward evaluation does not allocate
+TEST_F(alloc_fixture, par_sum)
+{
+    util::ThreadPool pool(4);
+    auto expr = ad::bind(ad::sum(pool, vs.begin(), vs.end(),
+                [&](const auto& v) { return v * s + t; }));
+
+    util::AllocTracker tracker;
+    ad::autodiff(expr);
+    EXPECT_EQ(tracker.stats().total(), 0ul);
+}
+
+TEST_F(alloc_fixture, normal)
+{
+    check_no_alloc(ad::normal_adj_log_pdf(x, s, t));
+    check_no_alloc(ad::normal_adj_log_pdf(x, y, y));
+    check_no_alloc(ad::normal_adj_log_pdf(x, s, S));
+    check_no_alloc(ad::normal_adj_log_pdf(x, y, S));
+    check_no_alloc(ad::normal_adj_log_pdf(A, y, S));
+    check_no_alloc(ad::normal_cholesky_adj_log_pdf(x, y, A));
+    check_no_alloc(ad::normal_cholesky_adj_log_pdf(A, y, A));
+}
+
+TEST_F(alloc_fixture, shared_factorizations)
+{
+    auto expr = ad::bind(ad::log_det<LogDetLLT>(S) + 
+                         ad::normal_adj_log_pdf(x, y, S) +
+                         ad::wishart_adj_log_pdf(ad::dot(A, ad::transpose(A)), S, 10.));
+    EXPECT_EQ(ad::share_factorizations(expr), 2ul);
+    ad::autodiff(expr);
+
+    util::AllocTracker tracker;
+    ad::autodiff(expr);
+    EXPECT_EQ(tracker.stats().total(), 0ul);
+}
+
+TEST_F(alloc_fixture, other_stat)
+{
+    check_no_alloc(ad::cauchy_adj_log_pdf(x, s, t));
+    check_no_alloc(ad::uniform_adj_log_pdf(x, -5., 5.));
+    check_no_alloc(ad::bernoulli_adj_log_pdf(0., s));
+    check_no_alloc(ad::wishart_adj_log_pdf(S, S, 10.));
+}
+
+} // namespace ad
@@ -3,7 +3,12 @@
 #include <fastad_bits/reverse/core/eq.hpp>
 #include <fastad_bits/reverse/core/binary.hpp>
 #include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/scan.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
 #include <fastad_bits/reverse/core/eval.hpp>
+#include <thread>
+#include <vector>
 
 namespace ad {
 
@@ -58,4 +63,231 @@ TEST_F(bind_fixture, bind_test_rref)
     test(make_expr_bind());
 }
 
+TEST_F(bind_fixture, bind_test_user_storage) 
+{
+    auto expr = (w3 = w1 * w2, w4 = w3 * w3);
+    auto size_pack = expr.bind_cache_size();
+    std::vector<value_t> val(size_pack(0));
+    std::vector<value_t> adj(size_pack(1));
+    test(ad::bind(expr, val.data(), adj.data()));
+}
+
+TEST_F(bind_fixture, bind_test_arena) 
+{
+    util::Arena arena;
+    auto expr = (w3 = w1 * w2, w4 = w3 * w3);
+    for (int i = 0; i < 3; ++i) {
+        w1.reset_adj();
+        w2.reset_adj();
+        w3.reset_adj();
+        w4.reset_adj();
+        test(ad::bind(expr, arena));
+        arena.reset();
+    }
+    // every bind reused the same chunk
+    EXPECT_EQ(arena.n_chunks(), 1ul);
+}
+
+TEST_F(bind_fixture, bind_test_zero_adjoints) 
+{
+    auto expr_bind = make_expr_bind();
+    test(expr_bind);
+    // without reset, adjoints of wi's would accumulate
+    expr_bind.zero_adjoints();
+    test(expr_bind);
+}
+
+TEST_F(bind_fixture, bind_test_autodiff_zero_adjoints) 
+{
+    auto expr_bind = make_expr_bind();
+    for (int i = 0; i < 3; ++i) {
+        value_t res = ad::autodiff(expr_bind, ad::zero_adjoints);
+        EXPECT_DOUBLE_EQ(res, 4.);
+        EXPECT_DOUBLE_EQ(w4.get_adj(0,0), 1.0);
+        EXPECT_DOUBLE_EQ(w3.get_adj(0,0), 2 * w3.get());
+        EXPECT_DOUBLE_EQ(w2.get_adj(0,0), 2 * w2.get()*w1.get()*w1.get());
+        EXPECT_DOUBLE_EQ(w1.get_adj(0,0), 2 * w1.get()*w2.get()*w2.get());
+    }
+}
+
+TEST_F(bind_fixture, bind_test_zero_adjoints_contiguous) 
+{
+    // leaves viewing one contiguous buffer are zeroed together
+    std::vector<value_t> val(10, 2.), adj(10, 0.);
+    std::vector<VarView<value_t>> ws;
+    for (size_t i = 0; i < val.size(); ++i) {
+        ws.emplace_back(&val[i], &adj[i]);
+    }
+    auto expr_bind = ad::bind(ad::sum(ws.begin(), ws.end(),
+                                      [](const auto& w) { return w * w; }));
+    for (int i = 0; i < 2; ++i) {
+        value_t res = ad::autodiff(expr_bind, ad::zero_adjoints);
+        EXPECT_DOUBLE_EQ(res, 40.);
+        for (value_t a : adj) {
+            EXPECT_DOUBLE_EQ(a, 4.);
+        }
+    }
+}
+
+TEST_F(bind_fixture, bind_test_move) 
+{
+    auto expr_bind = make_expr_bind();
+    auto moved = std::move(expr_bind);
+    test(moved);
+
+    auto assigned = make_expr_bind();
+    assigned = std::move(moved);
+    w1.reset_adj();
+    w2.reset_adj();
+    w3.reset_adj();
+    w4.reset_adj();
+    test(assigned);
+}
+
+TEST_F(bind_fixture, bind_test_copy) 
+{
+    auto expr = (w3 = w1 * w2, w4 = w3 * w3);
+    auto size_pack = expr.bind_cache_size();
+    std::vector<value_t> val(size_pack(0));
+    std::vector<value_t> adj(size_pack(1));
+    auto expr_bind = ad::bind(expr, val.data(), adj.data());
+
+    // copy does not depend on the original storage
+    auto copy = expr_bind;
+    std::fill(val.begin(), val.end(), 0.);
+    std::fill(adj.begin(), adj.end(), 0.);
+    test(copy);
+
+    auto assigned = make_expr_bind();
+    assigned = copy;
+    w1.reset_adj();
+    w2.reset_adj();
+    w3.reset_adj();
+    w4.reset_adj();
+    test(assigned);
+
+    // copy binds to its own cache
+    auto unary_bind = ad::bind(ad::sin(w1) * w2);
+    auto unary_copy = unary_bind;
+    EXPECT_NE(unary_copy.cache().val, unary_bind.cache().val);
+    EXPECT_NE(unary_copy.cache().adj, unary_bind.cache().adj);
+    EXPECT_DOUBLE_EQ(ad::evaluate(unary_copy), std::sin(1.) * 2.);
+}
+
+TEST_F(bind_fixture, bind_test_clone_buffer) 
+{
+    // parameters x, y and placeholder z in one contiguous buffer
+    std::vector<value_t> val = {1., 2., 0.}, adj(3, 0.);
+    VarView<value_t> x(&val[0], &adj[0]), y(&val[1], &adj[1]), z(&val[2], &adj[2]);
+    auto expr_bind = ad::bind((z = x * y, z * z + x));
+
+    std::vector<value_t> local_val = {3., 4., 0.}, local_adj(3, 0.);
+    auto local = expr_bind.clone({val.data(), adj.data()}, val.size(),
+                                 {local_val.data(), local_adj.data()});
+
+    EXPECT_DOUBLE_EQ(ad::autodiff(local), 147.);
+    EXPECT_DOUBLE_EQ(local_val[2], 12.);
+    EXPECT_DOUBLE_EQ(local_adj[0], 2. * 12. * 4. + 1.);
+    EXPECT_DOUBLE_EQ(local_adj[1], 2. * 12. * 3.);
+
+    // original is untouched
+    EXPECT_DOUBLE_EQ(val[2], 0.);
+    EXPECT_DOUBLE_EQ(adj[0], 0.);
+    EXPECT_DOUBLE_EQ(ad::autodiff(expr_bind), 5.);
+    EXPECT_DOUBLE_EQ(adj[0], 2. * 2. * 2. + 1.);
+}
+
+TEST_F(bind_fixture, bind_test_clone_threads) 
+{
+    constexpr size_t n_threads = 4;
+    std::vector<value_t> val = {1., 2., 0.}, adj(3, 0.);
+    VarView<value_t> x(&val[0], &adj[0]), y(&val[1], &adj[1]), z(&val[2], &adj[2]);
+    auto expr_bind = ad::bind((z = x * y, z * z + x));
+
+    // every thread has its own parameters, placeholder and cache
+    std::vector<std::vector<value_t>> vals(n_threads), adjs(n_threads);
+    std::vector<value_t> res(n_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; ++t) {
+        vals[t] = {t + 1., 2., 0.};
+        adjs[t].assign(3, 0.);
+        threads.emplace_back([&, t]() {
+            auto local = expr_bind.clone({val.data(), adj.data()}, val.size(),
+                                         {vals[t].data(), adjs[t].data()});
+            for (int i = 0; i < 100; ++i) {
+                res[t] = ad::autodiff(local, ad::zero_adjoints);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (size_t t = 0; t < n_threads; ++t) {
+        value_t xt = t + 1.;
+        EXPECT_DOUBLE_EQ(res[t], 4. * xt * xt + xt);
+        EXPECT_DOUBLE_EQ(adjs[t][0], 8. * xt + 1.);
+        EXPECT_DOUBLE_EQ(adjs[t][1], 4. * xt * xt);
+    }
+    EXPECT_DOUBLE_EQ(adj[0], 0.);
+}
+
+TEST_F(bind_fixture, bind_test_clone_threads_scan) 
+{
+    constexpr size_t n_threads = 4;
+    constexpr size_t n_steps = 20;
+    std::vector<value_t> val = {0.5, 1.}, adj(2, 0.);
+    VarView<value_t> a(&val[0], &adj[0]), b(&val[1], &adj[1]);
+    // x_t = a x_{t-1} + b, x_0 = b
+    auto expr_bind = ad::bind(ad::scan(
+                [&](const auto& x) { return a * x + b; }, b, n_steps));
+
+    // every clone has its own scan buffers
+    std::vector<std::vector<value_t>> vals(n_threads), adjs(n_threads);
+    std::vector<value_t> res(n_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; ++t) {
+        vals[t] = {0.1 * (t + 1), 1.};
+        adjs[t].assign(2, 0.);
+        threads.emplace_back([&, t]() {
+            auto local = expr_bind.clone({val.data(), adj.data()}, val.size(),
+                                         {vals[t].data(), adjs[t].data()});
+            for (int i = 0; i < 100; ++i) {
+                res[t] = ad::autodiff(local, ad::zero_adjoints);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (size_t t = 0; t < n_threads; ++t) {
+        // x_T = sum_{k=0}^T a^k and b = 1
+        value_t at = 0.1 * (t + 1);
+        value_t x = 0, dx_da = 0;
+        for (size_t k = 0; k <= n_steps; ++k) {
+            x += std::pow(at, k);
+            if (k > 0) dx_da += k * std::pow(at, k - 1);
+        }
+        EXPECT_NEAR(res[t], x, 1e-12);
+        EXPECT_NEAR(adjs[t][0], dx_da, 1e-10);
+        EXPECT_NEAR(adjs[t][1], x, 1e-12);
+    }
+    EXPECT_DOUBLE_EQ(adj[0], 0.);
+}
+
+TEST_F(bind_fixture, bind_test_clone_functor) 
+{
+    auto expr_bind = make_expr_bind();
+    Var<value_t> v1{1.0}, v2{2.0}, v3{3.0}, v4{4.0};
+    auto local = expr_bind.clone([&](auto& leaf) {
+        for (auto* p : {&w1, &w2, &w3, &w4}) {
+            if (leaf.data() == p->data()) {
+                auto* q = (p == &w1) ? &v1 : (p == &w2) ? &v2 : (p == &w3) ? &v3 : &v4;
+                leaf.bind(util::PtrPack<value_t>(q->data(), q->data_adj()));
+                return;
+            }
+        }
+    });
+    EXPECT_DOUBLE_EQ(ad::autodiff(local), 4.);
+    EXPECT_DOUBLE_EQ(v1.get_adj(0,0), 8.);
+    EXPECT_DOUBLE_EQ(w1.get_adj(0,0), 0.);
+}
+
 } // namespace ad
@@ -178,6 +178,29 @@ TEST_F(dot_fixture, dot_constant_var_beval)
     check_eq(radj, vec_expr.get_adj());
 }
 
+TEST_F(dot_fixture, dot_bind_cache_size)
+{
+    // VarViews are accumulated into directly and need no gradient buffer
+    EXPECT_EQ(dot_vars.bind_cache_size()(1), dot_vars.single_bind_cache_size()(1));
+
+    // other expressions need a gradient buffer of their own size
+    size_t unary_adj = dot_unary.single_bind_cache_size()(1) + 
+                       2 * (mat_expr.size() + vec_expr.size());
+    EXPECT_EQ(dot_unary.bind_cache_size()(1), unary_adj);
+}
+
+TEST_F(dot_fixture, dot_vars_beval_accumulates)
+{
+    // adjoints of VarViews are accumulated, not overwritten
+    dot_vars.feval();
+    dot_vars.beval(vseed);
+    dot_vars.beval(vseed);
+    Eigen::MatrixXd ladj = 2. * vseed.matrix() * vec_expr.get().transpose();
+    Eigen::VectorXd radj = 2. * mat_expr.get().transpose() * vseed.matrix();
+    check_eq(ladj, mat_expr.get_adj());
+    check_eq(radj, vec_expr.get_adj());
+}
+
 TEST_F(dot_fixture, dot_constant)
 {
     auto vec_const = ad::constant(vec_expr.get());
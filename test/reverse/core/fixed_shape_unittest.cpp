@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+
+struct fixed_shape_fixture : ::testing::Test
+{
+protected:
+    using value_t = double;
+    using fvec_t = Var<value_t, fixed_vec<3>>;
+    using fmat_t = Var<value_t, fixed_mat<3,3>>;
+
+    fvec_t x;
+    fmat_t A;
+    Var<value_t, vec> xd{3};
+    Var<value_t, mat> Ad{3,3};
+
+    fixed_shape_fixture()
+    {
+        x.get() << 1., -2., 0.5;
+        A.get() << 2., 1., 0.,
+                   1., 3., 1.,
+                   0., 1., 4.;
+        xd.get() = x.get();
+        Ad.get() = A.get();
+    }
+
+    // f(A, x) = sum(Ax * sin(x)) + det(A) + log_det(A) + sum(A * A)
+    template <class MatType, class VecType>
+    static auto make_expr(MatType& A, VecType& x)
+    {
+        return ad::bind(ad::sum(ad::dot(A, x) * ad::sin(x)) +
+                        ad::det(A) + 
+                        ad::log_det<LogDetLLT>(A) +
+                        ad::sum(ad::dot(A, A)));
+    }
+};
+
+TEST_F(fixed_shape_fixture, shape_traits)
+{
+    static_assert(util::is_vec_v<fvec_t>);
+    static_assert(util::is_mat_v<fmat_t>);
+    static_assert(util::is_fixed_v<fvec_t>);
+    static_assert(!util::is_fixed_v<Var<value_t, vec>>);
+    static_assert(std::is_same_v<util::dynamic_shape_t<fixed_mat<2,3>>, mat>);
+    static_assert(std::is_same_v<util::max_shape_t<fixed_vec<3>, vec>, fixed_vec<3>>);
+    static_assert(std::is_same_v<util::max_shape_t<scl, fixed_mat<2,2>>, fixed_mat<2,2>>);
+    static_assert(std::is_same_v<fvec_t::var_t, 
+                                 Eigen::Map<Eigen::Matrix<value_t, 3, 1>>>);
+}
+
+TEST_F(fixed_shape_fixture, var)
+{
+    EXPECT_EQ(x.size(), 3ul);
+    EXPECT_EQ(A.rows(), 3ul);
+    EXPECT_EQ(A.cols(), 3ul);
+    EXPECT_DOUBLE_EQ(A.get_adj(2,1), 0.);
+
+    fvec_t y = x;
+    EXPECT_NE(y.data(), x.data());
+    EXPECT_DOUBLE_EQ(y.get(1,0), -2.);
+
+    auto x1 = x(1);
+    EXPECT_EQ(x1.data(), x.data() + 1);
+    auto h = x.head(2);
+    EXPECT_EQ(h.size(), 2ul);
+}
+
+TEST_F(fixed_shape_fixture, dot_shape)
+{
+    using mv_shape_t = typename decltype(ad::dot(A, x))::shape_t;
+    using mm_shape_t = typename decltype(ad::dot(A, A))::shape_t;
+    using mixed_shape_t = typename decltype(ad::dot(Ad, x))::shape_t;
+    static_assert(std::is_same_v<mv_shape_t, fixed_vec<3>>);
+    static_assert(std::is_same_v<mm_shape_t, fixed_mat<3,3>>);
+    static_assert(std::is_same_v<mixed_shape_t, vec>);
+}
+
+TEST_F(fixed_shape_fixture, autodiff)
+{
+    auto expr = make_expr(A, x);
+    auto dexpr = make_expr(Ad, xd);
+    value_t res = ad::autodiff(expr);
+    value_t dres = ad::autodiff(dexpr);
+    EXPECT_NEAR(res, dres, 1e-12);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(x.get_adj(i,0), xd.get_adj(i,0), 1e-12);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(A.get_adj(i,j), Ad.get_adj(i,j), 1e-12);
+        }
+    }
+}
+
+TEST_F(fixed_shape_fixture, mixed_binary)
+{
+    // fixed-size and dynamic expressions of the same size can be mixed
+    auto expr = ad::bind(ad::sum(x * xd));
+    value_t res = ad::autodiff(expr);
+    EXPECT_DOUBLE_EQ(res, x.get().squaredNorm());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(x.get_adj(i,0), x.get()(i));
+        EXPECT_DOUBLE_EQ(xd.get_adj(i,0), x.get()(i));
+    }
+}
+
+} // namespace ad
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/reverse/stat/normal.hpp>
+#include <fastad_bits/reverse/stat/wishart.hpp>
+
+namespace ad {
+
+// Factorizing nodes with a plain float value type (FASTAD_MIXED_PRECISION undefined).
+// Expected values are computed in double.
+struct float_fixture : ::testing::Test
+{
+protected:
+    using value_t = float;
+    using mat_d_t = Eigen::MatrixXd;
+    using vec_d_t = Eigen::VectorXd;
+
+    static_assert(std::is_same_v<util::accum_t<value_t>, value_t>);
+
+    Var<value_t, mat> x;
+    Var<value_t, mat> v;
+    mat_d_t x_d;
+    mat_d_t v_d;
+
+    value_t tol = 1e-4;
+
+    float_fixture()
+        : x(3,3)
+        , v(3,3)
+        , x_d(3,3)
+        , v_d(3,3)
+    {
+        x_d << 10, 2, 3,
+               2, 10, 1,
+               3, 1, 10;
+        v_d << 5, 1, 0,
+               1, 5, 1,
+               0, 1, 5;
+        x.get() = x_d.cast<value_t>();
+        v.get() = v_d.cast<value_t>();
+    }
+
+    template <class T, class U>
+    void check_near(const T& actual, const U& expected, double rel_tol)
+    {
+        ASSERT_EQ(actual.rows(), expected.rows());
+        ASSERT_EQ(actual.cols(), expected.cols());
+        double scale = expected.cwiseAbs().maxCoeff();
+        for (int i = 0; i < expected.rows(); ++i) {
+            for (int j = 0; j < expected.cols(); ++j) {
+                EXPECT_NEAR(actual(i,j), expected(i,j), rel_tol * scale);
+            }
+        }
+    }
+};
+
+TEST_F(float_fixture, det)
+{
+    auto expr = ad::bind(ad::det<DetLLT>(x));
+    value_t res = ad::autodiff(expr);
+    double expected = x_d.determinant();
+    EXPECT_NEAR(res, expected, tol * expected);
+    check_near(x.get_adj(), expected * mat_d_t(x_d.inverse().transpose()), tol);
+}
+
+TEST_F(float_fixture, log_det)
+{
+    auto expr = ad::bind(ad::log_det<LogDetLLT>(x));
+    value_t res = ad::autodiff(expr);
+    EXPECT_NEAR(res, std::log(x_d.determinant()), tol);
+    check_near(x.get_adj(), mat_d_t(x_d.inverse().transpose()), tol);
+}
+
+TEST_F(float_fixture, wishart)
+{
+    value_t n = 4;
+    double p = 3;
+    auto expr = ad::bind(ad::wishart_adj_log_pdf(x, v, n));
+    value_t res = ad::autodiff(expr);
+
+    mat_d_t v_inv = v_d.inverse();
+    double expected = 0.5 * (n-p-1) * std::log(x_d.determinant())
+        - 0.5 * (v_inv * x_d).trace()
+        - 0.5 * n * std::log(v_d.determinant());
+    EXPECT_NEAR(res, expected, tol * std::abs(expected));
+
+    mat_d_t dX = 0.5 * ((n-p-1) * x_d.inverse() - v_inv);
+    mat_d_t dV = 0.5 * ((v_inv * x_d * v_inv) - n * v_inv);
+    check_near(x.get_adj(), dX, tol);
+    check_near(v.get_adj(), dV, tol);
+}
+
+TEST_F(float_fixture, normal_mat_cov)
+{
+    Var<value_t, vec> y(3), mu(3);
+    vec_d_t y_d(3), mu_d(3);
+    y_d << 1, -2, 0.5;
+    mu_d << 0.2, 0.1, -0.3;
+    y.get() = y_d.cast<value_t>();
+    mu.get() = mu_d.cast<value_t>();
+
+    auto expr = ad::bind(ad::normal_adj_log_pdf(y, mu, v));
+    value_t res = ad::autodiff(expr);
+
+    mat_d_t v_inv = v_d.inverse();
+    vec_d_t z = v_inv * (y_d - mu_d);
+    double expected = -0.5 * (y_d - mu_d).dot(z)
+        - 0.5 * std::log(v_d.determinant());
+    EXPECT_NEAR(res, expected, tol * std::abs(expected));
+
+    check_near(y.get_adj(), vec_d_t(-z), tol);
+    check_near(mu.get_adj(), z, tol);
+    mat_d_t dV = 0.5 * (z * z.transpose() - v_inv);
+    check_near(v.get_adj(), dV, tol);
+}
+
+} // namespace ad
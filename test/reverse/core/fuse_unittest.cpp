@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/fuse.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+
+struct fuse_fixture : ::testing::Test
+{
+protected:
+    using value_t = double;
+    static constexpr size_t size = 7;
+
+    // x, y, a, b are used in fused expressions, 
+    // and their copies x2, y2, a2, b2 in the unfused ones.
+    Var<value_t, vec> x{size}, y{size}, x2{size}, y2{size};
+    Var<value_t> a{1.3}, b{-0.4}, a2{1.3}, b2{-0.4};
+    Var<value_t, mat> m{size, 3}, m2{size, 3};
+    Var<value_t, vec> w{3}, w2{3};
+
+    fuse_fixture()
+    {
+        for (size_t i = 0; i < size; ++i) {
+            x.get()(i) = 0.1 * i - 0.2;
+            y.get()(i) = 1. + 0.3 * i;
+        }
+        m.get().setRandom();
+        w.get().setRandom();
+        x2.get() = x.get();
+        y2.get() = y.get();
+        m2.get() = m.get();
+        w2.get() = w.get();
+    }
+
+    template <class T, class U>
+    void check_vec(const T& v, const U& v2)
+    {
+        for (size_t i = 0; i < v.size(); ++i) {
+            EXPECT_NEAR(v.get_adj(i,0), v2.get_adj(i,0), 1e-12);
+        }
+    }
+};
+
+TEST_F(fuse_fixture, is_fusable)
+{
+    using unary_t = decltype(ad::exp(x));
+    using binary_t = decltype(x * y);
+    using dot_t = decltype(ad::dot(m, w));
+    static_assert(core::details::is_fusable_v<unary_t>);
+    static_assert(core::details::is_fusable_v<binary_t>);
+    static_assert(!core::details::is_fusable_v<dot_t>);
+    static_assert(!core::details::is_fusable_v<VarView<value_t, vec>>);
+
+    // non element-wise expressions are left as-is
+    static_assert(std::is_same_v<decltype(ad::fuse(ad::dot(m, w))), dot_t>);
+}
+
+TEST_F(fuse_fixture, bind_cache_size)
+{
+    // only the root is cached
+    auto expr = ad::fuse(ad::exp(a * x + b) * y);
+    auto size_pack = expr.bind_cache_size();
+    EXPECT_EQ(size_pack(0), expr.cache_size());
+    EXPECT_EQ(size_pack(1), expr.cache_size());
+}
+
+TEST_F(fuse_fixture, vec)
+{
+    auto expr = ad::bind(ad::sum(ad::fuse(
+                    ad::exp(a * x + b) * y / (x * x + 1.) - ad::sin(y))));
+    auto expr2 = ad::bind(ad::sum(
+                    ad::exp(a2 * x2 + b2) * y2 / (x2 * x2 + 1.) - ad::sin(y2)));
+    value_t res = ad::autodiff(expr);
+    value_t res2 = ad::autodiff(expr2);
+    EXPECT_NEAR(res, res2, 1e-12);
+    check_vec(x, x2);
+    check_vec(y, y2);
+    EXPECT_NEAR(a.get_adj(), a2.get_adj(), 1e-12);
+    EXPECT_NEAR(b.get_adj(), b2.get_adj(), 1e-12);
+}
+
+TEST_F(fuse_fixture, scl)
+{
+    auto expr = ad::bind(ad::fuse(ad::log(a * a + 1.) * ad::sum(x)));
+    auto expr2 = ad::bind(ad::log(a2 * a2 + 1.) * ad::sum(x2));
+    value_t res = ad::autodiff(expr);
+    value_t res2 = ad::autodiff(expr2);
+    EXPECT_NEAR(res, res2, 1e-12);
+    EXPECT_NEAR(a.get_adj(), a2.get_adj(), 1e-12);
+    check_vec(x, x2);
+}
+
+TEST_F(fuse_fixture, boundary)
+{
+    // the dot product is a boundary of the fused region
+    auto expr = ad::bind(ad::sum(ad::fuse(ad::tanh(ad::dot(m, w) + x) * y)));
+    auto expr2 = ad::bind(ad::sum(ad::tanh(ad::dot(m2, w2) + x2) * y2));
+    value_t res = ad::autodiff(expr);
+    value_t res2 = ad::autodiff(expr2);
+    EXPECT_NEAR(res, res2, 1e-12);
+    check_vec(x, x2);
+    check_vec(y, y2);
+    check_vec(w, w2);
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(m.get_adj(i,j), m2.get_adj(i,j), 1e-12);
+        }
+    }
+}
+
+TEST_F(fuse_fixture, max_depth)
+{
+    using chain_t = decltype(ad::exp(ad::sin(x * y) + x) * y);
+    static_assert(core::details::fused_depth<chain_t>() == 5);
+
+    // split into the regions {*, exp}, {+, sin} and {*}, each one cached
+    auto expr = ad::fuse<2>(ad::exp(ad::sin(x * y) + x) * y);
+    auto size_pack = expr.bind_cache_size();
+    EXPECT_EQ(size_pack(0), 3 * expr.cache_size());
+    EXPECT_EQ(size_pack(1), 3 * expr.cache_size());
+}
+
+TEST_F(fuse_fixture, deep)
+{
+    auto chain = [](const auto& x, const auto& y) {
+        auto e1 = ad::sin(x * y + x) * y;
+        auto e2 = ad::cos(e1 - x) * (e1 + y);
+        auto e3 = ad::exp(e2 * 0.1 + x) / (e2 * e2 + 1.);
+        return ad::tanh(e3 * y - e1) + e3 * x;
+    };
+    auto expr = ad::bind(ad::sum(ad::fuse(chain(x, y))));
+    auto expr2 = ad::bind(ad::sum(chain(x2, y2)));
+    value_t res = ad::autodiff(expr);
+    value_t res2 = ad::autodiff(expr2);
+    EXPECT_NEAR(res, res2, 1e-12);
+    check_vec(x, x2);
+    check_vec(y, y2);
+}
+
+} // namespace ad
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/graph.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <testutil/base_fixture.hpp>
+
+namespace ad {
+namespace core {
+
+struct graph_fixture : base_fixture
+{
+protected:
+    static constexpr size_t size = 5;
+    Var<double> x, y;
+    Var<double, vec> v{size}, w{size};
+};
+
+TEST_F(graph_fixture, unbound)
+{
+    // Binary(Unary(v), x)
+    auto expr = ad::sin(v) * x;
+    auto g = ad::graph(expr);
+    ASSERT_EQ(g.size(), 4ul);
+
+    EXPECT_EQ(g[0].kind, "BinaryNode");
+    EXPECT_EQ(g[0].shape, "vec");
+    EXPECT_EQ(g[0].rows, size);
+    EXPECT_EQ(g[0].cols, 1ul);
+    EXPECT_EQ(g[0].parent, NodeInfo::npos);
+    EXPECT_EQ(g[0].single_cache_size(0), size);
+    EXPECT_EQ(g[0].cache_size(0), 2 * size);
+
+    EXPECT_EQ(g[1].kind, "UnaryNode");
+    EXPECT_EQ(g[1].name, "UnaryNode<Sin, VarView<...>>");
+    EXPECT_EQ(g[1].parent, 0ul);
+    EXPECT_EQ(g[1].depth, 1ul);
+
+    EXPECT_EQ(g[2].kind, "VarView");
+    EXPECT_EQ(g[2].parent, 1ul);
+    EXPECT_EQ(g[2].depth, 2ul);
+    EXPECT_EQ(g[2].single_cache_size(0), 0ul);
+
+    EXPECT_EQ(g[3].kind, "VarView");
+    EXPECT_EQ(g[3].shape, "scl");
+    EXPECT_EQ(g[3].parent, 0ul);
+
+    // not bound
+    for (const auto& info : g) {
+        EXPECT_EQ(info.val_offset, NodeInfo::npos);
+        EXPECT_EQ(info.adj_offset, NodeInfo::npos);
+    }
+}
+
+TEST_F(graph_fixture, bound_offsets)
+{
+    auto expr = ad::bind(ad::sum(ad::sin(v) * x));
+    auto g = ad::graph(expr);
+    ASSERT_EQ(g.size(), 5ul);
+
+    // children are bound before their parents
+    EXPECT_EQ(g[0].kind, "SumElemNode");
+    EXPECT_EQ(g[2].kind, "UnaryNode");
+    EXPECT_EQ(g[2].val_offset, 0ul);
+    EXPECT_EQ(g[2].adj_offset, 0ul);
+    EXPECT_EQ(g[1].kind, "BinaryNode");
+    EXPECT_EQ(g[1].val_offset, g[2].single_cache_size(0));
+    EXPECT_EQ(g[1].adj_offset, g[2].single_cache_size(1));
+    EXPECT_EQ(g[0].val_offset, 2 * size);
+
+    // leaves live outside of the cache
+    EXPECT_EQ(g[3].val_offset, NodeInfo::npos);
+    EXPECT_EQ(g[4].adj_offset, NodeInfo::npos);
+
+    // every single node cache sums to the total
+    util::SizePack total = util::SizePack::Zero();
+    for (const auto& info : g) total += info.single_cache_size;
+    EXPECT_EQ(total(0), expr.get().bind_cache_size()(0));
+    EXPECT_EQ(total(1), expr.get().bind_cache_size()(1));
+}
+
+TEST_F(graph_fixture, eq_rebinds_to_placeholder)
+{
+    auto expr = ad::bind((w = ad::exp(v), ad::sum(w)));
+    auto g = ad::graph(expr);
+    std::vector<std::string> kinds;
+    for (const auto& info : g) kinds.push_back(info.kind);
+    std::vector<std::string> expected = {
+        "GlueNode", "EqNode", "VarView", "UnaryNode", "VarView",
+        "SumElemNode", "VarView"};
+    EXPECT_EQ(kinds, expected);
+    // exp(v) is rebound to the placeholder w
+    EXPECT_EQ(g[3].val_offset, NodeInfo::npos);
+}
+
+TEST_F(graph_fixture, visitor)
+{
+    auto expr = ad::bind(x * y + x);
+    size_t count = 0;
+    for_each_node_info(expr, [&](const NodeInfo& info, auto& node) {
+        EXPECT_EQ(info.id, count++);
+        EXPECT_EQ(info.rows, node.rows());
+    });
+    EXPECT_EQ(count, 5ul);
+}
+
+TEST_F(graph_fixture, to_dot)
+{
+    auto expr = ad::bind(ad::sin(x) + y);
+    std::string dot = ad::to_dot(expr);
+    EXPECT_EQ(dot.rfind("digraph fastad {", 0), 0ul);
+    EXPECT_NE(dot.find("n0 [label=\"BinaryNode<Add, UnaryNode<...>, VarView<...>>"),
+              std::string::npos);
+    EXPECT_NE(dot.find("n0 -> n1;"), std::string::npos);
+    EXPECT_NE(dot.find("n1 -> n2;"), std::string::npos);
+    EXPECT_NE(dot.find("n0 -> n3;"), std::string::npos);
+    EXPECT_NE(dot.find("offset: val 0, adj 0"), std::string::npos);
+    EXPECT_EQ(dot.substr(dot.size() - 2), "}\n");
+}
+
+} // namespace core
+} // namespace ad
@@ -1,101 +1,160 @@
 #define _USE_MATH_DEFINES
-#include <fastad_bits/reverse/core/math.hpp>
-#include <fastad_bits/reverse/core/hessian.hpp>
 #include "gtest/gtest.h"
+#include <cmath>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/hessian.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
 
 namespace ad {
+namespace core {
 
-auto F_lmda = [](const auto& x, const auto&) {
-    return ad::sin(x[0]) * ad::exp(x[0]) - x[0] + ad::tan(x[0]);
-};
+struct hessian_fixture : ::testing::Test
+{
+protected:
+    using value_t = ForwardVar<double>;
 
-auto G_lmda = [](const auto& x, const auto&) {
-    return ad::sin(x[0]) * ad::cos(x[1]);
-};
+    Var<value_t, ad::scl> w;
+    Var<value_t, ad::vec> x{2};
+    Var<value_t, ad::vec> y{4};
+    Eigen::MatrixXd H;
+    Eigen::VectorXd hv;
 
-auto H_lmda = [](const auto& x, const auto&) {
-    return ad::sin(x[0]) + x[0] * x[0] + x[1] * x[1] + ad::cos(x[2] * x[3]);
-};
+    hessian_fixture()
+    {
+        w.get() = value_t(2.1);
+        x.get()(0) = value_t(M_PI / 3);
+        x.get()(1) = value_t(M_PI / 6);
+        for (int i = 0; i < 4; ++i) {
+            y.get()(i) = value_t(i + 1.);
+        }
+    }
 
-struct hessian_fixture: ::testing::Test
-{
-protected:
+    // f(w) = sin(w) * exp(w) - w + tan(w)
+    auto F() { return ad::sin(w) * ad::exp(w) - w + ad::tan(w); }
+
+    // g(x) = sin(x0) * cos(x1)
+    auto G() { return ad::sin(x[0]) * ad::cos(x[1]); }
+
+    // h(y) = sin(y0) + y0^2 + y1^2 + cos(y2 * y3)
+    auto H_expr()
+    {
+        return ad::sin(y[0]) + y[0] * y[0] + y[1] * y[1] + ad::cos(y[2] * y[3]);
+    }
 
-    // Test functions
     // WOLFRAM-ALPHA HARD-CODED NUMBERS
-    // Test Hessian of a H_lmda
-    template <class Mat>
-    void h_hess_test(Mat const& mat)
+    void h_hess_test(const Eigen::MatrixXd& mat)
     {
         EXPECT_NEAR(mat(0, 0), 1.15853, 1e-5);
-        for (int i = 0; i < 2; ++i)
-            for (int j = i + 1; j < 4; ++j)
+        for (int i = 0; i < 2; ++i) {
+            for (int j = i + 1; j < 4; ++j) {
                 EXPECT_NEAR(mat(i, j), 0., 1e-5);
+                EXPECT_NEAR(mat(j, i), 0., 1e-5);
+            }
+        }
         EXPECT_NEAR(mat(1, 1), 2., 1e-5);
         EXPECT_NEAR(mat(2, 2), -13.5017, 1e-4);
         EXPECT_NEAR(mat(2, 3), -9.58967, 1e-5);
+        EXPECT_NEAR(mat(3, 2), -9.58967, 1e-5);
         EXPECT_NEAR(mat(3, 3), -7.59469, 1e-5);
     }
 
-    // Test gradient of a H_lmda computed while computing hessian
-    template <class Mat>
-    void h_grad_test(Mat const& mat)
+    void h_grad_test()
     {
-        EXPECT_NEAR(mat(0, 0), 2.5403, 1e-4);
-        EXPECT_NEAR(mat(0, 1), 4, 1e-1);
-        EXPECT_NEAR(mat(0, 2), 2.14629, 1e-5);
-        EXPECT_NEAR(mat(0, 3), 1.60972, 1e-5);
+        EXPECT_NEAR(y.get_adj()(0).get_value(), 2.5403, 1e-4);
+        EXPECT_NEAR(y.get_adj()(1).get_value(), 4., 1e-5);
+        EXPECT_NEAR(y.get_adj()(2).get_value(), 2.14629, 1e-5);
+        EXPECT_NEAR(y.get_adj()(3).get_value(), 1.60972, 1e-5);
     }
-
 };
 
-// Hessian (second derivative) of a univariate function
-// Verify that algorithm approach is correct
-TEST_F(hessian_fixture, one_dimensional) {
-    using T = double;
-    Vec<ForwardVar<T>> x = {{2.1}};
-    x[0].get_value().set_adjoint(1);
-    auto gen = make_exgen<ForwardVar<T>>(F_lmda);
-    auto expr = std::get<0>(gen.generate(x));
-    autodiff(expr);
-
-    T value = x[0].get_value().get_value(); // get forward variable value
-    double deriv = 
-        (std::cos(value) + std::sin(value)) *
-        std::exp(value) - 
-        1 + 1 / (std::cos(value) * std::cos(value));
-    double hessian = 
-        2 * (std::cos(value)*std::exp(value) + 
-        std::sin(value) / 
-        (std::cos(value) * std::cos(value) * std::cos(value)));
-    double deriv_test = expr.get_value().get_adjoint();
-    double hessian_test = x[0].get_adjoint().get_adjoint();
-    EXPECT_DOUBLE_EQ(deriv_test, deriv);
-    EXPECT_DOUBLE_EQ(hessian_test, hessian);
+TEST_F(hessian_fixture, one_dimensional)
+{
+    auto expr = ad::bind(F());
+    double res = ad::hessian(expr, H, w);
+
+    double v = 2.1;
+    double f = std::sin(v) * std::exp(v) - v + std::tan(v);
+    double deriv =
+        (std::cos(v) + std::sin(v)) * std::exp(v) - 1 +
+        1 / (std::cos(v) * std::cos(v));
+    double hess =
+        2 * (std::cos(v) * std::exp(v) +
+             std::sin(v) / (std::cos(v) * std::cos(v) * std::cos(v)));
+
+    EXPECT_DOUBLE_EQ(res, f);
+    EXPECT_EQ(H.rows(), 1);
+    EXPECT_EQ(H.cols(), 1);
+    EXPECT_NEAR(H(0, 0), hess, 1e-10);
+    EXPECT_NEAR(w.get_adj().get_value(), deriv, 1e-10);
+    EXPECT_DOUBLE_EQ(w.get().get_adjoint(), 0.);
+}
+
+TEST_F(hessian_fixture, two_dimensional)
+{
+    auto expr = ad::bind(G());
+    ad::hessian(expr, H, x);
+    EXPECT_NEAR(H(0, 0), -0.75, 1e-14);
+    EXPECT_NEAR(H(1, 1), -0.75, 1e-14);
+    EXPECT_NEAR(H(0, 1), -0.25, 1e-14);
+    EXPECT_NEAR(H(1, 0), -0.25, 1e-14);
+}
+
+TEST_F(hessian_fixture, multi_dimensional)
+{
+    auto expr = ad::bind(H_expr());
+    ad::hessian(expr, H, y);
+    EXPECT_EQ(H.rows(), 4);
+    EXPECT_EQ(H.cols(), 4);
+    h_hess_test(H);
+    h_grad_test();
 }
 
-// Hessian of a bivariate function
-TEST_F(hessian_fixture, two_dimensional) {
-    using T = double;
-    T x[] = { M_PI / 3 , M_PI / 6 };
-    Mat<T> hess;
-    hessian(hess, x, x + 2, G_lmda);
-    EXPECT_DOUBLE_EQ(hess(0, 0), -0.75);
-    EXPECT_DOUBLE_EQ(hess(1, 1), -0.75);
-    EXPECT_DOUBLE_EQ(hess(0, 1), -0.25);
-    EXPECT_DOUBLE_EQ(hess(1, 0), -0.25);
+TEST_F(hessian_fixture, multi_var)
+{
+    // same as multi_dimensional but y is split into two variables
+    Var<value_t, ad::scl> a, b;
+    Var<value_t, ad::vec> c{2};
+    a.get() = value_t(1.);
+    b.get() = value_t(2.);
+    c.get()(0) = value_t(3.);
+    c.get()(1) = value_t(4.);
+    auto expr = ad::bind(ad::sin(a) + a * a + b * b + ad::cos(c[0] * c[1]));
+    ad::hessian(expr, H, a, b, c);
+    h_hess_test(H);
+}
+
+TEST_F(hessian_fixture, hvp)
+{
+    auto expr = ad::bind(H_expr());
+    ad::hessian(expr, H, y);
+
+    Eigen::VectorXd v(4);
+    v << 0.5, -1., 2., 0.25;
+    double res = ad::hvp(expr, v, hv, y);
+    EXPECT_DOUBLE_EQ(res, std::sin(1.) + 1. + 4. + std::cos(12.));
+
+    Eigen::VectorXd actual = H * v;
+    EXPECT_EQ(hv.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(hv(i), actual(i), 1e-12);
+        EXPECT_DOUBLE_EQ(y.get()(i).get_adjoint(), 0.);
+    }
+    h_grad_test();
 }
 
-// Hessian multivariate
-TEST_F(hessian_fixture, multi_dimensional) {
-    using T = double;
-    // DON'T CHANGE THESE NUMBERS
-    T x[] = { 1.,2.,3.,4. };
-    Mat<T> hess;
-    Mat<T> grad;
-    hessian(hess, grad, x, x + 4, H_lmda);
-    h_hess_test(hess);
-    h_grad_test(grad);
+TEST_F(hessian_fixture, hvp_repeated)
+{
+    // adjoints must be reset between calls
+    auto expr = ad::bind(G());
+    Eigen::VectorXd v(2);
+    v << 1., 0.;
+    ad::hvp(expr, v, hv, x);
+    ad::hvp(expr, v, hv, x);
+    EXPECT_NEAR(hv(0), -0.75, 1e-14);
+    EXPECT_NEAR(hv(1), -0.25, 1e-14);
 }
 
+} // namespace core
 } // namespace ad
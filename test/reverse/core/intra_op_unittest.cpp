@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/util/intra_op.hpp>
+
+namespace ad {
+namespace core {
+
+struct intra_op_fixture : ::testing::Test
+{
+protected:
+    static constexpr size_t n = 40;
+
+    Var<double, mat> A{n, n};
+    Var<double, mat> B{n, n};
+    Var<double, vec> x{n};
+    util::ThreadPool pool{4};
+
+    intra_op_fixture()
+    {
+        Eigen::MatrixXd M(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            x.get()(i) = std::sin(0.1 * i);
+            for (size_t j = 0; j < n; ++j) {
+                M(i, j) = std::sin(0.01 * (i + 2 * j) + 0.3 * i);
+                B.get()(i, j) = std::cos(0.02 * (2 * i + j));
+            }
+        }
+        A.get() = Eigen::MatrixXd::Identity(n, n) + 0.05 * M * M.transpose();
+    }
+
+    ~intra_op_fixture() { util::reset_intra_op(); }
+
+    void reset_adj()
+    {
+        A.reset_adj();
+        B.reset_adj();
+        x.reset_adj();
+    }
+
+    // checks that the expression evaluates to the same value and gradients
+    // with and without intra-node parallelism
+    template <class ExprType>
+    void check(ExprType&& expr)
+    {
+        reset_adj();
+        util::reset_intra_op();
+        double f_serial = ad::autodiff(expr);
+        Eigen::MatrixXd A_adj = A.get_adj();
+        Eigen::MatrixXd B_adj = B.get_adj();
+        Eigen::VectorXd x_adj = x.get_adj();
+
+        reset_adj();
+        util::set_intra_op(pool, 1);
+        double f_parallel = ad::autodiff(expr);
+        EXPECT_NEAR(f_parallel, f_serial, 1e-12 * std::abs(f_serial));
+        EXPECT_TRUE(A.get_adj().isApprox(A_adj, 1e-12));
+        EXPECT_TRUE(B.get_adj().isApprox(B_adj, 1e-12));
+        EXPECT_TRUE(x.get_adj().isApprox(x_adj, 1e-12));
+    }
+};
+
+TEST_F(intra_op_fixture, dot_mat_vec)
+{
+    check(ad::bind(ad::sum(ad::dot(A, x))));
+}
+
+TEST_F(intra_op_fixture, dot_mat_mat)
+{
+    check(ad::bind(ad::sum(ad::dot(A, B))));
+}
+
+TEST_F(intra_op_fixture, dot_nested)
+{
+    // children that are neither constants nor VarViews go through the gradient buffers
+    check(ad::bind(ad::sum(ad::sin(ad::dot(ad::dot(A, B), ad::sin(x))))));
+}
+
+TEST_F(intra_op_fixture, det)
+{
+    check(ad::bind(ad::det(A)));
+    check(ad::bind(ad::det<DetLDLT>(A)));
+    check(ad::bind(ad::det<DetLLT>(A)));
+}
+
+TEST_F(intra_op_fixture, log_det)
+{
+    check(ad::bind(ad::log_det(A)));
+    check(ad::bind(ad::log_det<LogDetLDLT>(A)));
+    check(ad::bind(ad::log_det<LogDetLLT>(A)));
+}
+
+TEST_F(intra_op_fixture, log_det_grad)
+{
+    util::set_intra_op(pool, 1);
+    auto expr = ad::bind(ad::log_det<LogDetLLT>(A));
+    ad::autodiff(expr);
+    EXPECT_TRUE(A.get_adj().isApprox(A.get().inverse().transpose(), 1e-10));
+}
+
+} // namespace core
+} // namespace ad
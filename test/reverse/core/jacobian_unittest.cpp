@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/jacobian.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <testutil/base_fixture.hpp>
+
+namespace ad {
+namespace core {
+
+struct jacobian_fixture : base_fixture
+{
+protected:
+    Var<double, ad::vec> x{3};
+    Var<double, ad::scl> y;
+    Var<double, ad::mat> A{2, 3};
+    Eigen::MatrixXd J;
+
+    jacobian_fixture()
+        : base_fixture()
+    {
+        x.get() << 0.3, -1.2, 2.1;
+        y.get() = 1.7;
+        A.get() << 1., 2., 3.,
+                   -4., 5., -6.;
+    }
+};
+
+TEST_F(jacobian_fixture, scl_expr)
+{
+    auto expr = ad::bind(ad::sin(y) * y);
+    double res = ad::jacobian(expr, J, y);
+    EXPECT_DOUBLE_EQ(res, std::sin(y.get()) * y.get());
+    EXPECT_EQ(J.rows(), 1);
+    EXPECT_EQ(J.cols(), 1);
+    EXPECT_DOUBLE_EQ(J(0,0), std::cos(y.get()) * y.get() + std::sin(y.get()));
+    EXPECT_DOUBLE_EQ(y.get_adj(), 0.);
+}
+
+TEST_F(jacobian_fixture, vec_expr)
+{
+    // f(x, y) = sin(x) * y
+    auto expr = ad::bind(ad::sin(x) * y);
+    Eigen::VectorXd res = ad::jacobian(expr, J, x, y);
+    EXPECT_EQ(J.rows(), 3);
+    EXPECT_EQ(J.cols(), 4);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(res(i), std::sin(x.get()(i)) * y.get());
+        for (int j = 0; j < 3; ++j) {
+            double actual = (i == j) ? std::cos(x.get()(i)) * y.get() : 0.;
+            EXPECT_DOUBLE_EQ(J(i,j), actual);
+        }
+        EXPECT_DOUBLE_EQ(J(i,3), std::sin(x.get()(i)));
+    }
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(x.get_adj()(i), 0.);
+    }
+}
+
+TEST_F(jacobian_fixture, dot_expr)
+{
+    // f(A, x) = A * x
+    auto expr = ad::bind(ad::dot(A, x));
+    ad::jacobian(expr, J, x, A);
+    EXPECT_EQ(J.rows(), 2);
+    EXPECT_EQ(J.cols(), 9);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_DOUBLE_EQ(J(i,j), A.get()(i,j));
+        }
+        // A is flattened in column-major order
+        for (int k = 0; k < 2; ++k) {
+            for (int j = 0; j < 3; ++j) {
+                double actual = (i == k) ? x.get()(j) : 0.;
+                EXPECT_DOUBLE_EQ(J(i, 3 + k + 2*j), actual);
+            }
+        }
+    }
+}
+
+TEST_F(jacobian_fixture, mat_expr)
+{
+    // f(A, y) = A * y
+    auto expr = ad::bind(A * y);
+    ad::jacobian(expr, J, y, A);
+    EXPECT_EQ(J.rows(), 6);
+    EXPECT_EQ(J.cols(), 7);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_DOUBLE_EQ(J(i,0), A.get()(i));
+        for (int j = 0; j < 6; ++j) {
+            EXPECT_DOUBLE_EQ(J(i,1+j), (i == j) ? y.get() : 0.);
+        }
+    }
+}
+
+TEST_F(jacobian_fixture, placeholder_expr)
+{
+    // w = x * y, f = w * w
+    Var<double, ad::vec> w(3);
+    auto expr = ad::bind((w = x * y, w * w));
+    ad::jacobian(expr, J, x, y);
+    for (int i = 0; i < 3; ++i) {
+        double xi = x.get()(i);
+        double yv = y.get();
+        for (int j = 0; j < 3; ++j) {
+            double actual = (i == j) ? 2. * xi * yv * yv : 0.;
+            EXPECT_DOUBLE_EQ(J(i,j), actual);
+        }
+        EXPECT_DOUBLE_EQ(J(i,3), 2. * xi * xi * yv);
+    }
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(w.get_adj()(i), 0.);
+    }
+}
+
+TEST_F(jacobian_fixture, unused_var)
+{
+    auto expr = ad::bind(ad::sin(x));
+    ad::jacobian(expr, J, x, y);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(J(i,3), 0.);
+    }
+}
+
+} // namespace core
+} // namespace ad
@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/map_reduce.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+namespace core {
+
+struct map_reduce_fixture : ::testing::Test
+{
+protected:
+    static constexpr size_t n_rows = 37;
+    static constexpr size_t n_cols = 4;
+
+    Var<double, vec> w{n_cols};
+    Var<double, scl> b;
+    Eigen::MatrixXd X;
+    util::ThreadPool pool{3};
+
+    map_reduce_fixture()
+        : X(n_rows, n_cols)
+    {
+        w.get() << 0.3, -1.2, 0.7, 0.05;
+        b.get() = -0.4;
+        for (size_t i = 0; i < n_rows; ++i) {
+            for (size_t j = 0; j < n_cols; ++j) {
+                X(i, j) = std::sin(0.3 * i + j);
+            }
+        }
+    }
+
+    // squared residual of a linear model: (x_i^T w + b)^2
+    auto row_fn()
+    {
+        return [&](const auto& x) {
+            auto r = ad::sum(x * w) + b;
+            return ad::sin(r) * r;
+        };
+    }
+
+    double expected_value() const
+    {
+        double out = 0;
+        for (size_t i = 0; i < n_rows; ++i) {
+            double r = X.row(i).dot(w.get()) + b.get();
+            out += std::sin(r) * r;
+        }
+        return out;
+    }
+
+    // expected gradient w.r.t. (w, b) scaled by seed
+    Eigen::VectorXd expected_grad(double seed) const
+    {
+        Eigen::VectorXd g = Eigen::VectorXd::Zero(n_cols + 1);
+        for (size_t i = 0; i < n_rows; ++i) {
+            double r = X.row(i).dot(w.get()) + b.get();
+            double dr = std::cos(r) * r + std::sin(r);
+            g.head(n_cols) += seed * dr * X.row(i).transpose();
+            g(n_cols) += seed * dr;
+        }
+        return g;
+    }
+
+    void check_grad(double seed)
+    {
+        auto g = expected_grad(seed);
+        for (size_t j = 0; j < n_cols; ++j) {
+            EXPECT_NEAR(w.get_adj(j, 0), g(j), 1e-12);
+        }
+        EXPECT_NEAR(b.get_adj(), g(n_cols), 1e-12);
+    }
+
+    void reset_adj()
+    {
+        w.reset_adj();
+        b.reset_adj();
+    }
+};
+
+TEST_F(map_reduce_fixture, serial_feval)
+{
+    auto expr = ad::bind(ad::map_reduce(X, row_fn()));
+    EXPECT_NEAR(ad::evaluate(expr), expected_value(), 1e-12);
+}
+
+TEST_F(map_reduce_fixture, serial_autodiff)
+{
+    auto expr = ad::bind(ad::map_reduce(X, row_fn()));
+    double f = ad::autodiff(expr, 2.);
+    EXPECT_NEAR(f, expected_value(), 1e-12);
+    check_grad(2.);
+}
+
+TEST_F(map_reduce_fixture, par_feval)
+{
+    auto expr = ad::bind(ad::map_reduce(pool, X, row_fn()));
+    EXPECT_NEAR(ad::evaluate(expr), expected_value(), 1e-12);
+}
+
+TEST_F(map_reduce_fixture, par_autodiff)
+{
+    auto expr = ad::bind(ad::map_reduce(pool, X, row_fn()));
+    double f = ad::autodiff(expr, 2.);
+    EXPECT_NEAR(f, expected_value(), 1e-12);
+    check_grad(2.);
+}
+
+TEST_F(map_reduce_fixture, par_autodiff_twice)
+{
+    auto expr = ad::bind(ad::map_reduce(pool, X, row_fn()));
+    ad::autodiff(expr);
+    reset_adj();
+    double f = ad::autodiff(expr);
+    EXPECT_NEAR(f, expected_value(), 1e-12);
+    check_grad(1.);
+}
+
+TEST_F(map_reduce_fixture, par_deterministic)
+{
+    auto expr = ad::bind(ad::map_reduce(pool, X, row_fn()));
+    double f1 = ad::autodiff(expr);
+    Eigen::VectorXd w_adj1 = w.get_adj();
+    double b_adj1 = b.get_adj();
+    for (int k = 0; k < 10; ++k) {
+        reset_adj();
+        EXPECT_EQ(ad::autodiff(expr), f1);
+        for (size_t j = 0; j < n_cols; ++j) {
+            EXPECT_EQ(w.get_adj(j, 0), w_adj1(j));
+        }
+        EXPECT_EQ(b.get_adj(), b_adj1);
+    }
+}
+
+TEST_F(map_reduce_fixture, par_fewer_rows_than_threads)
+{
+    Eigen::MatrixXd X2 = X.topRows(2);
+    auto expr = ad::bind(ad::map_reduce(pool, X2, row_fn()));
+    double f = ad::autodiff(expr);
+    double r0 = X2.row(0).dot(w.get()) + b.get();
+    double r1 = X2.row(1).dot(w.get()) + b.get();
+    EXPECT_NEAR(f, std::sin(r0) * r0 + std::sin(r1) * r1, 1e-12);
+    EXPECT_NEAR(b.get_adj(),
+                std::cos(r0) * r0 + std::sin(r0) + std::cos(r1) * r1 + std::sin(r1),
+                1e-12);
+}
+
+TEST_F(map_reduce_fixture, empty)
+{
+    Eigen::MatrixXd X2(0, n_cols);
+    auto expr = ad::bind(ad::map_reduce(pool, X2, row_fn()));
+    EXPECT_DOUBLE_EQ(ad::autodiff(expr), 0.);
+    EXPECT_DOUBLE_EQ(b.get_adj(), 0.);
+}
+
+TEST_F(map_reduce_fixture, copies_own_rows)
+{
+    constexpr size_t n_threads = 4;
+    auto expr = ad::bind(ad::map_reduce(X, row_fn()));
+    std::vector<decltype(expr)> copies(n_threads, expr);
+    std::vector<double> res(n_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 50; ++i) {
+                res[t] = ad::evaluate(copies[t]);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (double r : res) {
+        EXPECT_NEAR(r, expected_value(), 1e-12);
+    }
+}
+
+TEST_F(map_reduce_fixture, nested_in_par_sum)
+{
+    std::vector<int> idx(3);
+    auto expr = ad::bind(ad::sum(pool, idx.begin(), idx.end(),
+                [&](int) { return ad::map_reduce(pool, X, row_fn()); }));
+    double f = ad::autodiff(expr);
+    EXPECT_NEAR(f, 3. * expected_value(), 1e-12);
+    check_grad(3.);
+}
+
+} // namespace core
+} // namespace ad
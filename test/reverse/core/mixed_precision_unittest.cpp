@@ -0,0 +1,100 @@
+#define FASTAD_MIXED_PRECISION
+#include "gtest/gtest.h"
+#include <numeric>
+#include <vector>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/norm.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/reverse/stat/normal.hpp>
+
+namespace ad {
+
+struct mixed_precision_fixture : ::testing::Test
+{
+protected:
+    using value_t = float;
+    static constexpr size_t size = 100000;
+
+    std::vector<value_t> val;
+    std::vector<value_t> adj;
+    std::vector<VarView<value_t>> xs;
+
+    mixed_precision_fixture()
+        : val(size, 0.1f)
+        , adj(size, 0.f)
+    {
+        xs.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            xs.emplace_back(&val[i], &adj[i]);
+        }
+    }
+
+    // sum computed in double, then rounded once
+    value_t exact_sum() const
+    {
+        return static_cast<value_t>(
+                std::accumulate(val.begin(), val.end(), 0.));
+    }
+};
+
+TEST_F(mixed_precision_fixture, accum_type)
+{
+    static_assert(std::is_same_v<util::accum_t<float>, double>);
+    static_assert(std::is_same_v<util::accum_t<double>, double>);
+}
+
+TEST_F(mixed_precision_fixture, sum_iter)
+{
+    auto expr = ad::bind(ad::sum(xs.begin(), xs.end(),
+                                 [](const auto& x) { return x; }));
+    value_t res = ad::autodiff(expr);
+    EXPECT_EQ(res, exact_sum());
+    EXPECT_EQ(adj[0], 1.f);
+    EXPECT_EQ(adj[size-1], 1.f);
+}
+
+TEST_F(mixed_precision_fixture, sum_elem)
+{
+    Var<value_t, vec> v(size);
+    v.get().setConstant(0.1f);
+    auto expr = ad::bind(ad::sum(v));
+    value_t res = ad::autodiff(expr);
+    EXPECT_EQ(res, exact_sum());
+}
+
+TEST_F(mixed_precision_fixture, norm)
+{
+    Var<value_t, vec> v(size);
+    v.get().setConstant(0.1f);
+    double expected = 0;
+    for (size_t i = 0; i < size; ++i) {
+        expected += static_cast<double>(0.1f) * 0.1f;
+    }
+    auto expr = ad::bind(ad::norm(v));
+    value_t res = ad::autodiff(expr);
+    EXPECT_EQ(res, static_cast<value_t>(expected));
+    EXPECT_FLOAT_EQ(v.get_adj(0,0), 0.2f);
+}
+
+TEST_F(mixed_precision_fixture, normal_log_pdf)
+{
+    Var<value_t, vec> x(3);
+    Var<value_t> mu(0.5f), sigma(2.f);
+    x.get() << -1.f, 0.f, 2.f;
+    auto expr = ad::bind(ad::normal_adj_log_pdf(x, mu, sigma));
+    value_t res = ad::autodiff(expr);
+
+    value_t z_sq = ((x.get().array() - 0.5f) / 2.f).square().sum();
+    EXPECT_FLOAT_EQ(res, -0.5f * z_sq - 3.f * std::log(2.f));
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_FLOAT_EQ(x.get_adj(i,0), (0.5f - x.get()(i)) / 4.f);
+    }
+    EXPECT_FLOAT_EQ(mu.get_adj(), (x.get().array() - 0.5f).sum() / 4.f);
+    EXPECT_FLOAT_EQ(sigma.get_adj(), (z_sq - 3.f) / 2.f);
+}
+
+} // namespace ad
@@ -0,0 +1,110 @@
+#define FASTAD_PROFILE
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/profile.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+
+struct profile_fixture : ::testing::Test
+{
+protected:
+    Var<double> x{2.}, y{3.}, w;
+    Var<double, vec> v{100};
+};
+
+TEST_F(profile_fixture, short_type_name)
+{
+    using expr_t = core::BinaryNode<core::Add,
+          core::UnaryNode<core::Sin, VarView<double, scl>>,
+          VarView<double, scl>>;
+    EXPECT_EQ(util::short_type_name<expr_t>(),
+              "BinaryNode<Add, UnaryNode<...>, VarView<...>>");
+    EXPECT_EQ(util::short_type_name<expr_t>(0), "BinaryNode<...>");
+}
+
+TEST_F(profile_fixture, calls_counted_per_node)
+{
+    // Binary(Unary(x), y)
+    auto expr = ad::bind(ad::sin(x) + y);
+    for (int i = 0; i < 3; ++i) ad::autodiff(expr);
+    ad::evaluate(expr);
+
+    auto entries = ad::profile(expr);
+    ASSERT_EQ(entries.size(), 4ul);
+
+    EXPECT_EQ(entries[0].depth, 0ul);
+    EXPECT_EQ(entries[0].feval.calls, 4ul);
+    EXPECT_EQ(entries[0].beval.calls, 3ul);
+
+    EXPECT_EQ(entries[1].id, 1ul);
+    EXPECT_EQ(entries[1].depth, 1ul);
+    EXPECT_EQ(entries[1].name.rfind("UnaryNode<Sin", 0), 0ul);
+    EXPECT_EQ(entries[1].feval.calls, 4ul);
+    EXPECT_EQ(entries[1].beval.calls, 3ul);
+
+    // leaves are not instrumented
+    EXPECT_EQ(entries[2].depth, 2ul);
+    EXPECT_EQ(entries[2].feval.calls, 0ul);
+    EXPECT_EQ(entries[3].depth, 1ul);
+    EXPECT_EQ(entries[3].beval.calls, 0ul);
+}
+
+TEST_F(profile_fixture, inclusive_exclusive)
+{
+    auto expr = ad::bind(ad::sum(ad::exp(ad::sin(v))));
+    for (int i = 0; i < 10; ++i) ad::autodiff(expr);
+
+    auto entries = ad::profile(expr);
+    ASSERT_EQ(entries.size(), 4ul);
+    for (size_t i = 0; i + 1 < entries.size(); ++i) {
+        // parent is inclusive of its only child
+        EXPECT_GE(entries[i].feval.time, entries[i+1].feval.time);
+        EXPECT_GE(entries[i].beval.time, entries[i+1].beval.time);
+        EXPECT_EQ(entries[i].feval_exclusive,
+                  entries[i].feval.time - entries[i+1].feval.time);
+    }
+    auto total = entries[0].feval.time;
+    decltype(total) sum_excl{0};
+    for (const auto& e : entries) sum_excl += e.feval_exclusive;
+    EXPECT_EQ(sum_excl, total);
+}
+
+TEST_F(profile_fixture, reset)
+{
+    auto expr = ad::bind((w = x * y, ad::sin(w)));
+    ad::autodiff(expr);
+    ad::profile_reset(expr);
+    for (const auto& e : ad::profile(expr)) {
+        EXPECT_EQ(e.feval.calls, 0ul);
+        EXPECT_EQ(e.beval.calls, 0ul);
+        EXPECT_EQ(e.feval.time.count(), 0);
+    }
+    ad::autodiff(expr);
+    EXPECT_EQ(ad::profile(expr)[0].feval.calls, 1ul);
+}
+
+TEST_F(profile_fixture, report)
+{
+    auto expr = ad::bind(ad::sin(x) * y);
+    ad::autodiff(expr);
+    std::stringstream ss;
+    ad::profile_report(expr, ss);
+    std::string line;
+    size_t n_lines = 0;
+    while (std::getline(ss, line)) ++n_lines;
+    // header, Binary, Unary (leaves are not printed)
+    EXPECT_EQ(n_lines, 3ul);
+    EXPECT_NE(ss.str().find("  BinaryNode<Mul"), std::string::npos);
+    EXPECT_NE(ss.str().find("    UnaryNode<Sin"), std::string::npos);
+}
+
+} // namespace ad
@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/for_each.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/scan.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+namespace core {
+
+struct scan_fixture : ::testing::Test
+{
+protected:
+    static constexpr size_t n_steps = 50;
+
+    Var<double, scl> a, b, c;
+    Var<double, scl> theta;
+    Var<double, vec> x0{3};
+    Eigen::MatrixXd u;
+
+    scan_fixture()
+        : u(3, n_steps)
+    {
+        a.get() = 0.97;
+        b.get() = 0.1;
+        c.get() = -0.5;
+        theta.get() = 0.8;
+        x0.get() << 0.3, -1.2, 2.1;
+        for (size_t t = 0; t < n_steps; ++t) {
+            for (int i = 0; i < 3; ++i) {
+                u(i, t) = std::sin(0.1 * t + i);
+            }
+        }
+    }
+
+    void reset_adj()
+    {
+        a.reset_adj();
+        b.reset_adj();
+        c.reset_adj();
+        theta.reset_adj();
+        x0.reset_adj();
+    }
+
+    // x_t = a * x_{t-1} * sin(x_{t-1}) + b, x_0 = c
+    auto ar_scan(size_t interval)
+    {
+        return ad::scan([&](const auto& x) { return a * x * ad::sin(x) + b; },
+                        c, n_steps, interval);
+    }
+
+    // x_t = sin(x_{t-1}) * theta + u_t, x_0 = x0
+    auto vec_scan(size_t interval)
+    {
+        return ad::sum(ad::scan(
+                [&](const auto& x, const auto& in) {
+                    return ad::sin(x) * theta + in;
+                }, x0, u, interval));
+    }
+
+    // evaluates vec_scan(0) directly (no AD) for finite differences
+    double vec_scan_value(const Eigen::VectorXd& x0_v, double theta_v)
+    {
+        Eigen::VectorXd x = x0_v;
+        for (size_t t = 0; t < n_steps; ++t) {
+            x = x.array().sin() * theta_v + u.col(t).array();
+        }
+        return x.sum();
+    }
+};
+
+TEST_F(scan_fixture, scl_matches_for_each)
+{
+    // reference: unrolled with placeholders
+    Var<double, vec> w(n_steps + 1);
+    std::vector<size_t> idx(n_steps);
+    std::iota(idx.begin(), idx.end(), 0);
+    auto ref = ad::bind((
+        w[0] = c + 0.,
+        ad::for_each(idx.begin(), idx.end(), [&](size_t t) {
+            return w[t+1] = a * w[t] * ad::sin(w[t]) + b;
+        })
+    ));
+    double ref_val = ad::autodiff(ref);
+    double ref_a = a.get_adj(), ref_b = b.get_adj(), ref_c = c.get_adj();
+
+    for (size_t interval : {size_t(0), size_t(1), size_t(3), size_t(7), n_steps, n_steps + 10}) {
+        reset_adj();
+        auto expr = ad::bind(ar_scan(interval));
+        double res = ad::autodiff(expr);
+        EXPECT_DOUBLE_EQ(res, ref_val);
+        EXPECT_NEAR(a.get_adj(), ref_a, 1e-12);
+        EXPECT_NEAR(b.get_adj(), ref_b, 1e-12);
+        EXPECT_NEAR(c.get_adj(), ref_c, 1e-12);
+    }
+}
+
+TEST_F(scan_fixture, scl_zero_steps)
+{
+    auto expr = ad::bind(ad::scan([&](const auto& x) { return a * x; }, c * b, 0));
+    double res = ad::autodiff(expr);
+    EXPECT_DOUBLE_EQ(res, c.get() * b.get());
+    EXPECT_DOUBLE_EQ(a.get_adj(), 0.);
+    EXPECT_DOUBLE_EQ(b.get_adj(), c.get());
+    EXPECT_DOUBLE_EQ(c.get_adj(), b.get());
+}
+
+TEST_F(scan_fixture, vec_inputs)
+{
+    auto expr = ad::bind(vec_scan(0));
+    double res = ad::autodiff(expr);
+    EXPECT_NEAR(res, vec_scan_value(x0.get(), theta.get()), 1e-12);
+
+    // central finite differences
+    const double h = 1e-6;
+    double dtheta = (vec_scan_value(x0.get(), theta.get() + h) -
+                     vec_scan_value(x0.get(), theta.get() - h)) / (2*h);
+    EXPECT_NEAR(theta.get_adj(), dtheta, 1e-6);
+    for (int i = 0; i < 3; ++i) {
+        Eigen::VectorXd xp = x0.get(), xm = x0.get();
+        xp(i) += h;
+        xm(i) -= h;
+        double dx = (vec_scan_value(xp, theta.get()) -
+                     vec_scan_value(xm, theta.get())) / (2*h);
+        EXPECT_NEAR(x0.get_adj()(i), dx, 1e-6);
+    }
+}
+
+TEST_F(scan_fixture, vec_interval_invariant)
+{
+    auto expr = ad::bind(vec_scan(0));
+    ad::autodiff(expr);
+    double ref_theta = theta.get_adj();
+    Eigen::VectorXd ref_x0 = x0.get_adj();
+
+    for (size_t interval : {size_t(1), size_t(4), n_steps}) {
+        reset_adj();
+        auto expr = ad::bind(vec_scan(interval));
+        ad::autodiff(expr);
+        EXPECT_NEAR(theta.get_adj(), ref_theta, 1e-12);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_NEAR(x0.get_adj()(i), ref_x0(i), 1e-12);
+        }
+    }
+}
+
+TEST_F(scan_fixture, repeated_autodiff)
+{
+    auto expr = ad::bind(ar_scan(0));
+    ad::autodiff(expr);
+    double ref_a = a.get_adj();
+    reset_adj();
+    ad::autodiff(expr);
+    EXPECT_DOUBLE_EQ(a.get_adj(), ref_a);
+}
+
+TEST_F(scan_fixture, par_sum)
+{
+    // each parallel expression owns its scan and the shared leaves
+    // accumulate through the thread-private scratches
+    util::ThreadPool pool(2);
+    std::vector<double> scales = {0.5, 1., 1.5, 2.};
+    auto make_scan = [&](double k) {
+        return ad::scan([&](const auto& x) { return a * x * ad::sin(x) + b; },
+                        c * k, n_steps);
+    };
+
+    auto ref = ad::bind(ad::sum(scales.begin(), scales.end(), make_scan));
+    double ref_val = ad::autodiff(ref);
+    double ref_a = a.get_adj(), ref_b = b.get_adj(), ref_c = c.get_adj();
+
+    reset_adj();
+    auto expr = ad::bind(ad::sum(pool, scales.begin(), scales.end(), make_scan));
+    double res = ad::autodiff(expr);
+    EXPECT_NEAR(res, ref_val, 1e-12);
+    EXPECT_NEAR(a.get_adj(), ref_a, 1e-12);
+    EXPECT_NEAR(b.get_adj(), ref_b, 1e-12);
+    EXPECT_NEAR(c.get_adj(), ref_c, 1e-12);
+}
+
+TEST_F(scan_fixture, interval)
+{
+    EXPECT_EQ(scan_interval(100, 0), 10ul);
+    EXPECT_EQ(scan_interval(101, 0), 11ul);
+    EXPECT_EQ(scan_interval(0, 0), 1ul);
+    EXPECT_EQ(scan_interval(100, 7), 7ul);
+}
+
+} // namespace core
+} // namespace ad
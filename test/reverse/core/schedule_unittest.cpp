@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/dot.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/schedule.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+
+namespace ad {
+namespace core {
+
+struct schedule_fixture : ::testing::Test
+{
+protected:
+    static constexpr size_t n = 64;
+
+    Var<double, mat> A{n, n};
+    Var<double, mat> B{n, n};
+    Var<double, vec> x{n};
+    Var<double, vec> y{n};
+    util::TaskPool pool{4};
+
+    schedule_fixture()
+    {
+        for (size_t i = 0; i < n; ++i) {
+            x.get()(i) = std::sin(0.1 * i);
+            y.get()(i) = std::cos(0.2 * i);
+            for (size_t j = 0; j < n; ++j) {
+                A.get()(i, j) = std::sin(0.01 * (i + 2 * j));
+                B.get()(i, j) = std::cos(0.02 * (2 * i + j));
+            }
+        }
+    }
+
+    // sum(A x) * sum(B y) + sum(A y):
+    // the children of * share no leaves, the children of + share A and y.
+    auto make_expr()
+    {
+        return (ad::sum(ad::dot(A, x)) * ad::sum(ad::dot(B, y))) +
+                ad::sum(ad::dot(A, y));
+    }
+
+    void reset_adj()
+    {
+        A.reset_adj();
+        B.reset_adj();
+        x.reset_adj();
+        y.reset_adj();
+    }
+
+    void check_grad(double f)
+    {
+        Eigen::VectorXd ones = Eigen::VectorXd::Ones(n);
+        double sax = (A.get() * x.get()).sum();
+        double sby = (B.get() * y.get()).sum();
+        double say = (A.get() * y.get()).sum();
+        EXPECT_NEAR(f, sax * sby + say, 1e-9);
+
+        Eigen::MatrixXd dA = sby * ones * x.get().transpose() + ones * y.get().transpose();
+        Eigen::MatrixXd dB = sax * ones * y.get().transpose();
+        Eigen::VectorXd dx = sby * A.get().transpose() * ones;
+        Eigen::VectorXd dy = sax * B.get().transpose() * ones + A.get().transpose() * ones;
+        EXPECT_TRUE(A.get_adj().isApprox(dA, 1e-12));
+        EXPECT_TRUE(B.get_adj().isApprox(dB, 1e-12));
+        EXPECT_TRUE(x.get_adj().isApprox(dx, 1e-12));
+        EXPECT_TRUE(y.get_adj().isApprox(dy, 1e-12));
+    }
+};
+
+TEST_F(schedule_fixture, default_threshold_small)
+{
+    auto expr = ad::bind(make_expr());
+    EXPECT_EQ(ad::schedule(expr, pool), 0ul);
+}
+
+TEST_F(schedule_fixture, n_forks)
+{
+    auto expr = ad::bind(make_expr());
+    // the three dot nodes and the two binary nodes
+    EXPECT_EQ(ad::schedule(expr, pool, n), 5ul);
+    // binary nodes only, since the vectors are cheaper than n * n
+    EXPECT_EQ(ad::schedule(expr, pool, n * n), 2ul);
+    ad::unschedule(expr);
+    EXPECT_EQ(ad::schedule(expr, pool, 10 * n * n), 0ul);
+}
+
+TEST_F(schedule_fixture, autodiff)
+{
+    auto expr = ad::bind(make_expr());
+    ad::schedule(expr, pool, n);
+    double f = ad::autodiff(expr);
+    check_grad(f);
+}
+
+TEST_F(schedule_fixture, autodiff_twice)
+{
+    auto expr = ad::bind(make_expr());
+    ad::schedule(expr, pool, n);
+    ad::autodiff(expr);
+    reset_adj();
+    double f = ad::autodiff(expr);
+    check_grad(f);
+}
+
+TEST_F(schedule_fixture, deterministic)
+{
+    auto expr = ad::bind(make_expr());
+    ad::schedule(expr, pool, n);
+    double f1 = ad::autodiff(expr);
+    Eigen::MatrixXd A_adj1 = A.get_adj();
+    Eigen::VectorXd y_adj1 = y.get_adj();
+    for (int k = 0; k < 20; ++k) {
+        reset_adj();
+        EXPECT_EQ(ad::autodiff(expr), f1);
+        EXPECT_EQ(A.get_adj(), A_adj1);
+        EXPECT_EQ(y.get_adj(), y_adj1);
+    }
+}
+
+TEST_F(schedule_fixture, copy_not_scheduled)
+{
+    auto expr = ad::bind(make_expr());
+    ad::schedule(expr, pool, n);
+    EXPECT_NE(expr.get().fork_slot().plan(), nullptr);
+    auto copy = expr;
+    EXPECT_EQ(copy.get().fork_slot().plan(), nullptr);
+    auto moved = std::move(expr);
+    EXPECT_NE(moved.get().fork_slot().plan(), nullptr);
+    double f = ad::autodiff(copy);
+    check_grad(f);
+}
+
+TEST_F(schedule_fixture, placeholder_not_forked)
+{
+    Var<double, vec> w{n};
+    auto expr = ad::bind(((w = ad::dot(A, x)), ad::sum(w * ad::dot(B, y))));
+    // the dot nodes and w * (B y), whose forward evaluation is not forked
+    // since its left child is a view of the placeholder
+    EXPECT_EQ(ad::schedule(expr, pool, n), 3ul);
+    double f = ad::autodiff(expr);
+    Eigen::VectorXd ax = A.get() * x.get();
+    Eigen::VectorXd by = B.get() * y.get();
+    EXPECT_NEAR(f, ax.dot(by), 1e-9);
+    EXPECT_TRUE(x.get_adj().isApprox(A.get().transpose() * by, 1e-12));
+    EXPECT_TRUE(y.get_adj().isApprox(B.get().transpose() * ax, 1e-12));
+}
+
+TEST_F(schedule_fixture, eq_child_not_forked)
+{
+    Var<double, vec> w{n};
+    auto expr = ad::bind(ad::sum((w = ad::dot(A, x)) * ad::dot(B, y)));
+    // the binary node has an EqNode child
+    EXPECT_EQ(ad::schedule(expr, pool, n), 2ul);
+    double f = ad::autodiff(expr);
+    Eigen::VectorXd ax = A.get() * x.get();
+    Eigen::VectorXd by = B.get() * y.get();
+    EXPECT_NEAR(f, ax.dot(by), 1e-9);
+}
+
+TEST_F(schedule_fixture, single_thread_pool)
+{
+    util::TaskPool single(1);
+    auto expr = ad::bind(make_expr());
+    ad::schedule(expr, single, n);
+    double f = ad::autodiff(expr);
+    check_grad(f);
+}
+
+} // namespace core
+} // namespace ad
@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/constant.hpp>
+#include <fastad_bits/reverse/core/det.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/log_det.hpp>
+#include <fastad_bits/reverse/core/schedule.hpp>
+#include <fastad_bits/reverse/core/share.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/reverse/stat/normal.hpp>
+#include <fastad_bits/reverse/stat/wishart.hpp>
+
+namespace ad {
+namespace core {
+
+struct share_fixture : ::testing::Test
+{
+protected:
+    static constexpr size_t n = 5;
+
+    Var<double, mat> S{n, n};
+    Var<double, mat> W{n, n};
+    Var<double, vec> x{n};
+    Var<double, vec> mu{n};
+
+    share_fixture()
+    {
+        Eigen::MatrixXd A(n, n), B(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            x.get()(i) = std::sin(0.7 * i);
+            mu.get()(i) = 0.1 * i;
+            for (size_t j = 0; j < n; ++j) {
+                A(i, j) = std::cos(0.3 * i + 0.5 * j);
+                B(i, j) = std::sin(0.4 * i - 0.2 * j);
+            }
+        }
+        S.get() = A * A.transpose() + Eigen::MatrixXd::Identity(n, n);
+        W.get() = B * B.transpose() + Eigen::MatrixXd::Identity(n, n);
+    }
+
+    auto make_expr()
+    {
+        return ad::log_det<LogDetLLT>(S) + 
+               ad::normal_adj_log_pdf(x, mu, S) +
+               ad::wishart_adj_log_pdf(W, S, 10.);
+    }
+
+    void reset_adj()
+    {
+        S.reset_adj();
+        W.reset_adj();
+        x.reset_adj();
+        mu.reset_adj();
+    }
+
+    // checks that expr has the same value and gradients as an unshared copy
+    template <class ExprType>
+    void check(ExprType& expr)
+    {
+        auto expected = ad::bind(make_expr());
+        reset_adj();
+        double f_expected = ad::autodiff(expected);
+        Eigen::MatrixXd S_adj = S.get_adj();
+        Eigen::MatrixXd W_adj = W.get_adj();
+        Eigen::VectorXd x_adj = x.get_adj();
+
+        reset_adj();
+        double f = ad::autodiff(expr);
+        EXPECT_NEAR(f, f_expected, 1e-12);
+        EXPECT_TRUE(S.get_adj().isApprox(S_adj, 1e-13));
+        EXPECT_TRUE(W.get_adj().isApprox(W_adj, 1e-13));
+        EXPECT_TRUE(x.get_adj().isApprox(x_adj, 1e-13));
+    }
+};
+
+TEST_F(share_fixture, n_shared)
+{
+    auto expr = ad::bind(make_expr());
+    // normal and the V of wishart reuse the factorization of log_det
+    EXPECT_EQ(ad::share_factorizations(expr), 2ul);
+    // sharing again gives the same result
+    EXPECT_EQ(ad::share_factorizations(expr), 2ul);
+}
+
+TEST_F(share_fixture, autodiff)
+{
+    auto expr = ad::bind(make_expr());
+    ad::share_factorizations(expr);
+    check(expr);
+}
+
+TEST_F(share_fixture, value_changed)
+{
+    auto expr = ad::bind(make_expr());
+    ad::share_factorizations(expr);
+    ad::autodiff(expr);
+    // the shared factorization is recomputed since S changed
+    S.get() += Eigen::MatrixXd::Identity(n, n);
+    check(expr);
+    check(expr);
+}
+
+TEST_F(share_fixture, same_matrix_in_one_node)
+{
+    auto expr = ad::bind(ad::wishart_adj_log_pdf(S, S, 10.));
+    EXPECT_EQ(ad::share_factorizations(expr), 1ul);
+    double f = ad::autodiff(expr);
+    Eigen::MatrixXd S_inv = S.get().inverse();
+    double p = n;
+    EXPECT_NEAR(f, (10. - p - 1.) * 0.5 * std::log(S.get().determinant())
+                    - 0.5 * p - 10. * 0.5 * std::log(S.get().determinant()), 1e-12);
+    Eigen::MatrixXd S_adj = 0.5 * ((10. - p - 1.) * S_inv - S_inv) +
+                            0.5 * (S_inv - 10. * S_inv);
+    EXPECT_TRUE(S.get_adj().isApprox(S_adj, 1e-12));
+}
+
+TEST_F(share_fixture, copy_not_shared)
+{
+    auto expr = ad::bind(make_expr());
+    ad::share_factorizations(expr);
+    auto copy = expr;
+    check(copy);
+    EXPECT_EQ(ad::share_factorizations(copy), 2ul);
+    check(copy);
+}
+
+TEST_F(share_fixture, placeholder)
+{
+    Var<double, mat> T(n, n);
+    auto expr = ad::bind((T = S * 2.,
+                          ad::log_det<LogDetLLT>(T) + ad::det<DetLLT>(T)));
+    EXPECT_EQ(ad::share_factorizations(expr), 1ul);
+    double f = ad::autodiff(expr);
+    Eigen::MatrixXd T_val = 2. * S.get();
+    double det = T_val.determinant();
+    EXPECT_NEAR(f, std::log(det) + det, 1e-9 * det);
+    Eigen::MatrixXd S_adj = 2. * (1. + det) * T_val.inverse();
+    EXPECT_TRUE(S.get_adj().isApprox(S_adj, 1e-10));
+}
+
+TEST_F(share_fixture, not_shared)
+{
+    // constants and the default LU decomposition are never shared
+    auto expr = ad::bind(ad::log_det<LogDetLLT>(ad::constant(S.get())) +
+                         ad::normal_adj_log_pdf(x, mu, ad::constant(S.get())) +
+                         ad::log_det(S) + ad::det(S));
+    EXPECT_EQ(ad::share_factorizations(expr), 0ul);
+}
+
+TEST_F(share_fixture, scheduled)
+{
+    util::TaskPool pool(4);
+    auto expr = ad::bind(make_expr());
+    ad::share_factorizations(expr);
+    EXPECT_GT(ad::schedule(expr, pool, 1), 0ul);
+    check(expr);
+    check(expr);
+}
+
+} // namespace core
+} // namespace ad
@@ -26,6 +26,8 @@ protected:
     Eigen::VectorXd val_buf;
     Eigen::VectorXd adj_buf;
 
+    util::ThreadPool pool{3};
+
     sum_fixture()
         : base_fixture()
         , vseed(size)
@@ -64,6 +66,30 @@ protected:
             return sumnode;
         }
     }
+
+    // Creates a parallel sum node where every expression views the same leaf.
+    // Already binds the node to val_buf.
+    template <class ShapeType>
+    auto make_par_sum()
+    {
+        ptr_pack_t ptr_pack(val_buf.data(), adj_buf.data());
+        if constexpr (std::is_same_v<ShapeType, ad::scl>) {
+            auto sumnode = sum(pool, scl_exprs.begin(), scl_exprs.end(), 
+                               [&](const auto&) { return scl_unary_t(scl_expr); });
+            sumnode.bind_cache(ptr_pack);
+            return sumnode;
+        } else if constexpr (std::is_same_v<ShapeType, ad::vec>) {
+            auto sumnode = sum(pool, vec_exprs.begin(), vec_exprs.end(), 
+                               [&](const auto&) { return vec_unary_t(vec_expr); });
+            sumnode.bind_cache(ptr_pack);
+            return sumnode;
+        } else {
+            auto sumnode = sum(pool, mat_exprs.begin(), mat_exprs.end(), 
+                               [&](const auto&) { return mat_unary_t(mat_expr); });
+            sumnode.bind_cache(ptr_pack);
+            return sumnode;
+        }
+    }
 };
 
 // Sum (iter) TEST
@@ -154,6 +180,94 @@ TEST_F(sum_fixture, vec_constant)
     }
 }
 
+// Sum (parallel iter) TEST
+
+TEST_F(sum_fixture, par_scl_feval)
+{
+    auto scl_sum = make_par_sum<ad::scl>();
+    value_t res = scl_sum.feval();
+    EXPECT_DOUBLE_EQ(res, size*2.*scl_expr.get());
+}
+
+TEST_F(sum_fixture, par_scl_beval)
+{
+    auto scl_sum = make_par_sum<ad::scl>();
+    scl_sum.beval(seed);
+    EXPECT_DOUBLE_EQ(scl_expr.get_adj(), size*2.*seed);
+}
+
+TEST_F(sum_fixture, par_scl_beval_twice)
+{
+    auto scl_sum = make_par_sum<ad::scl>();
+    scl_sum.beval(seed);
+    scl_sum.beval(seed);
+    EXPECT_DOUBLE_EQ(scl_expr.get_adj(), 2*size*2.*seed);
+}
+
+TEST_F(sum_fixture, par_vec_feval)
+{
+    auto vec_sum = make_par_sum<ad::vec>();
+    Eigen::VectorXd res = vec_sum.feval();
+    for (int i = 0; i < res.size(); ++i) {
+        EXPECT_DOUBLE_EQ(res(i), size*2.*vec_expr.get(i,0));
+    }
+}
+
+TEST_F(sum_fixture, par_vec_beval)
+{
+    auto vec_sum = make_par_sum<ad::vec>();
+    vec_sum.beval(vseed);
+    for (size_t i = 0; i < vec_size; ++i) {
+        EXPECT_DOUBLE_EQ(vec_expr.get_adj(i,0), size*2*vseed[i]);
+    }
+}
+
+TEST_F(sum_fixture, par_mat_feval)
+{
+    auto mat_sum = make_par_sum<ad::mat>();
+    Eigen::MatrixXd res = mat_sum.feval();
+    for (int i = 0; i < res.rows(); ++i) {
+        for (int j = 0; j < res.cols(); ++j) {
+            EXPECT_DOUBLE_EQ(res(i,j), size*2.*mat_expr.get(i,j));
+        }
+    }
+}
+
+TEST_F(sum_fixture, par_mat_beval)
+{
+    auto mat_sum = make_par_sum<ad::mat>();
+    mat_sum.beval(seed);
+    for (size_t i = 0; i < mat_rows; ++i) {
+        for (size_t j = 0; j < mat_cols; ++j) {
+            EXPECT_DOUBLE_EQ(mat_expr.get_adj(i,j), size*2*seed);
+        }
+    }
+}
+
+TEST_F(sum_fixture, par_scl_distinct_leaves)
+{
+    ptr_pack_t ptr_pack(val_buf.data(), adj_buf.data());
+    auto scl_sum = sum(pool, scl_exprs.begin(), scl_exprs.end(), 
+                       [](const auto& x) { return scl_unary_t(x); });
+    scl_sum.bind_cache(ptr_pack);
+    value_t res = scl_sum.feval();
+    EXPECT_DOUBLE_EQ(res, size*2.*scl_expr.get());
+    scl_sum.beval(seed);
+    for (size_t i = 0; i < scl_exprs.size(); ++i) {
+        EXPECT_DOUBLE_EQ(scl_exprs[i].get_adj(0,0), 2.*seed);
+    }
+}
+
+TEST_F(sum_fixture, par_scl_constant)
+{
+    auto sumnode = sum(pool, scl_exprs.begin(), scl_exprs.end(),
+                       [](const auto& x) { return ad::constant(x.get()); });
+    static_assert(std::is_same_v<
+            std::decay_t<decltype(sumnode)>,
+            Constant<double, ad::scl> >);
+    EXPECT_DOUBLE_EQ(sumnode.feval(), size*scl_expr.get());
+}
+
 // Sum (expr) TEST
 
 TEST_F(sum_fixture, scl_expr_feval)
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include <fastad_bits/reverse/core/binary.hpp>
+#include <fastad_bits/reverse/core/eq.hpp>
+#include <fastad_bits/reverse/core/glue.hpp>
+#include <fastad_bits/reverse/core/sum.hpp>
+#include <fastad_bits/reverse/core/traverse.hpp>
+#include <fastad_bits/reverse/core/unary.hpp>
+#include <fastad_bits/reverse/core/var.hpp>
+#include <fastad_bits/reverse/stat/normal.hpp>
+#include <testutil/base_fixture.hpp>
+
+namespace ad {
+namespace core {
+
+struct traverse_fixture : base_fixture
+{
+protected:
+    Var<double> x;
+    Var<double> y;
+    Var<double> w;
+};
+
+TEST_F(traverse_fixture, no_profile_state)
+{
+    // without FASTAD_PROFILE, nodes carry no profiling counters
+    static_assert(std::is_empty_v<ExprBase<VarView<double, scl>>>);
+}
+
+TEST_F(traverse_fixture, count_nodes)
+{
+    // Binary(Unary(x), y)
+    auto expr = ad::sin(x) + y;
+    size_t count = 0;
+    for_each_node(expr, [&](auto&) { ++count; });
+    EXPECT_EQ(count, 4ul);
+}
+
+TEST_F(traverse_fixture, leaves_in_order)
+{
+    auto expr = ad::sin(x) * y + x;
+    std::vector<const double*> leaves;
+    for_each_leaf(expr, [&](auto& leaf) { leaves.push_back(leaf.data()); });
+    ASSERT_EQ(leaves.size(), 3ul);
+    EXPECT_EQ(leaves[0], x.data());
+    EXPECT_EQ(leaves[1], y.data());
+    EXPECT_EQ(leaves[2], x.data());
+}
+
+TEST_F(traverse_fixture, constant_is_not_leaf)
+{
+    auto expr = x * 2.;
+    size_t count = 0;
+    for_each_leaf(expr, [&](auto&) { ++count; });
+    EXPECT_EQ(count, 1ul);
+}
+
+TEST_F(traverse_fixture, placeholder_is_leaf)
+{
+    auto expr = (w = x * y, w * w);
+    std::vector<const double*> leaves;
+    for_each_leaf(expr, [&](auto& leaf) { leaves.push_back(leaf.data()); });
+    ASSERT_EQ(leaves.size(), 5ul);
+    EXPECT_EQ(leaves[0], w.data());
+    EXPECT_EQ(leaves[1], x.data());
+    EXPECT_EQ(leaves[2], y.data());
+}
+
+TEST_F(traverse_fixture, sum_iter)
+{
+    std::vector<Var<double>> xs(4);
+    auto expr = ad::sum(xs.begin(), xs.end(), 
+                        [](const auto& v) { return ad::exp(v); });
+    size_t count = 0;
+    for_each_leaf(expr, [&](auto&) { ++count; });
+    EXPECT_EQ(count, 4ul);
+}
+
+TEST_F(traverse_fixture, zero_leaf_adj)
+{
+    x.get_adj() = 1.;
+    y.get_adj() = 2.;
+    auto expr = x * y;
+    zero_leaf_adj(expr);
+    EXPECT_DOUBLE_EQ(x.get_adj(), 0.);
+    EXPECT_DOUBLE_EQ(y.get_adj(), 0.);
+}
+
+TEST_F(traverse_fixture, stat_node)
+{
+    auto expr = ad::normal_adj_log_pdf(x, y, w);
+    std::vector<const double*> leaves;
+    for_each_leaf(expr, [&](auto& leaf) { leaves.push_back(leaf.data()); });
+    ASSERT_EQ(leaves.size(), 3ul);
+    EXPECT_EQ(leaves[0], x.data());
+    EXPECT_EQ(leaves[1], y.data());
+    EXPECT_EQ(leaves[2], w.data());
+}
+
+} // namespace core
+} // namespace ad
@@ -0,0 +1,132 @@
+#include <testutil/base_fixture.hpp>
+#include <fastad_bits/reverse/core/bind.hpp>
+#include <fastad_bits/reverse/core/eval.hpp>
+#include <fastad_bits/reverse/stat/normal_cholesky.hpp>
+
+namespace ad {
+namespace stat {
+
+struct normal_cholesky_fixture : ::testing::Test
+{
+protected:
+    using value_t = double;
+    static constexpr size_t d = 4;
+    static constexpr size_t n = 6;
+
+    Var<value_t, vec> x{d};
+    Var<value_t, mat> X{n, d};
+    Var<value_t, vec> mu{d};
+    Var<value_t, mat> L{d, d};
+    Var<value_t, mat> sigma{d, d};
+
+    normal_cholesky_fixture()
+    {
+        for (size_t j = 0; j < d; ++j) {
+            x.get()(j) = std::sin(1.3 * j) + 0.5;
+            mu.get()(j) = 0.1 * j - 0.2;
+            for (size_t i = 0; i < n; ++i) {
+                X.get()(i, j) = std::cos(0.7 * i + 1.1 * j);
+            }
+            for (size_t i = 0; i < d; ++i) {
+                L.get()(i, j) = (i == j) ? 1.5 + 0.2 * i :
+                                (i > j) ? 0.3 * std::sin(i + 2. * j) : 0.;
+            }
+        }
+        sigma.get() = L.get() * L.get().transpose();
+    }
+
+    void reset_adj()
+    {
+        x.reset_adj();
+        X.reset_adj();
+        mu.reset_adj();
+        L.reset_adj();
+        sigma.reset_adj();
+    }
+
+    // adjoint of L implied by the adjoint of sigma = L L^T
+    Eigen::MatrixXd l_adj_from_sigma() const
+    {
+        Eigen::MatrixXd g = sigma.get_adj();
+        Eigen::MatrixXd out = (g + g.transpose()) * L.get();
+        out.triangularView<Eigen::StrictlyUpper>().setZero();
+        return out;
+    }
+};
+
+TEST_F(normal_cholesky_fixture, vec_matches_normal)
+{
+    auto expected = ad::bind(ad::normal_adj_log_pdf(x, mu, sigma));
+    value_t f_expected = ad::autodiff(expected);
+    Eigen::VectorXd x_adj = x.get_adj();
+    Eigen::VectorXd mu_adj = mu.get_adj();
+    Eigen::MatrixXd l_adj = l_adj_from_sigma();
+
+    reset_adj();
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L));
+    value_t f = ad::autodiff(expr);
+
+    EXPECT_NEAR(f, f_expected, 1e-13);
+    EXPECT_TRUE(x.get_adj().isApprox(x_adj, 1e-13));
+    EXPECT_TRUE(mu.get_adj().isApprox(mu_adj, 1e-13));
+    EXPECT_TRUE(L.get_adj().isApprox(l_adj, 1e-13));
+}
+
+TEST_F(normal_cholesky_fixture, mat_matches_normal)
+{
+    auto expected = ad::bind(ad::normal_adj_log_pdf(X, mu, sigma));
+    value_t f_expected = ad::autodiff(expected);
+    Eigen::MatrixXd X_adj = X.get_adj();
+    Eigen::VectorXd mu_adj = mu.get_adj();
+    Eigen::MatrixXd l_adj = l_adj_from_sigma();
+
+    reset_adj();
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(X, mu, L));
+    value_t f = ad::autodiff(expr);
+
+    EXPECT_NEAR(f, f_expected, 1e-12);
+    EXPECT_TRUE(X.get_adj().isApprox(X_adj, 1e-13));
+    EXPECT_TRUE(mu.get_adj().isApprox(mu_adj, 1e-13));
+    EXPECT_TRUE(L.get_adj().isApprox(l_adj, 1e-13));
+}
+
+TEST_F(normal_cholesky_fixture, negative_diagonal)
+{
+    // L and -L parametrize the same covariance
+    value_t f_expected = ad::evaluate(ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L)));
+    L.get() = -L.get();
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L));
+    EXPECT_NEAR(ad::autodiff(expr), f_expected, 1e-13);
+    EXPECT_TRUE(std::isfinite(L.get_adj().sum()));
+}
+
+TEST_F(normal_cholesky_fixture, upper_ignored)
+{
+    value_t f_expected = ad::evaluate(ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L)));
+    L.get()(0, 2) = 100.;
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L));
+    EXPECT_NEAR(ad::autodiff(expr), f_expected, 1e-13);
+    EXPECT_EQ(L.get_adj()(0, 2), 0.);
+}
+
+TEST_F(normal_cholesky_fixture, zero_diagonal)
+{
+    L.get()(2, 2) = 0.;
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(x, mu, L));
+    EXPECT_EQ(ad::autodiff(expr), util::neg_inf<value_t>);
+    EXPECT_EQ(L.get_adj().norm(), 0.);
+    EXPECT_EQ(x.get_adj().norm(), 0.);
+}
+
+TEST_F(normal_cholesky_fixture, constant_l)
+{
+    auto expr = ad::bind(ad::normal_cholesky_adj_log_pdf(X, mu, ad::constant(L.get())));
+    ad::autodiff(expr);
+    Eigen::MatrixXd z = sigma.get().inverse() *
+        (X.get().rowwise() - mu.get().transpose()).transpose();
+    EXPECT_TRUE(X.get_adj().isApprox(-z.transpose(), 1e-13));
+    EXPECT_TRUE(mu.get_adj().isApprox(z.rowwise().sum(), 1e-13));
+}
+
+} // namespace stat
+} // namespace ad
@@ -35,6 +35,10 @@ protected:
         vec_expr_view_t, 
         vec_expr_view_t, 
         mat_expr_view_t>;
+    using mvm_normal_t = NormalAdjLogPDFNode<
+        mat_expr_view_t, 
+        vec_expr_view_t, 
+        mat_expr_view_t>;
 
     scl_expr_t scl_x;
     scl_expr_t scl_mu;
@@ -43,6 +47,7 @@ protected:
     vec_expr_t vec_mu;
     vec_expr_t vec_sigma;
     mat_expr_t mat_sigma;
+    mat_expr_t mat_x;
 
     sss_normal_t sss_normal;
     vss_normal_t vss_normal;
@@ -51,6 +56,7 @@ protected:
     vvv_normal_t vvv_normal;
     vsm_normal_t vsm_normal;
     vvm_normal_t vvm_normal;
+    mvm_normal_t mvm_normal;
 
     value_t tol = 1e-15;
 
@@ -60,6 +66,7 @@ protected:
         , vec_mu(3)
         , vec_sigma(3)
         , mat_sigma(3,3)
+        , mat_x(4,3)
         , sss_normal(scl_x, scl_mu, scl_sigma)
         , vss_normal(vec_x, scl_mu, scl_sigma)
         , vvs_normal(vec_x, vec_mu, scl_sigma)
@@ -67,6 +74,7 @@ protected:
         , vvv_normal(vec_x, vec_mu, vec_sigma)
         , vsm_normal(vec_x, scl_mu, mat_sigma)
         , vvm_normal(vec_x, vec_mu, mat_sigma)
+        , mvm_normal(mat_x, vec_mu, mat_sigma)
     {
         // initialize some values
         this->scl_initialize(scl_x);
@@ -88,6 +96,12 @@ protected:
         vec_sigma.get(2,0) = 2.41;
 
         mat_initialize(mat_sigma);
+
+        // first observation is vec_x
+        mat_x.get() << 3.1, -2.3, 1.3,
+                       0.2, 0.5, -0.7,
+                       -1.4, 2.2, 0.1,
+                       0.9, -0.3, 2.5;
     }
 
     template <class ExprType>
@@ -394,5 +408,86 @@ TEST_F(normal_fixture, vvm_beval)
                 tol);
 }
 
+TEST_F(normal_fixture, mvm_feval)
+{
+    bind(mvm_normal);
+    value_t res = mvm_normal.feval();
+
+    Eigen::MatrixXd sigma = mat_sigma.get().selfadjointView<Eigen::Lower>();
+    Eigen::MatrixXd sigma_inv = sigma.inverse();
+    value_t expected = -2. * std::log(sigma.determinant());
+    for (size_t i = 0; i < mat_x.rows(); ++i) {
+        Eigen::VectorXd diff = mat_x.get().row(i).transpose() - vec_mu.get();
+        expected -= 0.5 * diff.dot(sigma_inv * diff);
+    }
+    EXPECT_NEAR(res, expected, 1e-13);
+}
+
+TEST_F(normal_fixture, mvm_feval_single_row)
+{
+    // a single observation is the same as the vvm case
+    Var<value_t, ad::mat> x(1, 3);
+    x.get() = vec_x.get().transpose();
+    mvm_normal_t normal(x, vec_mu, mat_sigma);
+    bind(normal);
+    EXPECT_NEAR(normal.feval(), -7.3649692930088602, 1e-14);
+    normal.beval(1.);
+    EXPECT_NEAR(x.get_adj(0,0), -3.4158218682114407, 1e-14);
+    EXPECT_NEAR(x.get_adj(0,1), 0.4279507603186097, 1e-14);
+    EXPECT_NEAR(x.get_adj(0,2), -0.5628167994207096, 1e-14);
+    EXPECT_NEAR(mat_sigma.get_adj(0,0), 5.2989810672774862, 1e-13);
+    EXPECT_NEAR(mat_sigma.get_adj(2,2), -0.0145005947321700, 1e-13);
+}
+
+TEST_F(normal_fixture, mvm_feval_not_pos_def)
+{
+    mat_sigma.get().setZero();
+    bind(mvm_normal);
+    value_t res = mvm_normal.feval();
+    EXPECT_DOUBLE_EQ(res, util::neg_inf<value_t>);
+}
+
+TEST_F(normal_fixture, mvm_beval)
+{
+    bind(mvm_normal);
+    mvm_normal.feval();
+    mvm_normal.beval(2.);
+
+    Eigen::MatrixXd sigma = mat_sigma.get().selfadjointView<Eigen::Lower>();
+    Eigen::MatrixXd sigma_inv = sigma.inverse();
+    Eigen::MatrixXd z = sigma_inv * 
+        (mat_x.get().rowwise() - vec_mu.get().transpose()).transpose();
+    value_t n_obs = mat_x.rows();
+
+    Eigen::MatrixXd dx = -2. * z.transpose();
+    Eigen::VectorXd dmu = 2. * z.rowwise().sum();
+    Eigen::MatrixXd dsigma = (z * z.transpose() - n_obs * sigma_inv);
+
+    EXPECT_TRUE(mat_x.get_adj().isApprox(dx, 1e-13));
+    EXPECT_TRUE(vec_mu.get_adj().isApprox(dmu, 1e-13));
+    EXPECT_TRUE(mat_sigma.get_adj().isApprox(dsigma, 1e-13));
+}
+
+TEST_F(normal_fixture, mvm_beval_intra_op)
+{
+    bind(mvm_normal);
+    mvm_normal.feval();
+    mvm_normal.beval(1.);
+    Eigen::MatrixXd x_adj = mat_x.get_adj();
+    Eigen::MatrixXd sigma_adj = mat_sigma.get_adj();
+    value_t res = mvm_normal.get();
+
+    mat_x.reset_adj();
+    mat_sigma.reset_adj();
+    util::ThreadPool pool(4);
+    util::set_intra_op(pool, 1);
+    EXPECT_NEAR(mvm_normal.feval(), res, 1e-14);
+    mvm_normal.beval(1.);
+    util::reset_intra_op();
+
+    EXPECT_TRUE(mat_x.get_adj().isApprox(x_adj, 1e-14));
+    EXPECT_TRUE(mat_sigma.get_adj().isApprox(sigma_adj, 1e-14));
+}
+
 } // namespace stat
 } // namespace ad
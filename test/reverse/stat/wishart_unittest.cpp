@@ -1,5 +1,6 @@
 #include <testutil/base_fixture.hpp>
 #include <fastad_bits/reverse/stat/wishart.hpp>
+#include <fastad_bits/util/intra_op.hpp>
 
 namespace ad {
 namespace stat {
@@ -104,5 +105,29 @@ TEST_F(wishart_fixture, beval)
     }
 }
 
+TEST_F(wishart_fixture, beval_intra_op) 
+{
+    util::ThreadPool pool(4);
+    util::set_intra_op(pool, 1);
+    bind(wishart);
+    value_t res = wishart.feval();
+    wishart.beval(1.);
+    util::reset_intra_op();
+
+    EXPECT_NEAR(res, -12.55942947411780252764, 1e-14);
+
+    value_t p = v.rows();
+    Eigen::MatrixXd v_inv = v.get().inverse();
+    Eigen::MatrixXd dX = 0.5 * ((n-p-1) * x.get().inverse() - v_inv);
+    Eigen::MatrixXd dV = 0.5 * ((v_inv * x.get() * v_inv) - n * v_inv);
+
+    for (size_t i = 0; i < x.rows(); ++i) {
+        for (size_t j = 0; j < x.cols(); ++j) {
+            EXPECT_NEAR(x.get_adj(i,j), dX(i,j), 1e-14);
+            EXPECT_NEAR(v.get_adj(i,j), dV(i,j), 1e-14);
+        }
+    }
+}
+
 } // namespace stat
 } // namespace ad
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fastad_bits/util/arena.hpp>
+
+namespace ad {
+namespace util {
+
+struct arena_fixture : ::testing::Test
+{
+protected:
+    Arena arena{1024};
+
+    static bool is_aligned(const void* p, size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+};
+
+TEST_F(arena_fixture, empty)
+{
+    EXPECT_EQ(arena.n_chunks(), 0ul);
+    EXPECT_EQ(arena.used(), 0ul);
+    EXPECT_EQ(arena.capacity(), 0ul);
+    EXPECT_EQ(arena.alignment(), 64ul);
+}
+
+TEST_F(arena_fixture, allocate_aligned_zero)
+{
+    double* x = arena.allocate<double>(3);
+    double* y = arena.allocate<double>(5);
+    EXPECT_TRUE(is_aligned(x, 64));
+    EXPECT_TRUE(is_aligned(y, 64));
+    EXPECT_GE(y, x + 3);
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_DOUBLE_EQ(y[i], 0.);
+    }
+    EXPECT_EQ(arena.used(), 8 * sizeof(double));
+    EXPECT_EQ(arena.n_chunks(), 1ul);
+}
+
+TEST_F(arena_fixture, custom_alignment)
+{
+    Arena a(256, 16);
+    for (size_t i = 0; i < 10; ++i) {
+        char* p = a.allocate<char>(3);
+        EXPECT_TRUE(is_aligned(p, 16));
+    }
+}
+
+TEST_F(arena_fixture, grow_and_merge)
+{
+    arena.allocate<double>(100);
+    arena.allocate<double>(100);    // does not fit in the first chunk
+    EXPECT_EQ(arena.n_chunks(), 2ul);
+    size_t capacity = arena.capacity();
+
+    arena.reset();
+    EXPECT_EQ(arena.n_chunks(), 1ul);
+    EXPECT_EQ(arena.used(), 0ul);
+    EXPECT_GE(arena.capacity(), capacity);
+
+    // same workload now fits in the merged chunk
+    arena.allocate<double>(100);
+    arena.allocate<double>(100);
+    EXPECT_EQ(arena.n_chunks(), 1ul);
+}
+
+TEST_F(arena_fixture, reuse_after_reset)
+{
+    double* x = arena.allocate<double>(10);
+    x[0] = 3.;
+    arena.reset();
+    double* y = arena.allocate<double>(10);
+    EXPECT_EQ(x, y);
+    EXPECT_DOUBLE_EQ(y[0], 0.);
+}
+
+TEST_F(arena_fixture, huge_pages)
+{
+    Arena a(1 << 10, 64, true);
+    double* x = a.allocate<double>(10);
+    EXPECT_TRUE(is_aligned(x, Arena::huge_page_size));
+    EXPECT_GE(a.capacity(), Arena::huge_page_size);
+}
+
+} // namespace util
+} // namespace ad
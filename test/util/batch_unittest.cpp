@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <fastad_bits/util/batch.hpp>
+
+namespace ad {
+namespace util {
+
+struct batch_fixture : ::testing::Test
+{
+protected:
+    using batch_t = Batch<double, 4>;
+
+    batch_t x;
+    batch_t y;
+
+    batch_fixture()
+    {
+        for (size_t k = 0; k < 4; ++k) {
+            x[k] = 0.1 * (k+1);
+            y[k] = -1.3 + k;
+        }
+    }
+};
+
+TEST_F(batch_fixture, default_zero)
+{
+    batch_t z;
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(z[k], 0.);
+    }
+}
+
+TEST_F(batch_fixture, broadcast)
+{
+    batch_t z = 3;
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(z[k], 3.);
+    }
+}
+
+TEST_F(batch_fixture, binary_ops)
+{
+    batch_t add = x + y;
+    batch_t sub = 2. - x;
+    batch_t mul = x * 3;
+    batch_t div = x / y;
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(add[k], x[k] + y[k]);
+        EXPECT_DOUBLE_EQ(sub[k], 2. - x[k]);
+        EXPECT_DOUBLE_EQ(mul[k], x[k] * 3);
+        EXPECT_DOUBLE_EQ(div[k], x[k] / y[k]);
+    }
+}
+
+TEST_F(batch_fixture, compound_ops)
+{
+    batch_t z = x;
+    z += y;
+    z *= x;
+    z -= 1.;
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(z[k], (x[k] + y[k]) * x[k] - 1.);
+    }
+}
+
+TEST_F(batch_fixture, unary_funcs)
+{
+    batch_t s = sin(x);
+    batch_t e = exp(-x);
+    batch_t t = tanh(y);
+    batch_t r = sqrt(x);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_DOUBLE_EQ(s[k], std::sin(x[k]));
+        EXPECT_DOUBLE_EQ(e[k], std::exp(-x[k]));
+        EXPECT_DOUBLE_EQ(t[k], std::tanh(y[k]));
+        EXPECT_DOUBLE_EQ(r[k], std::sqrt(x[k]));
+    }
+}
+
+TEST_F(batch_fixture, lane_sum)
+{
+    EXPECT_DOUBLE_EQ(util::lane_sum(x), 0.1 + 0.2 + 0.3 + 0.4);
+    EXPECT_DOUBLE_EQ(util::lane_sum(2.5), 2.5);
+}
+
+TEST_F(batch_fixture, is_batch)
+{
+    static_assert(is_batch_v<batch_t>);
+    static_assert(!is_batch_v<double>);
+}
+
+} // namespace util
+} // namespace ad
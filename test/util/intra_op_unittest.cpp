@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include <Eigen/Dense>
+#include <fastad_bits/util/intra_op.hpp>
+
+namespace ad {
+namespace util {
+
+struct intra_op_fixture : ::testing::Test
+{
+protected:
+    using mat_t = Eigen::MatrixXd;
+    using vec_t = Eigen::VectorXd;
+
+    ThreadPool pool{4};
+
+    intra_op_fixture() { set_intra_op(pool, 1); }
+    ~intra_op_fixture() { reset_intra_op(); }
+};
+
+TEST_F(intra_op_fixture, intra_op_pool)
+{
+    EXPECT_EQ(intra_op_pool(1), &pool);
+    set_intra_op(pool, 100);
+    EXPECT_EQ(intra_op_pool(99), nullptr);
+    EXPECT_EQ(intra_op_pool(100), &pool);
+    reset_intra_op();
+    EXPECT_EQ(intra_op_pool(size_t(1) << 40), nullptr);
+}
+
+TEST_F(intra_op_fixture, single_thread_pool_serial)
+{
+    ThreadPool single(1);
+    set_intra_op(single, 1);
+    EXPECT_EQ(intra_op_pool(1000), nullptr);
+}
+
+TEST_F(intra_op_fixture, parallel_blocks_cover)
+{
+    std::vector<std::atomic<int>> hits(103);
+    std::atomic<int> n_blocks{0};
+    parallel_blocks(hits.size(), 1000, [&](size_t begin, size_t size) {
+        ++n_blocks;
+        for (size_t i = begin; i < begin + size; ++i) ++hits[i];
+    });
+    EXPECT_EQ(n_blocks.load(), 4);
+    for (const auto& h : hits) EXPECT_EQ(h.load(), 1);
+}
+
+TEST_F(intra_op_fixture, parallel_blocks_serial)
+{
+    reset_intra_op();
+    size_t n_calls = 0;
+    parallel_blocks(10, 1000, [&](size_t begin, size_t size) {
+        ++n_calls;
+        EXPECT_EQ(begin, 0ul);
+        EXPECT_EQ(size, 10ul);
+    });
+    EXPECT_EQ(n_calls, 1ul);
+}
+
+TEST_F(intra_op_fixture, parallel_blocks_fewer_than_pool)
+{
+    std::atomic<int> n_blocks{0};
+    parallel_blocks(2, 1000, [&](size_t, size_t size) {
+        ++n_blocks;
+        EXPECT_EQ(size, 1ul);
+    });
+    EXPECT_EQ(n_blocks.load(), 2);
+}
+
+TEST_F(intra_op_fixture, product_mat_mat)
+{
+    mat_t A = mat_t::Random(37, 23);
+    mat_t B = mat_t::Random(23, 29);
+    mat_t C(37, 29);
+    product(C, A, B);
+    EXPECT_TRUE(C.isApprox(A * B, 1e-14));
+    product_add(C, A, B);
+    EXPECT_TRUE(C.isApprox(2 * A * B, 1e-14));
+}
+
+TEST_F(intra_op_fixture, product_mat_vec)
+{
+    // fewer columns than threads: split by rows
+    mat_t A = mat_t::Random(41, 17);
+    vec_t x = vec_t::Random(17);
+    vec_t y(41);
+    product(y, A, x);
+    EXPECT_TRUE(y.isApprox(A * x, 1e-14));
+    product_add(y, A.transpose().transpose(), x);
+    EXPECT_TRUE(y.isApprox(2 * A * x, 1e-14));
+}
+
+TEST_F(intra_op_fixture, product_transpose_map)
+{
+    mat_t A = mat_t::Random(19, 31);
+    vec_t adj = vec_t::Random(19);
+    Eigen::Map<const mat_t> A_map(A.data(), A.rows(), A.cols());
+    vec_t out = vec_t::Zero(31);
+    product_add(out, A_map.transpose(), adj);
+    EXPECT_TRUE(out.isApprox(A.transpose() * adj, 1e-14));
+
+    vec_t x = vec_t::Random(31);
+    mat_t outer(19, 31);
+    product(outer, adj, x.transpose());
+    EXPECT_TRUE(outer.isApprox(adj * x.transpose(), 1e-14));
+}
+
+TEST_F(intra_op_fixture, solve_identity)
+{
+    mat_t M = mat_t::Random(30, 30);
+    mat_t A = M * M.transpose() + 30 * mat_t::Identity(30, 30);
+    Eigen::LLT<mat_t> llt(A);
+    mat_t inv(30, 30);
+    util::solve_identity(llt, inv);
+    EXPECT_TRUE(inv.isApprox(A.inverse(), 1e-12));
+
+    Eigen::LDLT<mat_t> ldlt(A);
+    util::solve_identity(ldlt, inv);
+    EXPECT_TRUE(inv.isApprox(A.inverse(), 1e-12));
+}
+
+} // namespace util
+} // namespace ad
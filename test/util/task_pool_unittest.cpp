@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fastad_bits/util/task_pool.hpp>
+
+namespace ad {
+namespace util {
+
+struct task_pool_fixture : ::testing::Test
+{
+protected:
+    TaskPool pool{4};
+
+    // sums [begin, end) by recursively forking halves
+    long fork_sum(long begin, long end)
+    {
+        if (end - begin <= 16) {
+            long out = 0;
+            for (long i = begin; i < end; ++i) out += i;
+            return out;
+        }
+        long mid = begin + (end - begin) / 2;
+        long left = 0, right = 0;
+        pool.fork_join([&]() { left = fork_sum(begin, mid); },
+                       [&]() { right = fork_sum(mid, end); });
+        return left + right;
+    }
+};
+
+TEST_F(task_pool_fixture, size)
+{
+    EXPECT_EQ(pool.size(), 4ul);
+    TaskPool single(1);
+    EXPECT_EQ(single.size(), 1ul);
+}
+
+TEST_F(task_pool_fixture, fork_join_both)
+{
+    int a = 0, b = 0;
+    pool.fork_join([&]() { a = 1; }, [&]() { b = 2; });
+    EXPECT_EQ(a, 1);
+    EXPECT_EQ(b, 2);
+}
+
+TEST_F(task_pool_fixture, single_thread_order)
+{
+    TaskPool single(1);
+    std::vector<int> order;
+    single.fork_join([&]() { order.push_back(0); },
+                     [&]() { order.push_back(1); });
+    ASSERT_EQ(order.size(), 2ul);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+}
+
+TEST_F(task_pool_fixture, nested)
+{
+    long n = 100000;
+    EXPECT_EQ(fork_sum(0, n), n * (n - 1) / 2);
+}
+
+TEST_F(task_pool_fixture, nested_uses_workers)
+{
+    // the forked halves block until both run, which requires stealing
+    std::atomic<int> arrived{0};
+    auto wait_both = [&]() {
+        ++arrived;
+        while (arrived.load() < 2) std::this_thread::yield();
+    };
+    pool.fork_join(wait_both, wait_both);
+    EXPECT_EQ(arrived.load(), 2);
+}
+
+TEST_F(task_pool_fixture, repeated)
+{
+    std::atomic<int> count{0};
+    for (int k = 0; k < 1000; ++k) {
+        pool.fork_join([&]() { ++count; }, [&]() { ++count; });
+    }
+    EXPECT_EQ(count.load(), 2000);
+}
+
+TEST_F(task_pool_fixture, concurrent_callers)
+{
+    std::vector<long> out(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < out.size(); ++t) {
+        threads.emplace_back([&, t]() { out[t] = fork_sum(0, 10000); });
+    }
+    for (auto& thread : threads) thread.join();
+    for (long x : out) {
+        EXPECT_EQ(x, 10000l * 9999 / 2);
+    }
+}
+
+TEST_F(task_pool_fixture, exception)
+{
+    int a = 0;
+    EXPECT_THROW(pool.fork_join([&]() { a = 1; },
+                                [&]() { throw std::runtime_error("error"); }),
+                 std::runtime_error);
+    EXPECT_EQ(a, 1);
+    EXPECT_THROW(pool.fork_join([&]() { throw std::runtime_error("error"); },
+                                [&]() { a = 2; }),
+                 std::runtime_error);
+    EXPECT_EQ(a, 2);
+}
+
+} // namespace util
+} // namespace ad
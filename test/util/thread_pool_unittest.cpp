@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <fastad_bits/util/thread_pool.hpp>
+
+namespace ad {
+namespace util {
+
+struct thread_pool_fixture : ::testing::Test
+{
+protected:
+    ThreadPool pool{4};
+};
+
+TEST_F(thread_pool_fixture, size)
+{
+    EXPECT_EQ(pool.size(), 4ul);
+    ThreadPool single(1);
+    EXPECT_EQ(single.size(), 1ul);
+}
+
+TEST_F(thread_pool_fixture, parallel_for_all_tasks)
+{
+    std::vector<int> hits(1000, 0);
+    pool.parallel_for(hits.size(), [&](size_t i) { ++hits[i]; });
+    for (int h : hits) {
+        EXPECT_EQ(h, 1);
+    }
+}
+
+TEST_F(thread_pool_fixture, parallel_for_repeated)
+{
+    std::atomic<size_t> count{0};
+    for (size_t k = 0; k < 100; ++k) {
+        pool.parallel_for(7, [&](size_t) { ++count; });
+    }
+    EXPECT_EQ(count.load(), 700ul);
+}
+
+TEST_F(thread_pool_fixture, parallel_for_alternating_jobs)
+{
+    // back-to-back jobs of different sizes, so that workers
+    // still finishing one job overlap with the start of the next
+    const size_t sizes[] = {2, 13, 3, 64, 5, 1, 31, 4};
+    for (size_t k = 0; k < 2000; ++k) {
+        size_t n = sizes[k % 8];
+        std::vector<std::atomic<int>> hits(n);
+        for (auto& h : hits) h.store(0);
+        pool.parallel_for(n, [&](size_t i) {
+            ASSERT_LT(i, n);
+            ++hits[i];
+        });
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "job " << k << ", task " << i;
+        }
+    }
+}
+
+TEST_F(thread_pool_fixture, parallel_for_nested)
+{
+    std::atomic<size_t> count{0};
+    pool.parallel_for(4, [&](size_t) {
+        pool.parallel_for(5, [&](size_t) { ++count; });
+    });
+    EXPECT_EQ(count.load(), 20ul);
+}
+
+TEST_F(thread_pool_fixture, parallel_for_exception)
+{
+    EXPECT_THROW(
+        pool.parallel_for(10, [](size_t i) {
+            if (i == 3) throw std::runtime_error("task failed");
+        }), std::runtime_error);
+
+    // pool is still usable
+    std::atomic<size_t> count{0};
+    pool.parallel_for(10, [&](size_t) { ++count; });
+    EXPECT_EQ(count.load(), 10ul);
+}
+
+TEST_F(thread_pool_fixture, chunk_range_covers)
+{
+    size_t n = 10;
+    size_t n_chunks = 3;
+    size_t next = 0;
+    for (size_t i = 0; i < n_chunks; ++i) {
+        auto range = chunk_range(n, n_chunks, i);
+        EXPECT_EQ(range.first, next);
+        EXPECT_GE(range.second - range.first, n / n_chunks);
+        EXPECT_LE(range.second - range.first, n / n_chunks + 1);
+        next = range.second;
+    }
+    EXPECT_EQ(next, n);
+}
+
+} // namespace util
+} // namespace ad